@@ -0,0 +1,295 @@
+/**
+ * @file bench.h
+ * 
+ * Minimal benchmark harness of the cparser benchmarks. Benchmarks are 
+ * registered with the BENCH macro and run by the main function in
+ * bench_main.cpp.
+ */
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../cparser/inc/cparser.h"
+
+/**
+ * @brief Callback of the triggers of the benchmarks. Reads the real and 
+ * integer values so that decoding them can't be optimized away; it keeps no
+ * state, so parallel benchmarks can share it.
+ */
+extern "C" void benchTrgCallback(Dictionary_t *params);
+
+/**
+ * @brief Creates a table of triggers, see bench::createTriggers. Defined in
+ * bench_triggers.c.
+ */
+extern "C" Cp_Trigger_t *benchCreateTriggers(uint16_t numOfTriggers, uint8_t numOfParams,
+                                             Cp_ParamType_t type, Cp_ParsedCallback_t callback);
+
+namespace bench
+{
+    /**
+     * Result of a measurement. Measurements have the timing members, other
+     * metrics(e.g. speedups) have a value and its unit.
+     */
+    struct Result
+    {
+        std::string name;
+        double nsPerOp;
+        uint64_t ops;
+        double mbPerSecond;
+        double value;
+        std::string unit;
+    };
+
+    /**
+     * Measures repeated invocations of a function and reports the mean time 
+     * of an invocation. Results are printed as they are measured and kept
+     * for the machine readable report.
+     */
+    class Runner
+    {
+    public:
+        Runner(double minSeconds, FILE *output = stdout) : minSeconds_(minSeconds), output_(output) {}
+
+        /**
+         * @brief Runs the function in batches until the minimum measurement 
+         * time elapses.
+         * 
+         * @param name: Name of the measurement.
+         * @param batch: Number of operations a single invocation performs.
+         * @param fn: Function to be measured.
+         * @param bytes: Number of bytes an invocation processes; throughput
+         * is reported if it is given.
+         * 
+         * @retval Mean time of an operation in nanoseconds.
+         */
+        template <typename Fn>
+        double run(const std::string &name, uint64_t batch, Fn fn, uint64_t bytes = 0)
+        {
+            typedef std::chrono::steady_clock Clock;
+
+            // Warm up caches and branch predictors.
+            fn();
+
+            // Clock is read once per round; rounds grow until they take a
+            //millisecond, so reading it doesn't show up in short operations.
+            uint64_t invocations = 0;
+            uint64_t round = 1;
+            double elapsed = 0.0;
+            Clock::time_point start = Clock::now();
+            while (elapsed < minSeconds_)
+            {
+                double previous = elapsed;
+
+                for (uint64_t i = 0; i < round; i++)
+                {
+                    fn();
+                }
+                invocations += round;
+                elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+                if (elapsed - previous < 1e-3)
+                {
+                    round *= 2;
+                }
+            }
+
+            Result result;
+            result.name = name;
+            result.nsPerOp = (elapsed * 1e9) / (double)(invocations * batch);
+            result.ops = invocations * batch;
+            result.mbPerSecond = bytes ? (double)(invocations * bytes) / (elapsed * 1e6) : 0.0;
+            result.value = 0.0;
+            results_.push_back(result);
+
+            std::fprintf(output_, "%-48s %12.2f ns/op %14llu ops", name.c_str(), result.nsPerOp,
+                         (unsigned long long)result.ops);
+            if (bytes)
+            {
+                std::fprintf(output_, " %10.1f MB/s", result.mbPerSecond);
+            }
+            std::fprintf(output_, "\n");
+            return result.nsPerOp;
+        }
+
+        /**
+         * @brief Reports a metric which is derived from the measurements.
+         * 
+         * @param name: Name of the metric.
+         * @param value: Value of the metric.
+         * @param unit: Unit of the value.
+         */
+        void metric(const std::string &name, double value, const std::string &unit)
+        {
+            Result result;
+            result.name = name;
+            result.nsPerOp = 0.0;
+            result.ops = 0;
+            result.mbPerSecond = 0.0;
+            result.value = value;
+            result.unit = unit;
+            results_.push_back(result);
+
+            std::fprintf(output_, "%-48s %12.2f %s\n", name.c_str(), value, unit.c_str());
+        }
+
+        /**
+         * @brief Gets the results in the measurement order.
+         */
+        const std::vector<Result> &results() const { return results_; }
+
+    private:
+        double minSeconds_;
+        FILE *output_;
+        std::vector<Result> results_;
+    };
+
+    typedef void (*BenchFn)(Runner &runner);
+
+    /**
+     * @brief Gets the list of the registered benchmarks.
+     */
+    inline std::vector<std::pair<std::string, BenchFn>> &registry()
+    {
+        static std::vector<std::pair<std::string, BenchFn>> benchmarks;
+        return benchmarks;
+    }
+
+    /**
+     * Registers a benchmark on construction.
+     */
+    struct Registrar
+    {
+        Registrar(const char *name, BenchFn fn)
+        {
+            registry().push_back(std::make_pair(std::string(name), fn));
+        }
+    };
+
+    /**
+     * @brief Keeps the compiler from optimizing the value away.
+     */
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * Format of the lines of a corpus and the number of consecutive lines 
+     * of it in every cycle of the formats.
+     */
+    struct LineFormat
+    {
+        const char *format;
+        unsigned weight;
+    };
+
+    /**
+     * @brief Creates a corpus of lines which cycles through the formats. 
+     * Every '#' in a format is replaced with a number below 1000 and every 
+     * '@' with an uppercase letter, drawn from a generator with the given 
+     * seed; a corpus is the same on every run.
+     * 
+     * @param numOfLines: Number of lines to create.
+     * @param formats: Formats of the lines in the cycle order.
+     * @param seed: Seed of the values.
+     * 
+     * @retval Lines without line endings.
+     */
+    inline std::vector<std::string> createLines(size_t numOfLines,
+                                                const std::vector<LineFormat> &formats,
+                                                uint32_t seed = 1)
+    {
+        std::vector<std::string> lines;
+        unsigned cycle = 0;
+
+        for (const LineFormat &format : formats)
+        {
+            cycle += format.weight;
+        }
+
+        lines.reserve(numOfLines);
+        for (size_t i = 0; i < numOfLines; i++)
+        {
+            unsigned slot = (unsigned)(i % cycle);
+            size_t f = 0;
+            std::string line;
+
+            while (slot >= formats[f].weight)
+            {
+                slot -= formats[f].weight;
+                f++;
+            }
+
+            for (const char *c = formats[f].format; *c != '\0'; c++)
+            {
+                if (*c == '#' || *c == '@')
+                {
+                    seed = seed * 1103515245U + 12345U;
+                    if (*c == '#')
+                    {
+                        line += std::to_string((seed >> 8) % 1000U);
+                    }
+                    else
+                    {
+                        line += (char)('A' + (seed >> 16) % 26U);
+                    }
+                }
+                else
+                {
+                    line += *c;
+                }
+            }
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+
+    /**
+     * @brief Creates a table of triggers named t0000, t0001... with the 
+     * parameters A, B... of the given type and benchTrgCallback.
+     * 
+     * @param numOfTriggers: Number of triggers.
+     * @param numOfParams: Number of parameters of every trigger.
+     * @param type: Type of the parameters.
+     * 
+     * @retval Table of the triggers, freed with std::free.
+     */
+    inline Cp_Trigger_t *createTriggers(uint16_t numOfTriggers, uint8_t numOfParams,
+                                        Cp_ParamType_t type)
+    {
+        return benchCreateTriggers(numOfTriggers, numOfParams, type, benchTrgCallback);
+    }
+
+    /**
+     * @brief Joins the lines into a buffer, each ending with '\n'.
+     */
+    inline std::string joinLines(const std::vector<std::string> &lines)
+    {
+        std::string buffer;
+
+        for (const std::string &line : lines)
+        {
+            buffer += line;
+            buffer += '\n';
+        }
+
+        return buffer;
+    }
+}
+
+/** Defines and registers a benchmark function. */
+#define BENCH(name)                                                \
+    static void name(bench::Runner &runner);                       \
+    static bench::Registrar name##Registrar(#name, name);          \
+    static void name(bench::Runner &runner)
+
+#endif
@@ -0,0 +1,70 @@
+#include "bench.h"
+#include "../cparser/inc/cparser_binary.h"
+#include <cstring>
+#include <vector>
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Dispatching a corpus through the text path(Cp_FeedLineEx per line) and 
+ * as binary frames(Cp_FeedFramesEx over the transcoded corpus), and the 
+ * cost of transcoding it.
+ */
+BENCH(BinaryDecode)
+{
+    static Cp_Trigger_t triggers[] = {
+        {"move", {{'D', CP_PARAM_TYPE_REAL}, {'S', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+        {"pump", {{'M', CP_PARAM_TYPE_LETTER}, {'V', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+        {"versi", {{'V', CP_PARAM_TYPE_INTEGER}}, benchTrgCallback, 1},
+        {"delay", {{'T', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 1},
+    };
+    const size_t numOfLines = 4096;
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    std::vector<std::string> lines =
+        bench::createLines(numOfLines, {{"move D#.# S#.5", 1},
+                                        {"pump M@ V#.25", 1},
+                                        {"versi V#", 1},
+                                        {"delay T0.#", 1},
+                                        {"move D-#.# S#.5", 1},
+                                        {"pump M@ V-#.25", 1},
+                                        {"versi V-#", 1},
+                                        {"delay T#.#", 1}});
+    std::vector<uint8_t> frames(numOfLines * CP_BINARY_MAX_FRAME_SIZE);
+    size_t textSize = 0;
+    size_t frameSize = 0;
+
+    Cp_RegisterEx(parser, triggers, sizeof(triggers) / sizeof(triggers[0]));
+    for (const std::string &line : lines)
+    {
+        textSize += line.size() + 1;
+        frameSize += Cp_TranscodeLineEx(parser, line.data(), (uint16_t)line.size(),
+                                        &frames[frameSize], frames.size() - frameSize);
+    }
+
+    runner.run("binary/text", numOfLines, [&]() {
+        for (const std::string &line : lines)
+        {
+            bench::doNotOptimize(Cp_FeedLineEx(parser, line.data(), (uint16_t)line.size()));
+        }
+    },
+               textSize);
+
+    runner.run("binary/frames", numOfLines, [&]() {
+        bench::doNotOptimize(Cp_FeedFramesEx(parser, frames.data(), frameSize).accepted);
+    },
+               frameSize);
+
+    runner.run("binary/transcode", numOfLines, [&]() {
+        size_t offset = 0;
+
+        for (const std::string &line : lines)
+        {
+            offset += Cp_TranscodeLineEx(parser, line.data(), (uint16_t)line.size(),
+                                         &frames[offset], frames.size() - offset);
+        }
+        bench::doNotOptimize(offset);
+    },
+               textSize);
+
+    runner.metric("binary/size_ratio", (double)frameSize / textSize, "x");
+    delete parser;
+}
@@ -0,0 +1,72 @@
+#include "bench.h"
+#include "../cparser/inc/cparser_cache.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Feeding a repeated status poll with and without a line cache, and a 
+ * buffer where every eighth line is a unique move command between polls.
+ */
+BENCH(LineCache)
+{
+    static Cp_Trigger_t triggers[] = {
+        {"versi", {{'V', CP_PARAM_TYPE_INTEGER}}, benchTrgCallback, 1},
+        {"stat", {{'A', CP_PARAM_TYPE_INTEGER}, {'B', CP_PARAM_TYPE_INTEGER}}, benchTrgCallback, 2},
+        {"move", {{'D', CP_PARAM_TYPE_REAL}, {'S', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+    };
+    const size_t numOfLines = 4096;
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    Cp_LineCache_t *cache = new Cp_LineCache_t();
+    char poll[] = "versi V10";
+    std::string buffer;
+    char line[64];
+
+    for (size_t i = 0; i < numOfLines; i++)
+    {
+        if (i % 8 == 7)
+        {
+            std::snprintf(line, sizeof(line), "move D%u.%03u S%u.5\n", (unsigned)(i % 97),
+                          (unsigned)(i % 1000), (unsigned)(i % 400));
+        }
+        else
+        {
+            std::snprintf(line, sizeof(line), (i % 2) ? "versi V10\n" : "stat A1 B%u\n",
+                          (unsigned)(i % 4));
+        }
+        buffer += line;
+    }
+
+    Cp_RegisterEx(parser, triggers, sizeof(triggers) / sizeof(triggers[0]));
+
+    runner.run("cache/poll_parse", 1, [&]() {
+        bench::doNotOptimize(Cp_FeedLineEx(parser, poll, sizeof(poll) - 1));
+    },
+               sizeof(poll) - 1);
+
+    runner.run("cache/buffer_parse", numOfLines, [&]() {
+        bench::doNotOptimize(Cp_FeedBufferEx(parser, buffer.data(), buffer.size()).accepted);
+    },
+               buffer.size());
+
+    Cp_SetLineCacheEx(parser, cache);
+
+    runner.run("cache/poll_hit", 1, [&]() {
+        bench::doNotOptimize(Cp_FeedLineEx(parser, poll, sizeof(poll) - 1));
+    },
+               sizeof(poll) - 1);
+
+    Cp_LineCacheInit(cache);
+    runner.run("cache/buffer_cached", numOfLines, [&]() {
+        bench::doNotOptimize(Cp_FeedBufferEx(parser, buffer.data(), buffer.size()).accepted);
+    },
+               buffer.size());
+
+    size_t hits = Cp_LineCacheGetHits(cache);
+    runner.metric("cache/buffer_hit_ratio",
+                  (double)hits / (double)(hits + Cp_LineCacheGetMisses(cache)), "x");
+
+    delete cache;
+    delete parser;
+}
@@ -0,0 +1,67 @@
+#include "bench.h"
+#include "../cparser/inc/cparser.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Short commands fed a line each(Cp_FeedLineEx) against the same commands 
+ * batched four to a line with ';' separators(Cp_FeedCommandsEx). Times are
+ * per command.
+ */
+BENCH(MultiCommand)
+{
+    static Cp_Trigger_t triggers[] = {
+        {"move", {{'D', CP_PARAM_TYPE_INTEGER}, {'S', CP_PARAM_TYPE_INTEGER}}, benchTrgCallback, 2},
+        {"pump", {{'M', CP_PARAM_TYPE_LETTER}, {'V', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+    };
+    const size_t numOfCommands = 4096;
+    const size_t commandsPerLine = 4;
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    std::vector<std::string> commands =
+        bench::createLines(numOfCommands, {{"pump M@ V#.25", 1}, {"move D# S#", 1}});
+    std::vector<std::string> batches;
+    size_t singleBytes = 0;
+    size_t bytes = 0;
+
+    for (const std::string &command : commands)
+    {
+        singleBytes += command.size() + 1;
+    }
+
+    for (size_t i = 0; i < numOfCommands; i += commandsPerLine)
+    {
+        std::string batch = commands[i];
+
+        for (size_t j = 1; j < commandsPerLine; j++)
+        {
+            batch += "; " + commands[i + j];
+        }
+        batches.push_back(batch);
+        bytes += batch.size() + 1;
+    }
+
+    Cp_RegisterEx(parser, triggers, 2);
+
+    double singleNs = runner.run("commands/line_each", numOfCommands, [&]() {
+        for (const std::string &command : commands)
+        {
+            bench::doNotOptimize(Cp_FeedLineEx(parser, command.data(), (uint16_t)command.size()));
+        }
+    },
+                                 singleBytes);
+
+    double batchedNs = runner.run("commands/batched", numOfCommands, [&]() {
+        for (const std::string &batch : batches)
+        {
+            Cp_LineStatus_t statuses[commandsPerLine];
+            bench::doNotOptimize(Cp_FeedCommandsEx(parser, batch.data(), (uint16_t)batch.size(),
+                                                   statuses, commandsPerLine));
+        }
+    },
+                                  bytes);
+    runner.metric("commands/batched_ratio", batchedNs / singleNs, "x");
+
+    delete parser;
+}
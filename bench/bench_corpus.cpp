@@ -0,0 +1,123 @@
+#include "bench.h"
+#include <cstdlib>
+#include "../cparser/inc/cparser.h"
+
+/* Private typedefs --------------------------------------------------------*/
+/* Shape of a generated corpus. */
+struct CorpusShape
+{
+    uint16_t numOfTriggers;
+    uint8_t numOfParams;
+    const char *format;
+    uint8_t valueDigits;
+};
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Creates a value of the format with the given number of digits.
+ */
+static std::string createValue(const CorpusShape &shape, uint32_t seed)
+{
+    std::string digits;
+
+    for (uint8_t d = 0; d < shape.valueDigits; d++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        digits += (char)('1' + (seed >> 16) % 9);
+    }
+
+    switch (shape.format[0])
+    {
+    case 'i':
+        return ((seed & 1) ? "-" : "") + digits;
+    case 'd':
+        return digits.substr(0, (digits.size() + 1) / 2) + "." + digits.substr((digits.size() + 1) / 2);
+    default:
+        return digits.substr(0, 1) + "." + digits.substr(1) + "E" + ((seed & 1) ? "-" : "") +
+               std::to_string((seed >> 8) % 30);
+    }
+}
+
+/**
+ * @brief Creates a corpus of about the given size with lines spread over all
+ * of the triggers.
+ */
+static std::string createCorpus(const CorpusShape &shape, size_t size)
+{
+    std::string corpus;
+    uint32_t line = 0;
+
+    corpus.reserve(size + 256);
+    while (corpus.size() < size)
+    {
+        char name[8];
+        std::snprintf(name, sizeof(name), "t%04u", (uint16_t)((line * 7919U) % shape.numOfTriggers));
+        corpus += name;
+        for (uint8_t p = 0; p < shape.numOfParams; p++)
+        {
+            corpus += ' ';
+            corpus += (char)('A' + p);
+            corpus += createValue(shape, line * 31U + p);
+        }
+        corpus += '\n';
+        line++;
+    }
+
+    return corpus;
+}
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * End to end throughput of Cp_FeedBufferEx over generated corpora. Starting
+ * from a base shape, one of the trigger count(t), parameter count(p), 
+ * numeric format and value digits(d) is changed at a time.
+ */
+BENCH(Corpus)
+{
+    static const CorpusShape base = {64, 3, "decimal", 6};
+    static const CorpusShape shapes[] = {
+        base,
+        {4, 3, "decimal", 6},
+        {1024, 3, "decimal", 6},
+        {4096, 3, "decimal", 6},
+        {64, 0, "decimal", 6},
+        {64, 1, "decimal", 6},
+        {64, 5, "decimal", 6},
+        {64, 3, "integer", 6},
+        {64, 3, "scientific", 6},
+        {64, 3, "decimal", 2},
+        {64, 3, "decimal", 12},
+    };
+    Cp_Parser_t *parser = new Cp_Parser_t();
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+    {
+        const CorpusShape &shape = shapes[s];
+        Cp_ParamType_t type = (shape.format[0] == 'i') ? CP_PARAM_TYPE_INTEGER : CP_PARAM_TYPE_REAL;
+        Cp_Trigger_t *triggers =
+            bench::createTriggers(shape.numOfTriggers, shape.numOfParams, type);
+        std::string corpus = createCorpus(shape, 1 << 20);
+        Cp_FeedResult_t result;
+
+        Cp_Init(parser);
+        Cp_RegisterEx(parser, triggers, shape.numOfTriggers);
+
+        result = Cp_FeedBufferEx(parser, corpus.data(), corpus.size());
+        if (result.rejected)
+        {
+            std::fprintf(stderr, "corpus %zu has %zu rejected lines\n", s, result.rejected);
+        }
+
+        std::string name = "corpus/t" + std::to_string(shape.numOfTriggers) + "/p" +
+                           std::to_string(shape.numOfParams) + "/" + shape.format + "/d" +
+                           std::to_string(shape.valueDigits);
+        runner.run(name, result.accepted, [&]() {
+            bench::doNotOptimize(Cp_FeedBufferEx(parser, corpus.data(), corpus.size()).accepted);
+        },
+                   corpus.size());
+
+        std::free(triggers);
+    }
+
+    delete parser;
+}
@@ -0,0 +1,107 @@
+#include "bench.h"
+#include <cstddef>
+#include <cstring>
+#include "../cparser/inc/cparser.h"
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Dictionary lookups a callback does, while the number of parameters grows.
+ * First and last keys bound the lookup cost, missing keys are checked with 
+ * Dictionary_DoesExist.
+ */
+BENCH(DictionaryGet)
+{
+    static const char keys[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    float values[CPARSER_CONFIG_MAX_NUM_OF_PARAMS];
+
+    for (uint8_t count = 1; count <= CPARSER_CONFIG_MAX_NUM_OF_PARAMS; count++)
+    {
+        Dictionary_t dictionary;
+        char first = keys[0];
+        char last = keys[count - 1];
+        char missing = 'z';
+
+        Dictionary_Clear(&dictionary);
+        for (uint8_t i = 0; i < count; i++)
+        {
+            values[i] = (float)i;
+            Dictionary_Add(&dictionary, keys[i], CP_PARAM_TYPE_REAL, &values[i]);
+        }
+
+        std::string suffix = "/" + std::to_string(count);
+        runner.run("dictionary/get/first" + suffix, 1, [&]() {
+            uint8_t type;
+            bench::doNotOptimize(dictionary);
+            bench::doNotOptimize(Dictionary_Get(&dictionary, first, &type));
+        });
+        runner.run("dictionary/get/last" + suffix, 1, [&]() {
+            uint8_t type;
+            bench::doNotOptimize(dictionary);
+            bench::doNotOptimize(Dictionary_Get(&dictionary, last, &type));
+        });
+        runner.run("dictionary/exists/missing" + suffix, 1, [&]() {
+            bench::doNotOptimize(dictionary);
+            bench::doNotOptimize(Dictionary_DoesExist(&dictionary, missing));
+        });
+    }
+}
+
+/* Private functions -------------------------------------------------------*/
+struct MoveOutput
+{
+    float displacement;
+    float speed;
+};
+
+static void moveCallback(Dictionary_t *params)
+{
+    uint8_t type;
+    float displacement = *((float *)Dictionary_Get(params, 'D', &type));
+    float speed = *((float *)Dictionary_Get(params, 'S', &type));
+
+    bench::doNotOptimize(displacement + speed);
+}
+
+static void typedMoveCallback(void *output, uint32_t present)
+{
+    MoveOutput *move = (MoveOutput *)output;
+
+    (void)present;
+    bench::doNotOptimize(move->displacement + move->speed);
+}
+
+/**
+ * Dispatch of a decoded command to a dictionary callback which looks up its
+ * parameters, against a typed callback which reads them from its struct.
+ */
+BENCH(Dispatch)
+{
+    static Cp_Trigger_t triggers[] = {
+        {"move", {{'D', CP_PARAM_TYPE_REAL}, {'S', CP_PARAM_TYPE_REAL}}, moveCallback, 2},
+        {"tmove",
+         {{'D', CP_PARAM_TYPE_REAL, FALSE, offsetof(MoveOutput, displacement)},
+          {'S', CP_PARAM_TYPE_REAL, FALSE, offsetof(MoveOutput, speed)}},
+         NULL,
+         2,
+         sizeof(MoveOutput),
+         typedMoveCallback},
+    };
+    static const char *lines[] = {"move D12.5 S300.0", "tmove D12.5 S300.0"};
+    static const char *names[] = {"dispatch/dictionary", "dispatch/typed"};
+    Cp_Parser_t *parser = new Cp_Parser_t();
+
+    Cp_RegisterEx(parser, triggers, 2);
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        Cp_Command_t command;
+
+        Cp_DecodeLineEx(parser, lines[i], (uint16_t)std::strlen(lines[i]), &command);
+        runner.run(names[i], 1, [&]() {
+            bench::doNotOptimize(command);
+            Cp_DispatchCommand(&command);
+        });
+    }
+
+    delete parser;
+}
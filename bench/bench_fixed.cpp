@@ -0,0 +1,144 @@
+#include "bench.h"
+#include "../cparser/inc/number.h"
+#include <cstring>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Creates real number strings of various forms(e.g. "-12.625", 
+ * "0.0042", "3.5E2").
+ */
+static std::vector<std::string> createReals(size_t numOfReals)
+{
+    std::vector<std::string> reals;
+    uint32_t seed = 4242;
+
+    for (size_t i = 0; i < numOfReals; i++)
+    {
+        char text[32];
+
+        seed = seed * 1103515245U + 12345U;
+        int32_t whole = (int32_t)((seed >> 8) % 20000U) - 10000;
+        uint32_t fraction = (seed >> 4) % 1000U;
+
+        switch (i % 4)
+        {
+        case 0:
+            std::snprintf(text, sizeof(text), "%d.%03u", (int)whole, (unsigned)fraction);
+            break;
+
+        case 1:
+            std::snprintf(text, sizeof(text), "%d", (int)whole);
+            break;
+
+        case 2:
+            std::snprintf(text, sizeof(text), "0.00%u", (unsigned)fraction);
+            break;
+
+        default:
+            std::snprintf(text, sizeof(text), "%u.%uE%d", (unsigned)(fraction % 10),
+                          (unsigned)fraction, (int)(i % 5));
+            break;
+        }
+        reals.push_back(text);
+    }
+
+    return reals;
+}
+
+/**
+ * @brief Measures the time stamp counter cycles of an operation, as the best
+ * of a few runs over the inputs. Returns zero on the targets without one.
+ */
+template <typename Fn>
+static double measureCycles(size_t numOfOps, Fn fn)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t best = UINT64_MAX;
+
+    for (int run = 0; run < 32; run++)
+    {
+        uint64_t start = __rdtsc();
+        fn();
+        uint64_t cycles = __rdtsc() - start;
+        best = (cycles < best) ? cycles : best;
+    }
+
+    return (double)best / (double)numOfOps;
+#else
+    (void)fn;
+    (void)numOfOps;
+    return 0.0;
+#endif
+}
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Decoding real strings into Q(CPARSER_CONFIG_FIXED_FRACTION_BITS) fixed 
+ * point values against decoding them into floats. Cycles are counted by the 
+ * time stamp counter. The float path runs on the FPU of the host here; on the
+ * targets without one every float operation becomes a soft-float call, so the
+ * gap is a lower bound.
+ */
+BENCH(FixedParsing)
+{
+    const size_t numOfReals = 4096;
+    std::vector<std::string> reals = createReals(numOfReals);
+    size_t bytes = 0;
+
+    for (const std::string &real : reals)
+    {
+        bytes += real.size();
+    }
+
+    auto parseFixed = [&]() {
+        int32_t sum = 0;
+
+        for (const std::string &real : reals)
+        {
+            int32_t value;
+            Number_ParseFixed(real.data(), (uint8_t)real.size(), &value);
+            sum += value;
+        }
+        bench::doNotOptimize(sum);
+    };
+
+    auto parseFloat = [&]() {
+        float sum = 0.0f;
+
+        for (const std::string &real : reals)
+        {
+            float value;
+            Number_ParseFloat(real.data(), (uint8_t)real.size(), &value);
+            sum += value;
+        }
+        bench::doNotOptimize(sum);
+    };
+
+    double fixedNs = runner.run("fixed/parse_fixed", numOfReals, parseFixed, bytes);
+    double floatNs = runner.run("fixed/parse_float", numOfReals, parseFloat, bytes);
+    runner.metric("fixed/speedup", floatNs / fixedNs, "x");
+
+    double fixedCycles = measureCycles(numOfReals, parseFixed);
+    double floatCycles = measureCycles(numOfReals, parseFloat);
+    if (fixedCycles > 0.0)
+    {
+        runner.metric("fixed/parse_fixed/cycles", fixedCycles, "cycles/op");
+        runner.metric("fixed/parse_float/cycles", floatCycles, "cycles/op");
+    }
+
+    runner.run("fixed/format", numOfReals, [&]() {
+        char text[NUMBER_MAX_FIXED_LENGTH];
+        size_t length = 0;
+
+        for (size_t i = 0; i < numOfReals; i++)
+        {
+            length += Number_FormatFixed((int32_t)(i * 2654435761U), text);
+        }
+        bench::doNotOptimize(length);
+    });
+}
@@ -0,0 +1,114 @@
+#include "bench.h"
+#include "../cparser/inc/cparser_format.h"
+#include "../cparser/inc/number.h"
+#include <cstring>
+#include <vector>
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Creates pump responses with varying values.
+ */
+static std::vector<float> createValues(size_t numOfValues)
+{
+    std::vector<float> values;
+    uint32_t seed = 12345;
+
+    for (size_t i = 0; i < numOfValues; i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        values.push_back((float)(seed >> 8) / 1000.0f - 8000.0f);
+    }
+
+    return values;
+}
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Formatting responses("pump M<letter> V<real> C<integer>") with Cp_Format
+ * against snprintf, and the number formatters alone. snprintf writes the 
+ * reals with %.9g, which round trips but isn't the shortest.
+ */
+BENCH(Format)
+{
+    const size_t numOfValues = 4096;
+    std::vector<float> values = createValues(numOfValues);
+    char line[64];
+    size_t bytes = 0;
+
+    for (size_t i = 0; i < numOfValues; i++)
+    {
+        Dictionary_t dictionary = {};
+        char mode = (char)('A' + i % 26);
+        int32_t count = (int32_t)(i * 7919U) - 16000000;
+
+        Dictionary_Add(&dictionary, 'M', CP_PARAM_TYPE_LETTER, &mode);
+        Dictionary_Add(&dictionary, 'V', CP_PARAM_TYPE_REAL, &values[i]);
+        Dictionary_Add(&dictionary, 'C', CP_PARAM_TYPE_INTEGER, &count);
+        bytes += Cp_Format("pump", &dictionary, line, sizeof(line));
+    }
+
+    runner.run("format/cp_format", numOfValues, [&]() {
+        size_t length = 0;
+
+        for (size_t i = 0; i < numOfValues; i++)
+        {
+            Dictionary_t dictionary;
+            char mode = (char)('A' + i % 26);
+            int32_t count = (int32_t)(i * 7919U) - 16000000;
+
+            dictionary.numberOfElements = 0;
+            dictionary.presence = 0;
+            Dictionary_Add(&dictionary, 'M', CP_PARAM_TYPE_LETTER, &mode);
+            Dictionary_Add(&dictionary, 'V', CP_PARAM_TYPE_REAL, &values[i]);
+            Dictionary_Add(&dictionary, 'C', CP_PARAM_TYPE_INTEGER, &count);
+            length += Cp_Format("pump", &dictionary, line, sizeof(line));
+        }
+        bench::doNotOptimize(length);
+    },
+               bytes);
+
+    runner.run("format/snprintf", numOfValues, [&]() {
+        size_t length = 0;
+
+        for (size_t i = 0; i < numOfValues; i++)
+        {
+            char mode = (char)('A' + i % 26);
+            int32_t count = (int32_t)(i * 7919U) - 16000000;
+
+            length += (size_t)std::snprintf(line, sizeof(line), "pump M%c V%.9g C%d", mode,
+                                            (double)values[i], (int)count);
+        }
+        bench::doNotOptimize(length);
+    },
+               bytes);
+
+    runner.run("format/float", numOfValues, [&]() {
+        size_t length = 0;
+
+        for (size_t i = 0; i < numOfValues; i++)
+        {
+            length += Number_FormatFloat(values[i], line);
+        }
+        bench::doNotOptimize(length);
+    });
+
+    runner.run("format/float_snprintf", numOfValues, [&]() {
+        size_t length = 0;
+
+        for (size_t i = 0; i < numOfValues; i++)
+        {
+            length += (size_t)std::snprintf(line, sizeof(line), "%.9g", (double)values[i]);
+        }
+        bench::doNotOptimize(length);
+    });
+
+    runner.run("format/integer", numOfValues, [&]() {
+        size_t length = 0;
+
+        for (size_t i = 0; i < numOfValues; i++)
+        {
+            length += Number_FormatInteger((int32_t)(i * 7919U) - 16000000, line);
+        }
+        bench::doNotOptimize(length);
+    });
+}
@@ -0,0 +1,111 @@
+#include "bench.h"
+#include "../cparser/inc/cparser.h"
+#include "../cparser/inc/tokenizer.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Frames the lines as "N<number> <line>*<checksum>", numbered from 
+ * zero.
+ */
+static std::vector<std::string> frameLines(const std::vector<std::string> &lines)
+{
+    std::vector<std::string> framed;
+
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        std::string line = "N" + std::to_string(i) + " " + lines[i];
+        uint8_t checksum = 0;
+
+        for (char c : line)
+        {
+            checksum ^= (uint8_t)c;
+        }
+        framed.push_back(line + "*" + std::to_string(checksum));
+    }
+
+    return framed;
+}
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Feeding plain lines against feeding the same lines framed with line 
+ * numbers and checksums(Cp_FeedFramedLineEx), and the tokenizer alone with
+ * and without the fused checksum.
+ */
+BENCH(FramedLines)
+{
+    static Cp_Trigger_t triggers[] = {
+        {"G1",
+         {{'X', CP_PARAM_TYPE_REAL}, {'Y', CP_PARAM_TYPE_REAL}, {'F', CP_PARAM_TYPE_INTEGER}},
+         benchTrgCallback,
+         3},
+    };
+    const size_t numOfLines = 4096;
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    std::vector<std::string> lines =
+        bench::createLines(numOfLines, {{"G1 X#.# Y-#.5 F#", 1}});
+    std::vector<std::string> framed = frameLines(lines);
+    size_t plainSize = 0;
+    size_t framedSize = 0;
+
+    for (size_t i = 0; i < numOfLines; i++)
+    {
+        plainSize += lines[i].size();
+        framedSize += framed[i].size();
+    }
+
+    Cp_RegisterEx(parser, triggers, 1);
+
+    double plainNs = runner.run("frame/plain", numOfLines, [&]() {
+        for (const std::string &line : lines)
+        {
+            bench::doNotOptimize(Cp_FeedLineEx(parser, line.data(), (uint16_t)line.size()));
+        }
+    },
+                                plainSize);
+
+    double framedNs = runner.run("frame/framed", numOfLines, [&]() {
+        Cp_SetLineNumberEx(parser, 0);
+        for (const std::string &line : framed)
+        {
+            bench::doNotOptimize(
+                Cp_FeedFramedLineEx(parser, line.data(), (uint16_t)line.size()));
+        }
+    },
+                                 framedSize);
+    runner.metric("frame/overhead", framedNs / plainNs, "x");
+
+    // Framed lines are longer by their line number and checksum fields.
+    runner.metric("frame/overhead_per_byte",
+                  (framedNs / (double)framedSize) / (plainNs / (double)plainSize), "x");
+
+    runner.run("frame/tokenize_plain", numOfLines, [&]() {
+        for (const std::string &line : framed)
+        {
+            Field_t fields[8];
+            uint8_t count;
+            bench::doNotOptimize(
+                Tokenizer_ParseFields(line.data(), (uint16_t)line.size(), fields, 8, &count));
+            bench::doNotOptimize(count);
+        }
+    },
+               framedSize);
+
+    runner.run("frame/tokenize_checksum", numOfLines, [&]() {
+        for (const std::string &line : framed)
+        {
+            Field_t fields[8];
+            uint8_t count;
+            uint8_t checksum;
+            bench::doNotOptimize(Tokenizer_ParseFramedFields(line.data(), (uint16_t)line.size(),
+                                                             fields, 8, &count, &checksum));
+            bench::doNotOptimize(checksum);
+        }
+    },
+               framedSize);
+
+    delete parser;
+}
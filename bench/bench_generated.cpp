@@ -0,0 +1,100 @@
+#include "bench.h"
+#include "bench_parser.h"
+#include "../cparser/inc/cparser.h"
+#include "../cparser/inc/cparser_static.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Private variables -------------------------------------------------------*/
+// Triggers of triggers.spec as a constexpr table.
+constexpr cparser::Trigger StaticTriggers[] = {
+    cparser::trigger("move", benchTrgCallback, cparser::param('X', CP_PARAM_TYPE_REAL),
+                     cparser::param('Y', CP_PARAM_TYPE_REAL),
+                     cparser::param('Z', CP_PARAM_TYPE_REAL),
+                     cparser::param('F', CP_PARAM_TYPE_REAL)),
+    cparser::trigger("jump", benchTrgCallback, cparser::param('X', CP_PARAM_TYPE_REAL),
+                     cparser::param('Y', CP_PARAM_TYPE_REAL)),
+    cparser::trigger("pump", benchTrgCallback, cparser::param('M', CP_PARAM_TYPE_LETTER),
+                     cparser::param('V', CP_PARAM_TYPE_REAL)),
+    cparser::trigger("home", benchTrgCallback, cparser::param('X', CP_PARAM_TYPE_INTEGER, true),
+                     cparser::param('Y', CP_PARAM_TYPE_INTEGER)),
+    cparser::trigger("dwell", benchTrgCallback, cparser::param('T', CP_PARAM_TYPE_FIXED, true)),
+    cparser::trigger("speed", benchTrgCallback, cparser::param('S', CP_PARAM_TYPE_INTEGER, true)),
+    cparser::trigger("tool", benchTrgCallback, cparser::param('N', CP_PARAM_TYPE_INTEGER, true)),
+    cparser::trigger("temp", benchTrgCallback, cparser::param('H', CP_PARAM_TYPE_INTEGER),
+                     cparser::param('T', CP_PARAM_TYPE_REAL)),
+};
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Lines fed to the generic parser with the triggers of triggers.spec 
+ * registered(Cp_FeedLineEx) against the parser generated from the spec
+ * (Bench_FeedLine) and the parser of the same triggers in a constexpr table
+ * (cparser::StaticParser). All tokenize, decode and invoke the callback.
+ */
+BENCH(Generated)
+{
+    static Cp_Trigger_t triggers[] = {
+        {"move",
+         {{'X', CP_PARAM_TYPE_REAL}, {'Y', CP_PARAM_TYPE_REAL}, {'Z', CP_PARAM_TYPE_REAL},
+          {'F', CP_PARAM_TYPE_REAL}},
+         benchTrgCallback,
+         4},
+        {"jump", {{'X', CP_PARAM_TYPE_REAL}, {'Y', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+        {"pump", {{'M', CP_PARAM_TYPE_LETTER}, {'V', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+        {"home",
+         {{'X', CP_PARAM_TYPE_INTEGER, TRUE}, {'Y', CP_PARAM_TYPE_INTEGER}},
+         benchTrgCallback,
+         2},
+        {"dwell", {{'T', CP_PARAM_TYPE_FIXED, TRUE}}, benchTrgCallback, 1},
+        {"speed", {{'S', CP_PARAM_TYPE_INTEGER, TRUE}}, benchTrgCallback, 1},
+        {"tool", {{'N', CP_PARAM_TYPE_INTEGER, TRUE}}, benchTrgCallback, 1},
+        {"temp", {{'H', CP_PARAM_TYPE_INTEGER}, {'T', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+    };
+    const size_t numOfLines = 4096;
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    // One unknown trigger in every sixteen lines.
+    const std::vector<bench::LineFormat> formats = {
+        {"probe X#", 1}, {"move X#.5 Y-#.25 Z# F1500", 5}, {"jump X# Y#.75", 2},
+        {"pump M@ V#.125", 2}, {"home X# Y-#", 1}, {"dwell T0.#", 1},
+        {"speed S#00", 1}, {"tool N#", 1}, {"temp H# T2#.5", 2}};
+    std::vector<std::string> lines = bench::createLines(numOfLines, formats);
+    size_t bytes = 0;
+
+    for (const std::string &line : lines)
+    {
+        bytes += line.size() + 1;
+    }
+
+    Cp_RegisterEx(parser, triggers, sizeof(triggers) / sizeof(triggers[0]));
+
+    double genericNs = runner.run("generated/generic", numOfLines, [&]() {
+        for (const std::string &line : lines)
+        {
+            bench::doNotOptimize(Cp_FeedLineEx(parser, line.data(), (uint16_t)line.size()));
+        }
+    },
+                                  bytes);
+
+    double generatedNs = runner.run("generated/specialized", numOfLines, [&]() {
+        for (const std::string &line : lines)
+        {
+            bench::doNotOptimize(Bench_FeedLine(line.data(), (uint16_t)line.size()));
+        }
+    },
+                                    bytes);
+    runner.metric("generated/speedup", genericNs / generatedNs, "x");
+
+    cparser::StaticParser<StaticTriggers> staticParser;
+    double staticNs = runner.run("generated/static_table", numOfLines, [&]() {
+        for (const std::string &line : lines)
+        {
+            bench::doNotOptimize(staticParser.feedLine(line));
+        }
+    },
+                                 bytes);
+    runner.metric("generated/static_speedup", genericNs / staticNs, "x");
+
+    delete parser;
+}
@@ -0,0 +1,64 @@
+#include "bench.h"
+#include <cstdlib>
+#include "../cparser/inc/cparser.h"
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Trigger lookup cost while the registry grows. Lines hit the first, the last
+ * and a spread of registered triggers, or miss all of them.
+ */
+BENCH(TriggerLookup)
+{
+    static const uint16_t counts[] = {25, 64, 256, 1024, 4096};
+    const uint16_t lines = 256;
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        uint16_t count = counts[c];
+        Cp_Trigger_t *triggers = bench::createTriggers(count, 0, CP_PARAM_TYPE_INTEGER);
+        char first[] = "t0000";
+        char last[8];
+        char miss[] = "x0000";
+        std::vector<std::string> spread;
+
+        std::snprintf(last, sizeof(last), "t%04u", count - 1);
+        for (uint16_t i = 0; i < lines; i++)
+        {
+            char name[8];
+            std::snprintf(name, sizeof(name), "t%04u", (uint16_t)((i * 7919U) % count));
+            spread.push_back(name);
+        }
+
+        Cp_Reset();
+        Cp_Register(triggers, count);
+
+        std::string suffix = "/" + std::to_string(count);
+        runner.run("lookup/first" + suffix, lines, [&]() {
+            for (uint16_t i = 0; i < lines; i++)
+            {
+                bench::doNotOptimize(Cp_FeedLine(first, sizeof(first) - 1));
+            }
+        });
+        runner.run("lookup/last" + suffix, lines, [&]() {
+            for (uint16_t i = 0; i < lines; i++)
+            {
+                bench::doNotOptimize(Cp_FeedLine(last, 5));
+            }
+        });
+        runner.run("lookup/spread" + suffix, lines, [&]() {
+            for (uint16_t i = 0; i < lines; i++)
+            {
+                bench::doNotOptimize(Cp_FeedLine(&spread[i][0], 5));
+            }
+        });
+        runner.run("lookup/miss" + suffix, lines, [&]() {
+            for (uint16_t i = 0; i < lines; i++)
+            {
+                bench::doNotOptimize(Cp_FeedLine(miss, sizeof(miss) - 1));
+            }
+        });
+
+        Cp_Reset();
+        std::free(triggers);
+    }
+}
@@ -0,0 +1,140 @@
+#include "bench.h"
+#include <cstdlib>
+#include <cstring>
+#include "../cparser/inc/cparser_config.h"
+#include "../cparser/inc/tokenizer.h"
+
+/* Exported functions ------------------------------------------------------*/
+void benchTrgCallback(Dictionary_t *params)
+{
+    float sum = 0.0f;
+
+    for (uint8_t i = 0; i < params->numberOfElements; i++)
+    {
+        if (params->types[i] == CP_PARAM_TYPE_REAL)
+        {
+            sum += *(float *)params->values[i];
+        }
+        else if (params->types[i] == CP_PARAM_TYPE_INTEGER)
+        {
+            sum += (float)*(int32_t *)params->values[i];
+        }
+    }
+
+    bench::doNotOptimize(sum);
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Writes a string as a JSON string literal.
+ */
+static void writeJsonString(FILE *output, const std::string &value)
+{
+    std::fputc('"', output);
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        if (value[i] == '"' || value[i] == '\\')
+        {
+            std::fputc('\\', output);
+        }
+        std::fputc(value[i], output);
+    }
+    std::fputc('"', output);
+}
+
+/**
+ * @brief Writes the results and the build context as a JSON document.
+ */
+static void writeJson(FILE *output, const bench::Runner &runner, double minSeconds)
+{
+    static const char *impls[] = {"scalar", "sse2", "avx2"};
+    const std::vector<bench::Result> &results = runner.results();
+
+    std::fprintf(output, "{\n  \"context\": {\n");
+    std::fprintf(output, "    \"min_seconds\": %g,\n", minSeconds);
+    std::fprintf(output, "    \"tokenizer\": \"%s\",\n", impls[Tokenizer_GetImpl()]);
+    std::fprintf(output, "    \"max_num_of_params\": %d,\n", CPARSER_CONFIG_MAX_NUM_OF_PARAMS);
+    std::fprintf(output, "    \"max_trigger_name_length\": %d\n",
+                 CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH);
+    std::fprintf(output, "  },\n  \"results\": [");
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        std::fprintf(output, "%s\n    {\"name\": ", i ? "," : "");
+        writeJsonString(output, results[i].name);
+        if (results[i].unit.empty())
+        {
+            std::fprintf(output, ", \"ns_per_op\": %.3f, \"ops\": %llu", results[i].nsPerOp,
+                         (unsigned long long)results[i].ops);
+            if (results[i].mbPerSecond > 0.0)
+            {
+                std::fprintf(output, ", \"mb_per_s\": %.3f", results[i].mbPerSecond);
+            }
+        }
+        else
+        {
+            std::fprintf(output, ", \"value\": %.6g, \"unit\": ", results[i].value);
+            writeJsonString(output, results[i].unit);
+        }
+        std::fprintf(output, "}");
+    }
+
+    std::fprintf(output, "\n  ]\n}\n");
+}
+
+/**
+ * Runs the registered benchmarks. Benchmarks whose names contain one of the
+ * arguments are run, all of them are run if no argument is given. With the
+ * --json option results are written to the standard output as a JSON 
+ * document and the progress goes to the standard error. Minimum measurement
+ * time can be changed by the BENCH_MIN_SECONDS environment variable.
+ */
+int main(int argc, char **argv)
+{
+    double min_seconds = 0.2;
+    bool json = false;
+    std::vector<std::string> filters;
+    const char *env = std::getenv("BENCH_MIN_SECONDS");
+    if (env)
+    {
+        min_seconds = std::atof(env);
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--json") == 0)
+        {
+            json = true;
+        }
+        else
+        {
+            filters.push_back(argv[i]);
+        }
+    }
+
+    bench::Runner runner(min_seconds, json ? stderr : stdout);
+    for (size_t i = 0; i < bench::registry().size(); i++)
+    {
+        const std::string &name = bench::registry()[i].first;
+        bool selected = filters.empty();
+        for (size_t j = 0; j < filters.size(); j++)
+        {
+            if (name.find(filters[j]) != std::string::npos)
+            {
+                selected = true;
+            }
+        }
+
+        if (selected)
+        {
+            bench::registry()[i].second(runner);
+        }
+    }
+
+    if (json)
+    {
+        writeJson(stdout, runner, min_seconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "bench.h"
+#include <cstdlib>
+#include <cstring>
+#include "../cparser/inc/number.h"
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Real number parsing against strtof, for plain decimals, long mantissas and
+ * big exponents.
+ */
+BENCH(RealParsing)
+{
+    static const char *groups[][4] = {
+        {"decimal", "1.25", "-12.5", "1500.0"},
+        {"long", "3.14159265", "-0.000123456789", "98765.4321"},
+        {"scientific", "6.02E23", "-1.6E-19", "1.5E2"},
+        {"extreme", "3.4028234E38", "1.17549435E-38", "1E-44"},
+    };
+
+    for (size_t g = 0; g < sizeof(groups) / sizeof(groups[0]); g++)
+    {
+        std::string name(groups[g][0]);
+        size_t lengths[3];
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            lengths[i] = std::strlen(groups[g][i + 1]);
+        }
+
+        runner.run("real/cparser/" + name, 3, [&]() {
+            for (size_t i = 0; i < 3; i++)
+            {
+                float value;
+                bench::doNotOptimize(Number_ParseFloat(groups[g][i + 1], (uint8_t)lengths[i], &value));
+                bench::doNotOptimize(value);
+            }
+        });
+        runner.run("real/strtof/" + name, 3, [&]() {
+            for (size_t i = 0; i < 3; i++)
+            {
+                bench::doNotOptimize(std::strtof(groups[g][i + 1], NULL));
+            }
+        });
+    }
+}
+
+/**
+ * Integer parsing against strtol, for short, long and signed values and the
+ * range limits.
+ */
+BENCH(IntegerParsing)
+{
+    static const char *groups[][4] = {
+        {"short", "7", "42", "300"},
+        {"long", "1234567", "98765432", "2000000000"},
+        {"signed", "-12", "+4096", "-2147483"},
+        {"limits", "2147483647", "-2147483648", "0000000001000000"},
+    };
+
+    for (size_t g = 0; g < sizeof(groups) / sizeof(groups[0]); g++)
+    {
+        std::string name(groups[g][0]);
+        size_t lengths[3];
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            lengths[i] = std::strlen(groups[g][i + 1]);
+        }
+
+        runner.run("integer/cparser/" + name, 3, [&]() {
+            for (size_t i = 0; i < 3; i++)
+            {
+                int32_t value;
+                bench::doNotOptimize(Number_ParseInteger(groups[g][i + 1], (uint8_t)lengths[i], &value));
+                bench::doNotOptimize(value);
+            }
+        });
+        runner.run("integer/strtol/" + name, 3, [&]() {
+            for (size_t i = 0; i < 3; i++)
+            {
+                bench::doNotOptimize(std::strtol(groups[g][i + 1], NULL, 10));
+            }
+        });
+    }
+}
@@ -0,0 +1,94 @@
+#include "bench.h"
+#include "../cparser/inc/cparser_parallel.h"
+
+/* Private functions -------------------------------------------------------*/
+static thread_local float ValueSum;
+
+static void summingCallback(Dictionary_t *params)
+{
+    for (uint8_t i = 0; i < params->numberOfElements; i++)
+    {
+        if (params->types[i] == CP_PARAM_TYPE_REAL)
+        {
+            ValueSum += *(float *)params->values[i];
+        }
+    }
+
+    bench::doNotOptimize(ValueSum);
+}
+
+/**
+ * @brief Creates a command log of the given size with a mix of triggers.
+ */
+static std::string createLog(size_t size)
+{
+    static const char *lines[] = {
+        "move D12.5 S300.0\n",
+        "versi V42\n",
+        "pump MD V1.25\n",
+        "move D-0.125 S1.5E2\n",
+        "delay T0.001\n",
+        "unknown X1\n",
+    };
+    std::string log;
+    size_t i = 0;
+
+    log.reserve(size + 32);
+    while (log.size() < size)
+    {
+        log += lines[(i * 7U) % (sizeof(lines) / sizeof(lines[0]))];
+        i++;
+    }
+
+    return log;
+}
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Throughput of the parallel feed over a command log while the number of 
+ * threads grows, in ordered and unordered modes. Speedups are relative to 
+ * the single thread feed of the same mode.
+ */
+BENCH(ParallelFeed)
+{
+    static Cp_Trigger_t triggers[] = {
+        {"move", {{'D', CP_PARAM_TYPE_REAL}, {'S', CP_PARAM_TYPE_REAL}}, summingCallback, 2},
+        {"versi", {{'V', CP_PARAM_TYPE_INTEGER}}, summingCallback, 1},
+        {"pump", {{'M', CP_PARAM_TYPE_LETTER}, {'V', CP_PARAM_TYPE_REAL}}, summingCallback, 2},
+        {"delay", {{'T', CP_PARAM_TYPE_REAL}}, summingCallback, 1},
+    };
+    static const uint16_t threads[] = {1, 2, 4, 8, 16};
+    static const char *modes[] = {"ordered", "unordered"};
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    std::string log = createLog(16 << 20);
+
+    Cp_RegisterEx(parser, triggers, sizeof(triggers) / sizeof(triggers[0]));
+
+    runner.run("parallel/serial", 1, [&]() {
+        bench::doNotOptimize(Cp_FeedBufferEx(parser, log.data(), log.size()).accepted);
+    },
+               log.size());
+
+    for (uint8_t mode = 0; mode < 2; mode++)
+    {
+        double base = 0.0;
+
+        for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+        {
+            Cp_ParallelConfig_t config = {threads[t], 0, mode ? TRUE : FALSE};
+            std::string name = "parallel/" + std::string(modes[mode]) + "/" +
+                               std::to_string(threads[t]);
+
+            double ns = runner.run(name, 1, [&]() {
+                bench::doNotOptimize(
+                    Cp_FeedBufferParallel(parser, log.data(), log.size(), &config).accepted);
+            },
+                                   log.size());
+
+            base = (t == 0) ? ns : base;
+            runner.metric(name + "/speedup", base / ns, "x");
+        }
+    }
+
+    delete parser;
+}
@@ -0,0 +1,87 @@
+#include "bench.h"
+#include "../cparser/inc/cparser_registry.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Buffer feed throughput with the own registry of the parser, with a shared 
+ * registry and with a shared registry which another thread replaces 
+ * continuously; the replaced registries are reclaimed and rebuilt.
+ */
+BENCH(RegistrySwap)
+{
+    static Cp_Trigger_t heads[2][3] = {
+        {{"move", {{'D', CP_PARAM_TYPE_REAL}, {'S', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+         {"pump", {{'M', CP_PARAM_TYPE_LETTER}, {'V', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+         {"delay", {{'T', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 1}},
+        {{"delay", {{'T', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 1},
+         {"move", {{'S', CP_PARAM_TYPE_REAL}, {'D', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+         {"pump", {{'V', CP_PARAM_TYPE_REAL}, {'M', CP_PARAM_TYPE_LETTER}}, benchTrgCallback, 2}},
+    };
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    Cp_Registry_t *registries = new Cp_Registry_t[3]();
+    Cp_SharedRegistry_t *shared = new Cp_SharedRegistry_t();
+    const std::vector<bench::LineFormat> formats = {
+        {"move D#.5 S#.0", 1}, {"pump M@ V#.25", 1}, {"move D-0.# S#.5E2", 1}, {"delay T0.#", 1}};
+    std::string buffer = bench::joinLines(bench::createLines(4096, formats));
+
+    Cp_RegisterEx(parser, heads[0], 3);
+    runner.run("registry/own", 4096, [&]() {
+        bench::doNotOptimize(Cp_FeedBufferEx(parser, buffer.data(), buffer.size()).accepted);
+    },
+               buffer.size());
+
+    Cp_RegistryAdd(&registries[0], heads[0], 3);
+    Cp_SharedRegistryInit(shared, &registries[0]);
+    Cp_AttachRegistryEx(parser, shared);
+    runner.run("registry/shared", 4096, [&]() {
+        bench::doNotOptimize(Cp_FeedBufferEx(parser, buffer.data(), buffer.size()).accepted);
+    },
+               buffer.size());
+
+    std::atomic<bool> stop(false);
+    size_t swaps = 0;
+    std::thread writer([&]() {
+        std::vector<Cp_Registry_t *> free = {&registries[1], &registries[2]};
+        const Cp_Registry_t *reclaimed;
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            while ((reclaimed = Cp_SharedRegistryReclaim(shared)) != NULL)
+            {
+                free.push_back(const_cast<Cp_Registry_t *>(reclaimed));
+            }
+
+            if (!free.empty())
+            {
+                Cp_Registry_t *registry = free.back();
+
+                free.pop_back();
+                Cp_RegistryInit(registry);
+                Cp_RegistryAdd(registry, heads[swaps % 2], 3);
+                Cp_SharedRegistryPublish(shared, registry);
+                swaps++;
+            }
+
+            std::this_thread::yield();
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    runner.run("registry/shared/swapping", 4096, [&]() {
+        bench::doNotOptimize(Cp_FeedBufferEx(parser, buffer.data(), buffer.size()).accepted);
+    },
+               buffer.size());
+    stop.store(true);
+    writer.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    runner.metric("registry/shared/swapping/swaps", swaps / seconds, "swaps/s");
+
+    Cp_DetachRegistryEx(parser);
+    delete shared;
+    delete[] registries;
+    delete parser;
+}
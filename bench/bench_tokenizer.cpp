@@ -0,0 +1,42 @@
+#include "bench.h"
+#include "../cparser/inc/tokenizer.h"
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Tokenizer throughput of each supported implementation over long lines with
+ * many parameters.
+ */
+BENCH(Tokenizer)
+{
+    static const char *names[] = {"scalar", "sse2", "avx2"};
+    static const char *lines[] = {
+        "move D1.0 S5.0",
+        "pump MD V1.25 T0.001 R-12.5E-3 C42",
+        "probe X-1234.5678 Y9876.54321 Z0.000125 F1500.0 E-0.25 A12.75 B-3.5 "
+        "C0.125 I17.5 J-22.25 K3.14159 P120 Q88 R1.5E2 S-6.02E23 T-1.6E-19",
+    };
+
+    for (size_t l = 0; l < sizeof(lines) / sizeof(lines[0]); l++)
+    {
+        std::string line(lines[l]);
+        uint16_t length = (uint16_t)line.size();
+
+        for (uint8_t impl = TOKENIZER_IMPL_SCALAR; impl <= TOKENIZER_IMPL_AVX2; impl++)
+        {
+            if (!Tokenizer_IsSupported(impl))
+            {
+                continue;
+            }
+
+            runner.run("tokenizer/" + std::string(names[impl]) + "/" + std::to_string(length),
+                       1, [&]() {
+                           Field_t fields[32];
+                           uint8_t count;
+                           bench::doNotOptimize(Tokenizer_ParseFieldsWith(
+                               impl, line.data(), length, fields, 32, &count));
+                           bench::doNotOptimize(count);
+                       },
+                       length);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include "bench.h"
+#include "../cparser/inc/cparser.h"
+#include "../cparser/inc/cparser_trace.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* Benchmarks --------------------------------------------------------------*/
+/**
+ * Lines fed through Cp_FeedLineEx with the trace points of the library. In 
+ * cparser_bench they are compiled out(trace/compiled_out); in 
+ * cparser_tracebench they are compiled in and measured without a buffer 
+ * attached to the thread(trace/detached) and with one(trace/attached), 
+ * where each accepted line writes ten records.
+ */
+BENCH(Trace)
+{
+    static Cp_Trigger_t triggers[] = {
+        {"move",
+         {{'X', CP_PARAM_TYPE_REAL}, {'Y', CP_PARAM_TYPE_REAL}, {'Z', CP_PARAM_TYPE_REAL},
+          {'F', CP_PARAM_TYPE_REAL}},
+         benchTrgCallback,
+         4},
+        {"pump", {{'M', CP_PARAM_TYPE_LETTER}, {'V', CP_PARAM_TYPE_REAL}}, benchTrgCallback, 2},
+        {"speed", {{'S', CP_PARAM_TYPE_INTEGER, TRUE}}, benchTrgCallback, 1},
+    };
+    const size_t numOfLines = 4096;
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    // One unknown trigger in every eight lines.
+    const std::vector<bench::LineFormat> formats = {
+        {"probe X#", 1}, {"move X#.5 Y-#.25 Z# F1500", 4}, {"pump M@ V#.125", 2},
+        {"speed S#00", 1}};
+    std::vector<std::string> lines = bench::createLines(numOfLines, formats);
+    size_t bytes = 0;
+
+    for (const std::string &line : lines)
+    {
+        bytes += line.size() + 1;
+    }
+
+    Cp_RegisterEx(parser, triggers, sizeof(triggers) / sizeof(triggers[0]));
+
+    auto feed = [&]() {
+        for (const std::string &line : lines)
+        {
+            bench::doNotOptimize(Cp_FeedLineEx(parser, line.data(), (uint16_t)line.size()));
+        }
+    };
+
+#if CPARSER_CONFIG_TRACE
+    Cp_TraceBuffer_t *buffer = new Cp_TraceBuffer_t();
+
+    double detachedNs = runner.run("trace/detached", numOfLines, feed, bytes);
+
+    Cp_TraceInit(buffer, 0);
+    Cp_TraceAttach(buffer);
+    double attachedNs = runner.run("trace/attached", numOfLines, feed, bytes);
+    Cp_TraceAttach(NULL);
+
+    runner.metric("trace/overhead", attachedNs - detachedNs, "ns/line");
+    runner.metric("trace/overhead_ratio", attachedNs / detachedNs, "x");
+    delete buffer;
+#else
+    runner.run("trace/compiled_out", numOfLines, feed, bytes);
+#endif
+
+    delete parser;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file bench_triggers.c
+ * 
+ * Generated trigger tables of the benchmarks. Members of a trigger are 
+ * constant for the applications, so the tables are filled in C, where the 
+ * allocated triggers can be written through non-constant pointers.
+ */
+#include "../cparser/inc/cparser.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Creates a table of triggers named t0000, t0001... with the 
+ * parameters A, B... of the given type.
+ * 
+ * @param numOfTriggers: Number of triggers.
+ * @param numOfParams: Number of parameters of every trigger.
+ * @param type: Type of the parameters.
+ * @param callback: Callback of every trigger.
+ * 
+ * @retval Table of the triggers, freed with free.
+ */
+Cp_Trigger_t *benchCreateTriggers(uint16_t numOfTriggers, uint8_t numOfParams,
+                                  Cp_ParamType_t type, Cp_ParsedCallback_t callback)
+{
+    Cp_Trigger_t *triggers = (Cp_Trigger_t *)calloc(numOfTriggers, sizeof(Cp_Trigger_t));
+
+    for (uint16_t i = 0; i < numOfTriggers; i++)
+    {
+        Cp_Trigger_t *trigger = &triggers[i];
+
+        snprintf((char *)trigger->name, sizeof(trigger->name), "t%04u", (unsigned)i);
+        for (uint8_t p = 0; p < numOfParams; p++)
+        {
+            Cp_Param_t *param = (Cp_Param_t *)&trigger->params[p];
+
+            param->letter = (char)('A' + p);
+            param->type = type;
+        }
+        *(Cp_ParsedCallback_t *)&trigger->callback = callback;
+        *(uint8_t *)&trigger->numOfParams = numOfParams;
+    }
+
+    return triggers;
+}
@@ -0,0 +1,9 @@
+# Triggers of the Generated benchmark(bench_generated.cpp).
+move X:real Y:real Z:real F:real -> benchTrgCallback
+jump X:real Y:real -> benchTrgCallback
+pump M:letter V:real -> benchTrgCallback
+home X:integer! Y:integer -> benchTrgCallback
+dwell T:fixed! -> benchTrgCallback
+speed S:integer! -> benchTrgCallback
+tool N:integer! -> benchTrgCallback
+temp H:integer T:real -> benchTrgCallback
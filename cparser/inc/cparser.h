@@ -22,13 +22,23 @@ extern "C"
      */
     typedef void (*Cp_ParsedCallback_t)(Dictionary_t *dictionary);
 
+    /**
+     * @brief Callback function prototype for the typed trigger callbacks.
+     * 
+     * @param output: Pointer to the output struct of the trigger. Fields of
+     * the parameters which aren't given are zero.
+     * @param present: Bit per given parameter, in the parameter order.
+     */
+    typedef void (*Cp_TypedCallback_t)(void *output, uint32_t present);
+
     /*! Parameter type enumeration. Determines type of the parameter to be 
     parsed. */
     enum _Cp_ParamType_t
     {
         CP_PARAM_TYPE_LETTER = 0,  /*!< Letter */
         CP_PARAM_TYPE_INTEGER = 1, /*!< Signed integer */
-        CP_PARAM_TYPE_REAL = 2     /*!< Real number */
+        CP_PARAM_TYPE_REAL = 2,    /*!< Real number */
+        CP_PARAM_TYPE_FIXED = 3    /*!< Real number in fixed point(int32_t) */
     };
     typedef uint8_t Cp_ParamType_t;
 
@@ -40,6 +50,8 @@ extern "C"
     {
         char letter;         /**< Letter of the parameter */
         Cp_ParamType_t type; /**< Type of the parameter */
+        Bool_t required;     /**< Lines without the parameter are rejected */
+        uint16_t offset;     /**< Offset of the field in the output struct(typed triggers) */
     } Cp_Param_t;
 
     /**
@@ -55,12 +67,244 @@ extern "C"
         /**< Parsed callback function pointer */
         const uint8_t numOfParams;
         /**< Number of parameters */
+        const uint16_t outputSize;
+        /**< Size of the output struct, zero if the trigger isn't typed */
+        const Cp_TypedCallback_t typedCallback;
+        /**< Typed callback function pointer; used instead of the callback if
+        given */
     } Cp_Trigger_t;
 
+    /**
+     * Result of feeding a buffer of lines.
+     */
+    typedef struct
+    {
+        size_t accepted; /**< Number of lines parsed and dispatched */
+        size_t rejected; /**< Number of non-empty lines rejected */
+    } Cp_FeedResult_t;
+
+    /*! Status of a line which is decoded from a buffer. */
+    enum _Cp_LineStatus_t
+    {
+        CP_LINE_STATUS_EMPTY = 0,    /*!< Line has no fields */
+        CP_LINE_STATUS_ACCEPTED = 1, /*!< Line is decoded */
+        CP_LINE_STATUS_REJECTED = 2  /*!< Line is malformed or its trigger is unknown */
+    };
+    typedef uint8_t Cp_LineStatus_t;
+
+    /*! Status of a framed line("N<line number> ... *<checksum>"). */
+    enum _Cp_FrameStatus_t
+    {
+        CP_FRAME_STATUS_ACCEPTED = 0,             /*!< Frame is valid, line is dispatched */
+        CP_FRAME_STATUS_REJECTED = 1,             /*!< Frame is valid, line is rejected */
+        CP_FRAME_STATUS_MISSING_CHECKSUM = 2,     /*!< Line has no valid checksum field */
+        CP_FRAME_STATUS_CHECKSUM_MISMATCH = 3,    /*!< Checksum doesn't match the line */
+        CP_FRAME_STATUS_MISSING_LINE_NUMBER = 4,  /*!< Line doesn't start with N<number> */
+        CP_FRAME_STATUS_LINE_NUMBER_MISMATCH = 5, /*!< Line number isn't the expected one */
+        CP_FRAME_STATUS_OVERSIZED = 6,            /*!< Line has too many fields */
+        CP_FRAME_STATUS_QUEUE_FULL = 7            /*!< Command doesn't fit into the full queue */
+    };
+    typedef uint8_t Cp_FrameStatus_t;
+
+    /*! Reason of a line rejection which is counted by the statistics. */
+    enum _Cp_RejectReason_t
+    {
+        CP_REJECT_REASON_NONE = 0,            /*!< Line isn't rejected */
+        CP_REJECT_REASON_UNKNOWN_TRIGGER = 1, /*!< Trigger name isn't registered */
+        CP_REJECT_REASON_MALFORMED_VALUE = 2, /*!< A parameter value can't be parsed */
+        CP_REJECT_REASON_MISSING_PARAM = 3,   /*!< A required parameter isn't given */
+        CP_REJECT_REASON_OVERSIZED = 4,       /*!< Line is too long or has too many fields */
+        CP_REJECT_REASON_DROPPED = 5          /*!< Command doesn't fit into the full queue */
+    };
+    typedef uint8_t Cp_RejectReason_t;
+
+/** Number of the reject reasons, including CP_REJECT_REASON_NONE. */
+#define CP_NUM_OF_REJECT_REASONS 6
+
+/** Number of the buckets in a latency histogram. */
+#define CP_STATS_HISTOGRAM_SIZE 32
+
+/** Words of 19 digits which the stream keeps after a full mantissa. With the
+mantissa they hold the 113 significant digits of the longest tie point of 
+floats, so the digits dropped after them can only break a tie. */
+#define CP_ACCUMULATOR_TAIL_WORDS 5
+
+    /**
+     * Runtime statistics of a parser. Bucket b of a latency histogram counts
+     * the durations which need b bits, i.e. [2^(b-1), 2^b) clock ticks; the 
+     * last bucket also counts the longer ones.
+     */
+    typedef struct
+    {
+        size_t accepted;                                 /**< Number of accepted lines */
+        size_t rejected[CP_NUM_OF_REJECT_REASONS];       /**< Rejected lines per reason */
+        size_t hits[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS]; /**< Accepted lines per registry position */
+        size_t parseTime[CP_STATS_HISTOGRAM_SIZE];       /**< Histogram of the decoding times */
+        size_t callbackTime[CP_STATS_HISTOGRAM_SIZE];    /**< Histogram of the callback times */
+    } Cp_Stats_t;
+
+    /**
+     * Decoded line. Keeps everything needed to invoke the callback later, 
+     * and doesn't point into itself; so it can be copied or moved freely.
+     */
+    typedef struct
+    {
+        Cp_Trigger_t *trigger;                             /**< Matched trigger */
+        uint16_t position;                                 /**< Registry position of the trigger */
+        uint32_t values[CPARSER_CONFIG_MAX_NUM_OF_PARAMS]; /**< Storage of the values */
+        uint32_t present;                                  /**< Bit per given parameter */
+        uint8_t params[CPARSER_CONFIG_MAX_NUM_OF_PARAMS];  /**< Parameter index of each value */
+        uint8_t numOfValues;                               /**< Number of the values */
+    } Cp_Command_t;
+
+    /**
+     * Queue of decoded commands, see cparser_queue.h.
+     */
+    typedef struct _Cp_Queue_t Cp_Queue_t;
+
+    /**
+     * Cache of the decoded lines, see cparser_cache.h.
+     */
+    typedef struct _Cp_LineCache_t Cp_LineCache_t;
+
+    /**
+     * Incremental decoder of a single parameter value. Internal to the parser;
+     * exposed only so the parser object can be allocated by the application.
+     */
+    typedef struct
+    {
+        uint64_t mantissa;  /**< Significant digits of the value */
+        uint64_t tail[CP_ACCUMULATOR_TAIL_WORDS];
+        /**< Digits which follow a full mantissa */
+        int32_t exponent;   /**< Decimal exponent of the mantissa */
+        int32_t expValue;   /**< Value written after the exponent sign */
+        uint8_t digits;     /**< Number of significant digits in the mantissa */
+        uint8_t tailDigits; /**< Number of the tail digits */
+        uint8_t sticky;     /**< Whether non-zero digits are dropped after the tail */
+        uint8_t length;     /**< Number of characters consumed */
+        uint8_t phase;      /**< Phase of the number grammar */
+        uint8_t hasDigits;  /**< Whether any mantissa digit has been seen */
+        int8_t sign;        /**< Sign of the value */
+        int8_t expSign;     /**< Sign of the exponent */
+        char letter;        /**< First character of a letter value */
+    } Cp_Accumulator_t;
+
+    /**
+     * Parameter binding of a registered trigger. Internal to the parser.
+     */
+    typedef struct
+    {
+        uint64_t letters;  /**< Bit per directly indexed parameter letter */
+        uint32_t required; /**< Bit per required parameter */
+        uint8_t params[CPARSER_CONFIG_MAX_NUM_OF_PARAMS];
+        /**< Parameter index of each letter bit, in the bit order */
+    } Cp_Binding_t;
+
+    /**
+     * State of the byte stream which is fed by Cp_FeedBytesEx. Internal to 
+     * the parser.
+     */
+    typedef struct
+    {
+        uint8_t state;                                      /**< Stream state */
+        uint8_t nameLength;                                 /**< Length of the received name */
+        uint32_t nameHash;                                  /**< Running hash of the name */
+        char name[CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH];  /**< Received name */
+        uint16_t position;                                  /**< Registry position of the trigger */
+        Cp_Binding_t binding;                               /**< Parameter binding of the trigger */
+        uint8_t paramIdx;                                   /**< Parameter being decoded */
+        Cp_Accumulator_t accumulator;                       /**< Value decoder */
+        Cp_Command_t command;                               /**< Line decoded so far */
+    } Cp_Stream_t;
+
+    /**
+     * Trigger registry. Every parser has its own one; registries can also be
+     * built apart and published to parsers at run time, see 
+     * cparser_registry.h. Members are internal; initialize with 
+     * Cp_RegistryInit or zero it.
+     */
+    typedef struct
+    {
+        Cp_Trigger_t *triggerTable[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS];
+        /**< Registered triggers */
+        uint8_t triggerNameLengths[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS];
+        /**< Name lengths of the registered triggers */
+        uint16_t triggerIndex[CPARSER_CONFIG_TRIGGER_INDEX_SIZE];
+        /**< Name hash index of the registered triggers */
+        Cp_Binding_t bindings[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS];
+        /**< Parameter bindings of the registered triggers */
+        uint16_t numOfTriggers; /**< Number of registered triggers */
+        uint32_t generation;    /**< Unique value of every modification of the registry */
+    } Cp_Registry_t;
+
+    /**
+     * Registry which is published to the parsers at run time, see 
+     * cparser_registry.h.
+     */
+    typedef struct _Cp_SharedRegistry_t Cp_SharedRegistry_t;
+
+    /**
+     * Parser object. Keeps the trigger registry and the parsing state, so 
+     * independent instances can be used from different threads at the same 
+     * time. Members are internal; initialize with Cp_Init or zero it.
+     */
+    typedef struct
+    {
+        Cp_Registry_t registry;        /**< Own registry */
+        Cp_SharedRegistry_t *shared;   /**< Shared registry which is read instead, if attached */
+        const Cp_Registry_t *active;   /**< Registry pinned by the read lock, NULL for the own one */
+        uint16_t lockDepth;            /**< Nesting depth of the read lock */
+        uint8_t reader;                /**< Reader slot in the shared registry */
+        Cp_Stream_t stream;            /**< Byte stream state */
+        Cp_Queue_t *queue;             /**< Queue of the decoded commands, NULL to dispatch them */
+        Cp_LineCache_t *cache;         /**< Cache of the decoded lines, NULL to parse every line */
+        uint32_t lineNumber;           /**< Expected line number of the next framed line */
+#if CPARSER_CONFIG_STATS
+        Cp_Stats_t stats; /**< Statistics; updated atomically, also while decoding */
+#endif
+    } Cp_Parser_t;
+
     /* Functions ---------------------------------------------------------------*/
     extern void Cp_Reset(void);
-    extern void Cp_Register(Cp_Trigger_t *triggers, uint16_t numOfTriggers);
-    extern uint8_t Cp_FeedLine(char *input, uint16_t length);
+    extern uint16_t Cp_Register(Cp_Trigger_t *triggers, uint16_t numOfTriggers);
+    extern uint8_t Cp_FeedLine(const char *input, uint16_t length);
+    extern Cp_FeedResult_t Cp_FeedBuffer(const char *buffer, size_t length);
+    extern size_t Cp_FeedBytes(const char *data, size_t n);
+    extern Cp_FrameStatus_t Cp_FeedFramedLine(const char *input, uint16_t length);
+    extern Cp_FeedResult_t Cp_FeedCommands(const char *input, uint16_t length,
+                                           Cp_LineStatus_t *statuses, uint8_t maxStatuses);
+    extern Bool_t Cp_GetStats(Cp_Stats_t *stats);
+    extern void Cp_SetQueue(Cp_Queue_t *queue);
+    extern void Cp_SetLineCache(Cp_LineCache_t *cache);
+
+    extern void Cp_Init(Cp_Parser_t *parser);
+    extern void Cp_ResetEx(Cp_Parser_t *parser);
+    extern uint16_t Cp_RegisterEx(Cp_Parser_t *parser, Cp_Trigger_t *triggers,
+                                  uint16_t numOfTriggers);
+    extern uint8_t Cp_FeedLineEx(Cp_Parser_t *parser, const char *input, uint16_t length);
+    extern Cp_FeedResult_t Cp_FeedBufferEx(Cp_Parser_t *parser, const char *buffer, size_t length);
+    extern size_t Cp_FeedBytesEx(Cp_Parser_t *parser, const char *data, size_t n);
+    extern Cp_FrameStatus_t Cp_FeedFramedLineEx(Cp_Parser_t *parser, const char *input,
+                                                uint16_t length);
+    extern Cp_FeedResult_t Cp_FeedCommandsEx(Cp_Parser_t *parser, const char *input,
+                                             uint16_t length, Cp_LineStatus_t *statuses,
+                                             uint8_t maxStatuses);
+    extern void Cp_SetLineNumberEx(Cp_Parser_t *parser, uint32_t lineNumber);
+    extern uint32_t Cp_GetLineNumberEx(const Cp_Parser_t *parser);
+    extern Bool_t Cp_GetStatsEx(const Cp_Parser_t *parser, Cp_Stats_t *stats);
+    extern void Cp_SetQueueEx(Cp_Parser_t *parser, Cp_Queue_t *queue);
+    extern void Cp_SetLineCacheEx(Cp_Parser_t *parser, Cp_LineCache_t *cache);
+
+    extern void Cp_RegistryInit(Cp_Registry_t *registry);
+    extern uint16_t Cp_RegistryAdd(Cp_Registry_t *registry, Cp_Trigger_t *triggers,
+                                   uint16_t numOfTriggers);
+
+    extern Bool_t Cp_DecodeLineEx(const Cp_Parser_t *parser, const char *input, uint16_t length,
+                                  Cp_Command_t *command);
+    extern size_t Cp_DecodeNextLineEx(const Cp_Parser_t *parser, const char *buffer, size_t length,
+                                      Cp_Command_t *command, Cp_LineStatus_t *status);
+    extern void Cp_DispatchCommand(const Cp_Command_t *command);
+    extern void Cp_DispatchCommandEx(const Cp_Parser_t *parser, const Cp_Command_t *command);
 
 #ifdef __cplusplus
 }
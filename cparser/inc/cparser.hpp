@@ -0,0 +1,188 @@
+/**
+ * @file cparser.hpp
+ * 
+ * Header only C++17 interface of the cparser library. Lines are given as 
+ * std::string_view(or ranges of them), so read-only buffers like the 
+ * contents of a std::string, a receive buffer or a memory mapped file are 
+ * parsed in place without being copied.
+ */
+#ifndef __CPARSER_HPP
+#define __CPARSER_HPP
+
+#include "cparser.h"
+#include <cstdint>
+#include <string_view>
+
+namespace cparser
+{
+    /**
+     * @brief Feeds a line to the parser.
+     * 
+     * @param parser: Parser object.
+     * @param line: Line without the terminator.
+     * 
+     * @retval Whether the line is accepted; lines longer than UINT16_MAX are
+     * rejected.
+     */
+    inline bool feedLine(Cp_Parser_t &parser, std::string_view line)
+    {
+        if (line.size() > UINT16_MAX)
+        {
+            return false;
+        }
+
+        return Cp_FeedLineEx(&parser, line.data(), (uint16_t)line.size()) == TRUE;
+    }
+
+    /**
+     * @brief Feeds a range of lines(e.g. a std::vector or an array of 
+     * std::string_view) to the parser. Lines without fields(empty or only 
+     * spaces and carriage returns) are skipped without being counted, like 
+     * Cp_FeedBufferEx does.
+     * 
+     * @param parser: Parser object.
+     * @param lines: Range of the lines; elements should be convertible to 
+     * std::string_view.
+     * 
+     * @retval Numbers of the accepted and rejected lines.
+     */
+    template <typename Lines>
+    inline Cp_FeedResult_t feedLines(Cp_Parser_t &parser, const Lines &lines)
+    {
+        Cp_FeedResult_t result = {0, 0};
+
+        for (const auto &element : lines)
+        {
+            std::string_view line(element);
+
+            if (line.find_first_not_of(" \r") == std::string_view::npos)
+            {
+                continue;
+            }
+
+            if (feedLine(parser, line))
+            {
+                result.accepted++;
+            }
+            else
+            {
+                result.rejected++;
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Feeds a buffer of new line separated lines to the parser.
+     * 
+     * @param parser: Parser object.
+     * @param buffer: Buffer of lines.
+     * 
+     * @retval Numbers of the accepted and rejected lines.
+     */
+    inline Cp_FeedResult_t feedBuffer(Cp_Parser_t &parser, std::string_view buffer)
+    {
+        return Cp_FeedBufferEx(&parser, buffer.data(), buffer.size());
+    }
+
+    /**
+     * @brief Feeds a piece of a byte stream to the parser.
+     * 
+     * @param parser: Parser object.
+     * @param bytes: Received bytes.
+     * 
+     * @retval Number of lines dispatched during the call.
+     */
+    inline size_t feedBytes(Cp_Parser_t &parser, std::string_view bytes)
+    {
+        return Cp_FeedBytesEx(&parser, bytes.data(), bytes.size());
+    }
+
+    /**
+     * @brief Decodes a line without invoking its callback.
+     * 
+     * @param parser: Parser object.
+     * @param line: Line without the terminator.
+     * @param command: Decoded command.
+     * 
+     * @retval Whether the line is decoded.
+     */
+    inline bool decodeLine(const Cp_Parser_t &parser, std::string_view line, Cp_Command_t &command)
+    {
+        if (line.size() > UINT16_MAX)
+        {
+            return false;
+        }
+
+        return Cp_DecodeLineEx(&parser, line.data(), (uint16_t)line.size(), &command) == TRUE;
+    }
+
+    /**
+     * Parser instance. Owns a Cp_Parser_t; the C functions can be used with
+     * the object returned by get().
+     */
+    class Parser
+    {
+    public:
+        Parser() { Cp_Init(&parser_); }
+        Parser(const Parser &) = delete;
+        Parser &operator=(const Parser &) = delete;
+
+        /**
+         * @brief Registers triggers.
+         * 
+         * @param triggers: Trigger array; should stay valid while it is 
+         * registered.
+         * @param numOfTriggers: Number of the triggers.
+         * 
+         * @retval Number of the registered triggers, see Cp_RegistryAdd.
+         */
+        uint16_t add(Cp_Trigger_t *triggers, uint16_t numOfTriggers)
+        {
+            return Cp_RegisterEx(&parser_, triggers, numOfTriggers);
+        }
+
+        /**
+         * @brief Registers an array of triggers.
+         */
+        template <size_t N>
+        uint16_t add(Cp_Trigger_t (&triggers)[N])
+        {
+            return add(triggers, (uint16_t)N);
+        }
+
+        /**
+         * @brief Clears the registry and the stream state.
+         */
+        void reset() { Cp_ResetEx(&parser_); }
+
+        bool feedLine(std::string_view line) { return cparser::feedLine(parser_, line); }
+
+        template <typename Lines>
+        Cp_FeedResult_t feedLines(const Lines &lines)
+        {
+            return cparser::feedLines(parser_, lines);
+        }
+
+        Cp_FeedResult_t feedBuffer(std::string_view buffer)
+        {
+            return cparser::feedBuffer(parser_, buffer);
+        }
+
+        size_t feedBytes(std::string_view bytes) { return cparser::feedBytes(parser_, bytes); }
+
+        bool decodeLine(std::string_view line, Cp_Command_t &command) const
+        {
+            return cparser::decodeLine(parser_, line, command);
+        }
+
+        Cp_Parser_t &get() { return parser_; }
+        const Cp_Parser_t &get() const { return parser_; }
+
+    private:
+        Cp_Parser_t parser_;
+    };
+}
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @file cparser_binary.h
+ * 
+ * Compact binary encoding of the commands, for the links where the text 
+ * syntax costs too much. A frame is;
+ * 
+ * | length | trigger id   | presence                    | values           |
+ * | 1 byte | 2 bytes      | CP_BINARY_PRESENCE_SIZE     | in param order   |
+ * 
+ * Length counts the bytes after itself. Trigger id is the registry position
+ * of the trigger, so both sides should register the same triggers in the 
+ * same order. Presence has a bit per given parameter. Letters take a byte, 
+ * integers and reals are int32 and float in 4 bytes. Multi byte fields are 
+ * little endian.
+ */
+#ifndef __CPARSER_BINARY_H
+#define __CPARSER_BINARY_H
+
+#include "cparser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Constants ---------------------------------------------------------------*/
+    /** Size of the parameter presence field of a frame. */
+#define CP_BINARY_PRESENCE_SIZE ((CPARSER_CONFIG_MAX_NUM_OF_PARAMS + 7) / 8)
+
+    /** Maximum size of a frame including the length byte. */
+#define CP_BINARY_MAX_FRAME_SIZE \
+    (1 + 2 + CP_BINARY_PRESENCE_SIZE + 4 * CPARSER_CONFIG_MAX_NUM_OF_PARAMS)
+
+    /* Functions ---------------------------------------------------------------*/
+    extern size_t Cp_EncodeCommand(const Cp_Command_t *command, uint8_t *output, size_t size);
+    extern size_t Cp_TranscodeLineEx(const Cp_Parser_t *parser, const char *input, uint16_t length,
+                                     uint8_t *output, size_t size);
+    extern size_t Cp_DecodeFrameEx(const Cp_Parser_t *parser, const uint8_t *frame, size_t length,
+                                   Cp_Command_t *command, Cp_LineStatus_t *status);
+    extern Cp_FeedResult_t Cp_FeedFramesEx(Cp_Parser_t *parser, const uint8_t *buffer, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
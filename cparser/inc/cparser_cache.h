@@ -0,0 +1,59 @@
+/**
+ * @file cparser_cache.h
+ * 
+ * Cache of the decoded lines. Lines which repeat byte for byte(e.g. status 
+ * polls) are found by a hash of their bytes and dispatched from the stored 
+ * command, without tokenizing, looking up the trigger and parsing the 
+ * values again. Entries are tagged with the registry and its generation, so
+ * they are invalidated by any change of the registry. Generations aren't 
+ * reused, also by a registry which takes the memory of a freed one.
+ */
+#ifndef __CPARSER_CACHE_H
+#define __CPARSER_CACHE_H
+
+#include "cparser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Typedefs ----------------------------------------------------------------*/
+    /**
+     * Cached line.
+     */
+    typedef struct
+    {
+        const Cp_Registry_t *registry;                     /**< Registry which decoded the line */
+        uint32_t generation;                               /**< Generation of the registry */
+        uint32_t hash;                                     /**< Hash of the line bytes */
+        uint8_t length;                                    /**< Length of the line */
+        char line[CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH];   /**< Bytes of the line */
+        Cp_Command_t command;                              /**< Decoded line */
+    } Cp_LineCacheEntry_t;
+
+    /**
+     * Line cache object; direct mapped by the line hash. Members are 
+     * internal; initialize with Cp_LineCacheInit. A cache serves a single
+     * parser.
+     */
+    struct _Cp_LineCache_t
+    {
+        Cp_LineCacheEntry_t entries[CPARSER_CONFIG_LINE_CACHE_SIZE]; /**< Cached lines */
+        size_t hits;                                                 /**< Lines found */
+        size_t misses;                                               /**< Lines parsed */
+    };
+
+    /* Functions ---------------------------------------------------------------*/
+    extern void Cp_LineCacheInit(Cp_LineCache_t *cache);
+    extern Bool_t Cp_LineCacheFind(Cp_LineCache_t *cache, const Cp_Registry_t *registry,
+                                   const char *line, size_t length, Cp_Command_t *command);
+    extern void Cp_LineCacheStore(Cp_LineCache_t *cache, const Cp_Registry_t *registry,
+                                  const char *line, size_t length, const Cp_Command_t *command);
+    extern size_t Cp_LineCacheGetHits(const Cp_LineCache_t *cache);
+    extern size_t Cp_LineCacheGetMisses(const Cp_LineCache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
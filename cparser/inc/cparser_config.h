@@ -7,13 +7,109 @@
 #ifndef __CPARSER_CONFIG_H
 #define __CPARSER_CONFIG_H
 
+/* Every constant can be overridden from the build system(e.g. -D flags). */
+
 /** Maximum number of parameters which a trigger can have. */
+#ifndef CPARSER_CONFIG_MAX_NUM_OF_PARAMS
 #define CPARSER_CONFIG_MAX_NUM_OF_PARAMS 5
+#endif
 
 /** Maximum number of triggers which can be registered. */
+#ifndef CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS
 #define CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS 25
+#endif
 
 /** Maximum trigger name length(except null terminator) */
+#ifndef CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH
 #define CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH 10
+#endif
+
+/** Maximum size of the output struct of a typed trigger(in bytes). */
+#ifndef CPARSER_CONFIG_MAX_OUTPUT_SIZE
+#define CPARSER_CONFIG_MAX_OUTPUT_SIZE 64
+#endif
+
+/** Number of slots in the trigger name hash index. Should be bigger than
+the maximum number of triggers, twice of it keeps the probe sequences short. */
+#ifndef CPARSER_CONFIG_TRIGGER_INDEX_SIZE
+#define CPARSER_CONFIG_TRIGGER_INDEX_SIZE (2 * CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS)
+#endif
+
+// A full index has no empty slot to end the probe sequence of an unknown name.
+#if CPARSER_CONFIG_TRIGGER_INDEX_SIZE <= CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS
+#error "CPARSER_CONFIG_TRIGGER_INDEX_SIZE should be bigger than CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS"
+#endif
+
+/** Enables SSE2/AVX2 field tokenizers on x86 targets(1 or 0). */
+#ifndef CPARSER_CONFIG_TOKENIZER_SIMD
+#define CPARSER_CONFIG_TOKENIZER_SIMD 1
+#endif
+
+/** Nominal size of the chunks which are parsed in parallel(in bytes). */
+#ifndef CPARSER_CONFIG_PARALLEL_CHUNK_SIZE
+#define CPARSER_CONFIG_PARALLEL_CHUNK_SIZE (64 * 1024)
+#endif
+
+/** Size of the cache lines which the command queue aligns its indexes to(in 
+bytes). Small targets without a cache can set it to zero. */
+#ifndef CPARSER_CONFIG_CACHE_LINE_SIZE
+#define CPARSER_CONFIG_CACHE_LINE_SIZE 64
+#endif
+
+/** Maximum number of parsers which can read a shared registry. */
+#ifndef CPARSER_CONFIG_MAX_NUM_OF_READERS
+#define CPARSER_CONFIG_MAX_NUM_OF_READERS 8
+#endif
+
+/** Maximum number of replaced registries which are waiting to be reclaimed. */
+#ifndef CPARSER_CONFIG_MAX_NUM_OF_RETIRED
+#define CPARSER_CONFIG_MAX_NUM_OF_RETIRED 4
+#endif
+
+/** Enables the real(float) parameters(1 or 0). Targets without an FPU can
+disable them, so no float code is compiled in; fixed point parameters don't 
+need them. */
+#ifndef CPARSER_CONFIG_REAL
+#define CPARSER_CONFIG_REAL 1
+#endif
+
+/** Number of fraction bits of the fixed point parameters(Q format), between
+0 and 30. */
+#ifndef CPARSER_CONFIG_FIXED_FRACTION_BITS
+#define CPARSER_CONFIG_FIXED_FRACTION_BITS 16
+#endif
+
+/** Number of entries of a line cache; should be a power of two. */
+#ifndef CPARSER_CONFIG_LINE_CACHE_SIZE
+#define CPARSER_CONFIG_LINE_CACHE_SIZE 16
+#endif
+
+/** Maximum length of the lines which are kept in a line cache; longer ones 
+are always parsed. */
+#ifndef CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH
+#define CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH 32
+#endif
+
+/** Enables the runtime statistics of the parsers(1 or 0). When disabled the
+counters and the timestamps are compiled out. */
+#ifndef CPARSER_CONFIG_STATS
+#define CPARSER_CONFIG_STATS 0
+#endif
+
+/** Enables the trace points around the parsing stages(1 or 0), see 
+cparser_trace.h. When disabled they are compiled out. */
+#ifndef CPARSER_CONFIG_TRACE
+#define CPARSER_CONFIG_TRACE 0
+#endif
+
+/** Number of records of a trace buffer; should be a power of two. */
+#ifndef CPARSER_CONFIG_TRACE_BUFFER_SIZE
+#define CPARSER_CONFIG_TRACE_BUFFER_SIZE 1024
+#endif
+
+/* CPARSER_CONFIG_STATS_CLOCK() can be defined as an expression which gives a 
+free running timestamp(e.g. a cycle counter) for the latency histograms and
+the trace records. If it isn't defined, time stamp counter is used on x86 
+targets. */
 
 #endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+/**
+ * @file cparser_format.h
+ * 
+ * Response formatter; the inverse of the line parser. Writes a trigger name
+ * and its parameters in the "name L<value> ..." syntax, so the output is 
+ * accepted by Cp_FeedLine of the other side.
+ */
+#ifndef __CPARSER_FORMAT_H
+#define __CPARSER_FORMAT_H
+
+#include "cparser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Functions ---------------------------------------------------------------*/
+    extern size_t Cp_Format(const char *name, const Dictionary_t *dictionary, char *output,
+                            size_t size);
+    extern size_t Cp_FormatTyped(const Cp_Trigger_t *trigger, const void *input, uint32_t present,
+                                 char *output, size_t size);
+    extern size_t Cp_FormatCommand(const Cp_Command_t *command, char *output, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,213 @@
+/**
+ * @file cparser_internal.h
+ * 
+ * Internals which are shared by the modules of the library; registry 
+ * access, dispatching and the statistics counters. Not a part of the 
+ * interface.
+ */
+#ifndef __CPARSER_INTERNAL_H
+#define __CPARSER_INTERNAL_H
+
+#include "cparser.h"
+#include "cparser_queue.h"
+#include "cparser_registry.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Statistics. Counters are updated with relaxed atomics since a parser can
+    be decoding on several threads at the same time; when disabled the macros 
+    expand to nothing. */
+#if CPARSER_CONFIG_STATS
+#if defined(CPARSER_CONFIG_STATS_CLOCK)
+#define STATS_CLOCK() ((uint64_t)(CPARSER_CONFIG_STATS_CLOCK()))
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATS_CLOCK() ((uint64_t)__builtin_ia32_rdtsc())
+#else
+#define STATS_CLOCK() ((uint64_t)0)
+#endif
+
+#if defined(__GNUC__)
+#define STATS_INCREMENT(counter) __atomic_fetch_add(&(counter), 1, __ATOMIC_RELAXED)
+#define STATS_DECREMENT(counter) __atomic_fetch_sub(&(counter), 1, __ATOMIC_RELAXED)
+#define STATS_LOAD(counter) __atomic_load_n(&(counter), __ATOMIC_RELAXED)
+#else
+#define STATS_INCREMENT(counter) ((counter)++)
+#define STATS_DECREMENT(counter) ((counter)--)
+#define STATS_LOAD(counter) (counter)
+#endif
+
+#define STATS_START(start) uint64_t start = STATS_CLOCK()
+#define STATS_ACCEPT(parser, position) countAccept(parser, position)
+#define STATS_REJECT(parser, reason) countReject(parser, reason)
+#define STATS_DROP(parser, position) countDrop(parser, position)
+#define STATS_PARSE_TIME(parser, start) recordTime(getStats(parser)->parseTime, start)
+#define STATS_CALLBACK_TIME(parser, start) recordTime(getStats(parser)->callbackTime, start)
+#else
+#define STATS_START(start)
+#define STATS_ACCEPT(parser, position)
+#define STATS_REJECT(parser, reason)
+#define STATS_DROP(parser, position)
+#define STATS_PARSE_TIME(parser, start)
+#define STATS_CALLBACK_TIME(parser, start)
+#endif
+
+    /* Functions ---------------------------------------------------------------*/
+    /**
+     * @brief Gets the registry which the parser decodes with; the shared 
+     * registry pinned by the read lock or the own registry.
+     * 
+     * @param parser: Pointer to the parser.
+     * 
+     * @retval Pointer to the registry.
+     */
+    static inline const Cp_Registry_t *getRegistry(const Cp_Parser_t *parser)
+    {
+        return parser->active ? parser->active : &parser->registry;
+    }
+
+    /**
+     * @brief Takes the read lock of the shared registry, if one is attached.
+     * 
+     * @param parser: Pointer to the parser.
+     */
+    static inline void lockRegistry(Cp_Parser_t *parser)
+    {
+        if (parser->shared)
+        {
+            Cp_ReadLockEx(parser);
+        }
+    }
+
+    /**
+     * @brief Releases the read lock of the shared registry, if one is 
+     * attached.
+     * 
+     * @param parser: Pointer to the parser.
+     */
+    static inline void unlockRegistry(Cp_Parser_t *parser)
+    {
+        if (parser->shared)
+        {
+            Cp_ReadUnlockEx(parser);
+        }
+    }
+
+#if CPARSER_CONFIG_STATS
+    /**
+     * @brief Gets the statistics of a parser for updating. Counters are 
+     * updated atomically, so they can be written through a parser which is 
+     * only read.
+     * 
+     * @param parser: Pointer to the parser.
+     * 
+     * @retval Pointer to the statistics.
+     */
+    static inline Cp_Stats_t *getStats(const Cp_Parser_t *parser)
+    {
+        return (Cp_Stats_t *)&parser->stats;
+    }
+
+    /**
+     * @brief Counts an accepted line.
+     * 
+     * @param parser: Pointer to the parser.
+     * @param position: Position of the trigger in the trigger table.
+     */
+    static inline void countAccept(const Cp_Parser_t *parser, uint16_t position)
+    {
+        Cp_Stats_t *stats = getStats(parser);
+
+        STATS_INCREMENT(stats->accepted);
+        STATS_INCREMENT(stats->hits[position]);
+    }
+
+    /**
+     * @brief Counts a rejected line.
+     * 
+     * @param parser: Pointer to the parser.
+     * @param reason: Reason of the rejection.
+     */
+    static inline void countReject(const Cp_Parser_t *parser, Cp_RejectReason_t reason)
+    {
+        STATS_INCREMENT(getStats(parser)->rejected[reason]);
+    }
+
+    /**
+     * @brief Counts a command which is dropped by the full queue as rejected.
+     * Its line has already been counted as accepted when it was decoded.
+     * 
+     * @param parser: Pointer to the parser.
+     * @param position: Position of the trigger in the trigger table.
+     */
+    static inline void countDrop(const Cp_Parser_t *parser, uint16_t position)
+    {
+        Cp_Stats_t *stats = getStats(parser);
+
+        STATS_DECREMENT(stats->accepted);
+        STATS_DECREMENT(stats->hits[position]);
+        STATS_INCREMENT(stats->rejected[CP_REJECT_REASON_DROPPED]);
+    }
+
+    /**
+     * @brief Adds the time passed since a timestamp to a log2 histogram.
+     * 
+     * @param histogram: Pointer to the histogram buckets.
+     * @param start: Timestamp of the start.
+     */
+    static inline void recordTime(size_t *histogram, uint64_t start)
+    {
+        uint64_t duration = STATS_CLOCK() - start;
+        uint8_t bucket;
+
+        // Bucket is the number of bits which the duration needs.
+#if defined(__GNUC__)
+        bucket = duration ? (uint8_t)(64 - __builtin_clzll(duration)) : 0;
+#else
+        for (bucket = 0; duration; bucket++)
+        {
+            duration >>= 1;
+        }
+#endif
+
+        if (bucket >= CP_STATS_HISTOGRAM_SIZE)
+        {
+            bucket = CP_STATS_HISTOGRAM_SIZE - 1;
+        }
+
+        STATS_INCREMENT(histogram[bucket]);
+    }
+#endif
+
+    /**
+     * @brief Dispatches a decoded command, or puts it into the queue of the 
+     * parser if one is attached.
+     * 
+     * @param parser: Pointer to the parser.
+     * @param command: Pointer to the command.
+     * 
+     * @retval FALSE if the queue is full, TRUE otherwise.
+     */
+    static inline Bool_t dispatch(Cp_Parser_t *parser, const Cp_Command_t *command)
+    {
+        if (parser->queue)
+        {
+            if (Cp_QueuePush(parser->queue, command))
+            {
+                return TRUE;
+            }
+
+            STATS_DROP(parser, command->position);
+            return FALSE;
+        }
+
+        Cp_DispatchCommandEx(parser, command);
+        return TRUE;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
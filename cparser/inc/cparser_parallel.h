@@ -0,0 +1,44 @@
+/**
+ * @file cparser_parallel.h
+ * 
+ * Parallel batch parsing of big buffers of trigger lines(e.g. command logs).
+ * Buffer is split into chunks at line boundaries, chunks are decoded by a
+ * pool of threads and callbacks are invoked either in the original line
+ * order or as soon as the lines are decoded. Commands are always dispatched
+ * by the feeding threads; a queue or a line cache attached to the parser is
+ * bypassed. Needs POSIX threads and C11 atomics, so it is built as a 
+ * separate module.
+ */
+#ifndef __CPARSER_PARALLEL_H
+#define __CPARSER_PARALLEL_H
+
+#include "cparser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Typedefs ----------------------------------------------------------------*/
+    /**
+     * Parallel parsing options. A zero initialized structure selects the
+     * defaults.
+     */
+    typedef struct
+    {
+        uint16_t numOfThreads; /**< Number of threads including the caller, 0 for
+                               the number of online processors */
+        size_t chunkSize;      /**< Nominal chunk size in bytes, 0 for
+                               CPARSER_CONFIG_PARALLEL_CHUNK_SIZE */
+        Bool_t unordered;      /**< Callbacks can be invoked in any order and
+                               concurrently from different threads */
+    } Cp_ParallelConfig_t;
+
+    /* Functions ---------------------------------------------------------------*/
+    extern Cp_FeedResult_t Cp_FeedBufferParallel(const Cp_Parser_t *parser, const char *buffer,
+                                                 size_t length, const Cp_ParallelConfig_t *config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
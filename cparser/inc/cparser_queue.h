@@ -0,0 +1,59 @@
+/**
+ * @file cparser_queue.h
+ * 
+ * Lock-free single producer/single consumer queue of decoded commands. A 
+ * parser which has a queue attached puts the commands of the fed lines into
+ * the queue instead of invoking the callbacks; another thread(or the main 
+ * loop, when the lines are fed from an interrupt) dispatches them later. So
+ * feeding a line takes bounded time however long the callbacks take.
+ */
+#ifndef __CPARSER_QUEUE_H
+#define __CPARSER_QUEUE_H
+
+#include "cparser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Constants ---------------------------------------------------------------*/
+    /** Size of the padding which keeps count indexes on separate cache lines. */
+#define CP_QUEUE_PADDING_SIZE(n)                                           \
+    ((CPARSER_CONFIG_CACHE_LINE_SIZE > (n) * sizeof(size_t))               \
+         ? (CPARSER_CONFIG_CACHE_LINE_SIZE - (n) * sizeof(size_t))         \
+         : 1)
+
+    /* Typedefs ----------------------------------------------------------------*/
+    /**
+     * Queue object. Members are internal; initialize with Cp_QueueInit. 
+     * Indexes of the producer and the consumer are kept on different cache
+     * lines, each side also keeps a copy of the other one's index to touch 
+     * the shared line only when the queue looks full or empty.
+     */
+    struct _Cp_Queue_t
+    {
+        Cp_Command_t *commands; /**< Storage of the commands */
+        size_t mask;            /**< Capacity minus one */
+        uint8_t padding0[CP_QUEUE_PADDING_SIZE(2)];
+        size_t head;       /**< Count of the commands put, written by the producer */
+        size_t cachedTail; /**< Copy of the tail, used by the producer */
+        size_t dropped;    /**< Commands dropped since the queue was full */
+        uint8_t padding1[CP_QUEUE_PADDING_SIZE(3)];
+        size_t tail;               /**< Count of the commands taken, written by the consumer */
+        size_t cachedHead;         /**< Copy of the head, used by the consumer */
+        const Cp_Parser_t *parser; /**< Parser which the queue is attached to, can be NULL */
+        uint8_t padding2[CP_QUEUE_PADDING_SIZE(3)];
+    };
+
+    /* Functions ---------------------------------------------------------------*/
+    extern Bool_t Cp_QueueInit(Cp_Queue_t *queue, Cp_Command_t *storage, size_t capacity);
+    extern Bool_t Cp_QueuePush(Cp_Queue_t *queue, const Cp_Command_t *command);
+    extern Bool_t Cp_QueuePop(Cp_Queue_t *queue, Cp_Command_t *command);
+    extern size_t Cp_QueueDispatch(Cp_Queue_t *queue, size_t maxCommands);
+    extern size_t Cp_QueueGetDropped(const Cp_Queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file cparser_registry.h
+ * 
+ * Registries which are replaced at run time. A registry is built apart 
+ * (Cp_RegistryInit, Cp_RegistryAdd) and published; parsers which are 
+ * attached to the shared registry start decoding with it atomically, 
+ * without being stopped or blocked. A replaced registry is reclaimed when no
+ * parser can be reading it anymore, which is tracked by epochs.
+ */
+#ifndef __CPARSER_REGISTRY_H
+#define __CPARSER_REGISTRY_H
+
+#include "cparser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Constants ---------------------------------------------------------------*/
+    /** Size of the padding which keeps each reader epoch on its own cache line. */
+#define CP_REGISTRY_PADDING_SIZE                                           \
+    ((CPARSER_CONFIG_CACHE_LINE_SIZE > sizeof(size_t))                     \
+         ? (CPARSER_CONFIG_CACHE_LINE_SIZE - sizeof(size_t))               \
+         : 1)
+
+    /* Typedefs ----------------------------------------------------------------*/
+    /**
+     * Reader slot of an attached parser. Internal to the shared registry.
+     */
+    typedef struct
+    {
+        size_t epoch; /**< Epoch at which the read lock is taken, zero if not locked */
+        uint8_t padding[CP_REGISTRY_PADDING_SIZE];
+    } Cp_ReaderSlot_t;
+
+    /**
+     * Shared registry object. Members are internal; initialize with 
+     * Cp_SharedRegistryInit.
+     */
+    struct _Cp_SharedRegistry_t
+    {
+        const Cp_Registry_t *current; /**< Published registry */
+        size_t epoch;                 /**< Global epoch, incremented by each publication */
+        const Cp_Registry_t *retired[CPARSER_CONFIG_MAX_NUM_OF_RETIRED];
+        /**< Replaced registries, the oldest first */
+        size_t retiredEpochs[CPARSER_CONFIG_MAX_NUM_OF_RETIRED];
+        /**< Epochs at which the registries are replaced */
+        uint8_t numOfRetired; /**< Number of the replaced registries */
+        uint8_t attached[CPARSER_CONFIG_MAX_NUM_OF_READERS];
+        /**< Whether each reader slot is in use */
+        Cp_ReaderSlot_t readers[CPARSER_CONFIG_MAX_NUM_OF_READERS];
+        /**< Reader slots */
+    };
+
+    /* Functions ---------------------------------------------------------------*/
+    extern void Cp_SharedRegistryInit(Cp_SharedRegistry_t *shared, const Cp_Registry_t *registry);
+    extern Bool_t Cp_SharedRegistryPublish(Cp_SharedRegistry_t *shared, const Cp_Registry_t *registry);
+    extern const Cp_Registry_t *Cp_SharedRegistryReclaim(Cp_SharedRegistry_t *shared);
+
+    extern Bool_t Cp_AttachRegistryEx(Cp_Parser_t *parser, Cp_SharedRegistry_t *shared);
+    extern void Cp_DetachRegistryEx(Cp_Parser_t *parser);
+    extern void Cp_ReadLockEx(Cp_Parser_t *parser);
+    extern void Cp_ReadUnlockEx(Cp_Parser_t *parser);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,516 @@
+/**
+ * @file cparser_static.hpp
+ * 
+ * Header only C++17 front-end for the trigger tables which are known at
+ * compile time. Table is declared constexpr and checked by the compiler;
+ * duplicate names, duplicate letters and too many parameters are compile
+ * errors. Name dispatch and the parameter decoders are instantiated from the
+ * table, so there is no registry to walk nor a type switch per value, and
+ * the path from the line to the callback can be inlined as a whole. Lines of
+ * the triggers which aren't in the table can be passed to a runtime parser.
+ */
+#ifndef __CPARSER_STATIC_HPP
+#define __CPARSER_STATIC_HPP
+
+#include "cparser.h"
+#include "dictionary.h"
+#include "number.h"
+#include "tokenizer.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace cparser
+{
+    /**
+     * Parameter of a static trigger.
+     */
+    struct Param
+    {
+        char letter = 0;                           /**< Letter of the parameter */
+        Cp_ParamType_t type = CP_PARAM_TYPE_LETTER; /**< Type of the parameter */
+        bool required = false;                     /**< Lines without it are rejected */
+    };
+
+    /**
+     * Static trigger; created with cparser::trigger().
+     */
+    struct Trigger
+    {
+        std::string_view name;                             /**< Trigger name */
+        Cp_ParsedCallback_t callback = nullptr;            /**< Parsed callback */
+        Param params[CPARSER_CONFIG_MAX_NUM_OF_PARAMS] = {}; /**< Parameters */
+        size_t numOfParams = 0;                            /**< Number of given parameters */
+    };
+
+    /**
+     * @brief Creates a parameter.
+     * 
+     * @param letter: Letter of the parameter.
+     * @param type: Type of the parameter.
+     * @param required: Whether the lines without the parameter are rejected.
+     * 
+     * @retval Parameter.
+     */
+    constexpr Param param(char letter, Cp_ParamType_t type, bool required = false)
+    {
+        return Param{letter, type, required};
+    }
+
+    /**
+     * @brief Creates a trigger. Parameters which don't fit into a trigger are
+     * counted, so they are reported by the parser which checks the table.
+     * 
+     * @param name: Trigger name.
+     * @param callback: Parsed callback.
+     * @param params: Parameters, created with cparser::param().
+     * 
+     * @retval Trigger.
+     */
+    template <typename... Params>
+    constexpr Trigger trigger(std::string_view name, Cp_ParsedCallback_t callback,
+                              Params... params)
+    {
+        static_assert((std::is_same_v<Params, Param> && ...),
+                      "Parameters should be created with cparser::param()");
+
+        const Param list[] = {params..., Param{}};
+        Trigger trigger;
+
+        trigger.name = name;
+        trigger.callback = callback;
+        trigger.numOfParams = sizeof...(Params);
+        for (size_t i = 0; i < sizeof...(Params) && i < CPARSER_CONFIG_MAX_NUM_OF_PARAMS; i++)
+        {
+            trigger.params[i] = list[i];
+        }
+
+        return trigger;
+    }
+
+    namespace detail
+    {
+        /**
+         * Storage of a decoded value of any type.
+         */
+        union Value
+        {
+            char letter;
+            int32_t integer;
+#if CPARSER_CONFIG_REAL
+            float real;
+#endif
+        };
+
+        /**
+         * @brief Parses the value of a parameter; instantiated per type.
+         */
+        template <Cp_ParamType_t Type>
+        inline bool parseValue(const char *input, uint8_t length, Value &value)
+        {
+            if constexpr (Type == CP_PARAM_TYPE_LETTER)
+            {
+                if (length != 1)
+                {
+                    return false;
+                }
+
+                value.letter = input[0];
+                return true;
+            }
+            else if constexpr (Type == CP_PARAM_TYPE_INTEGER)
+            {
+                return Number_ParseInteger(input, length, &value.integer) == TRUE;
+            }
+#if CPARSER_CONFIG_REAL
+            else if constexpr (Type == CP_PARAM_TYPE_REAL)
+            {
+                return Number_ParseFloat(input, length, &value.real) == TRUE;
+            }
+#endif
+            else
+            {
+                return Number_ParseFixed(input, length, &value.integer) == TRUE;
+            }
+        }
+
+        /**
+         * @brief Checks if the type is one of the parameter types which are
+         * compiled in.
+         */
+        constexpr bool isTypeValid(Cp_ParamType_t type)
+        {
+            return type == CP_PARAM_TYPE_LETTER || type == CP_PARAM_TYPE_INTEGER ||
+                   (CPARSER_CONFIG_REAL && type == CP_PARAM_TYPE_REAL) ||
+                   type == CP_PARAM_TYPE_FIXED;
+        }
+
+        template <size_t N>
+        constexpr bool areNamesValid(const Trigger (&triggers)[N])
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                const std::string_view &name = triggers[i].name;
+
+                if (name.empty() || name.size() > CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH ||
+                    name.find_first_of(" \r\n") != std::string_view::npos)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool areNamesUnique(const Trigger (&triggers)[N])
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                for (size_t j = i + 1; j < N; j++)
+                {
+                    if (triggers[i].name == triggers[j].name)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool doParamsFit(const Trigger (&triggers)[N])
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                if (triggers[i].numOfParams > CPARSER_CONFIG_MAX_NUM_OF_PARAMS)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool areLettersUnique(const Trigger (&triggers)[N])
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                // Counts are checked to fit by doParamsFit.
+                size_t count = triggers[i].numOfParams;
+
+                count = (count > CPARSER_CONFIG_MAX_NUM_OF_PARAMS) ? 0 : count;
+                for (size_t j = 0; j < count; j++)
+                {
+                    for (size_t k = j + 1; k < count; k++)
+                    {
+                        if (triggers[i].params[j].letter == triggers[i].params[k].letter)
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool areParamsValid(const Trigger (&triggers)[N])
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                size_t count = triggers[i].numOfParams;
+
+                count = (count > CPARSER_CONFIG_MAX_NUM_OF_PARAMS) ? 0 : count;
+                for (size_t j = 0; j < count; j++)
+                {
+                    if (!isTypeValid(triggers[i].params[j].type))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool areCallbacksGiven(const Trigger (&triggers)[N])
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                if (triggers[i].callback == nullptr)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    /**
+     * Parser of a constexpr trigger table, e.g.
+     * 
+     *     constexpr cparser::Trigger Triggers[] = {
+     *         cparser::trigger("move", onMove, cparser::param('D', CP_PARAM_TYPE_REAL)),
+     *     };
+     *     cparser::StaticParser<Triggers> parser;
+     * 
+     * Lines are accepted and rejected like Cp_FeedLineEx does with the same
+     * triggers registered. A line of an unknown trigger is passed to the
+     * fallback parser, if one is set.
+     */
+    template <const auto &Triggers>
+    class StaticParser
+    {
+        using Table = std::remove_reference_t<decltype(Triggers)>;
+        static constexpr size_t NumOfTriggers = std::extent_v<Table>;
+
+        static_assert(std::is_same_v<std::remove_cv_t<std::remove_extent_t<Table>>, Trigger>,
+                      "Trigger table should be an array of cparser::Trigger");
+        static_assert(detail::areNamesValid(Triggers),
+                      "Trigger names should be 1 to CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH "
+                      "characters long, without separators");
+        static_assert(detail::areNamesUnique(Triggers), "Trigger names should be unique");
+        static_assert(detail::doParamsFit(Triggers),
+                      "A trigger has more than CPARSER_CONFIG_MAX_NUM_OF_PARAMS parameters");
+        static_assert(detail::areLettersUnique(Triggers),
+                      "Parameter letters of a trigger should be unique");
+        static_assert(detail::areParamsValid(Triggers),
+                      "Parameter type isn't valid or isn't compiled in");
+        static_assert(detail::areCallbacksGiven(Triggers), "Every trigger should have a callback");
+
+    public:
+        StaticParser() = default;
+        explicit StaticParser(Cp_Parser_t &fallback) : fallback_(&fallback) {}
+
+        /**
+         * @brief Sets the parser of the lines whose triggers aren't in the
+         * table; nullptr rejects them.
+         */
+        void setFallback(Cp_Parser_t *fallback) { fallback_ = fallback; }
+
+        /**
+         * @brief Feeds a line.
+         * 
+         * @param line: Line without the terminator.
+         * 
+         * @retval Whether the line is accepted; lines longer than UINT16_MAX
+         * are rejected.
+         */
+        bool feedLine(std::string_view line) const
+        {
+            Field_t fields[MaxFieldCount];
+            uint8_t field_count;
+
+            if (line.size() > UINT16_MAX)
+            {
+                return false;
+            }
+
+            Tokenizer_ParseFields(line.data(), (uint16_t)line.size(), fields, MaxFieldCount,
+                                  &field_count);
+            return decodeFields(line.data(), (uint16_t)line.size(), fields, field_count);
+        }
+
+        /**
+         * @brief Feeds a buffer of new line separated lines, like
+         * Cp_FeedBufferEx does.
+         * 
+         * @param buffer: Buffer of lines.
+         * 
+         * @retval Numbers of the accepted and rejected lines.
+         */
+        Cp_FeedResult_t feedBuffer(std::string_view buffer) const
+        {
+            Cp_FeedResult_t result = {0, 0};
+            Field_t fields[MaxFieldCount];
+            size_t offset = 0;
+
+            while (offset < buffer.size())
+            {
+                const char *line = &buffer[offset];
+                uint8_t field_count;
+                size_t line_length;
+
+                offset += Tokenizer_ParseNextLine(line, buffer.size() - offset, fields,
+                                                  MaxFieldCount, &field_count, &line_length);
+
+                if (field_count != 0)
+                {
+                    if (decodeFields(line, (uint16_t)line_length, fields, field_count))
+                    {
+                        result.accepted++;
+                    }
+                    else
+                    {
+                        result.rejected++;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+    private:
+        static constexpr uint8_t MaxFieldCount = CPARSER_CONFIG_MAX_NUM_OF_PARAMS + 1;
+
+        /**
+         * Values of a line being decoded.
+         */
+        struct Decoded
+        {
+            detail::Value values[CPARSER_CONFIG_MAX_NUM_OF_PARAMS];
+            uint32_t present = 0;
+            Dictionary_t dictionary;
+        };
+
+        /**
+         * @brief Dispatches the fields to the decoder of their trigger, or to
+         * the fallback parser.
+         */
+        bool decodeFields(const char *input, uint16_t length, const Field_t *fields,
+                          uint8_t numOfFields) const
+        {
+            if (numOfFields == 0 || numOfFields == TOKENIZER_FIELD_COUNT_INVALID)
+            {
+                return false;
+            }
+
+            std::string_view name(&input[fields[0].start], fields[0].length);
+            bool accepted = false;
+
+            if (dispatch(name, input, fields, numOfFields, accepted,
+                         std::make_index_sequence<NumOfTriggers>{}))
+            {
+                return accepted;
+            }
+
+            // Fallback tokenizes the line again; it is off the hot path.
+            return fallback_ && Cp_FeedLineEx(fallback_, input, length) == TRUE;
+        }
+
+        /**
+         * @brief Compares the name with each trigger name; lengths and first
+         * characters are constants, so most of the names are told apart
+         * without a memory compare.
+         * 
+         * @retval Whether the trigger is in the table.
+         */
+        template <size_t... I>
+        static bool dispatch(std::string_view name, const char *input, const Field_t *fields,
+                             uint8_t numOfFields, bool &accepted, std::index_sequence<I...>)
+        {
+            return ((isMatch<I>(name) &&
+                     (accepted = decode<I>(input, fields, numOfFields), true)) ||
+                    ...);
+        }
+
+        template <size_t I>
+        static bool isMatch(std::string_view name)
+        {
+            constexpr std::string_view trigger_name = Triggers[I].name;
+
+            return name.size() == trigger_name.size() && name[0] == trigger_name[0] &&
+                   std::memcmp(name.data() + 1, trigger_name.data() + 1,
+                               trigger_name.size() - 1) == 0;
+        }
+
+        /**
+         * @brief Decodes the parameters of a trigger and invokes its callback.
+         * Like in the generic parser, fields of unknown and repeated
+         * parameters are ignored and a malformed value or a missing required
+         * parameter rejects the line.
+         */
+        template <size_t I>
+        static bool decode(const char *input, const Field_t *fields, uint8_t numOfFields)
+        {
+            constexpr size_t num_of_params =
+                std::min<size_t>(Triggers[I].numOfParams, CPARSER_CONFIG_MAX_NUM_OF_PARAMS);
+            constexpr Cp_ParsedCallback_t callback = Triggers[I].callback;
+            Decoded decoded;
+
+            Dictionary_Clear(&decoded.dictionary);
+            for (uint8_t j = 1; j < numOfFields; j++)
+            {
+                if (!decodeField<I>(input[fields[j].start], &input[fields[j].start + 1],
+                                    fields[j].length - 1, decoded,
+                                    std::make_index_sequence<num_of_params>{}))
+                {
+                    return false;
+                }
+            }
+
+            if ((decoded.present & getRequired<I>()) != getRequired<I>())
+            {
+                return false;
+            }
+
+            callback(&decoded.dictionary);
+            return true;
+        }
+
+        template <size_t I, size_t... K>
+        static bool decodeField(char letter, const char *value, uint8_t length, Decoded &decoded,
+                                std::index_sequence<K...>)
+        {
+            bool retval = true;
+
+            // Letters are unique, so a field matches one parameter at most.
+            (void)((letter == Triggers[I].params[K].letter &&
+                    (retval = decodeParam<I, K>(value, length, decoded), true)) ||
+                   ...);
+            (void)letter;
+            (void)value;
+            (void)length;
+            (void)decoded;
+            return retval;
+        }
+
+        template <size_t I, size_t K>
+        static bool decodeParam(const char *value, uint8_t length, Decoded &decoded)
+        {
+            constexpr Param param = Triggers[I].params[K];
+
+            if (decoded.present & (1UL << K))
+            {
+                return true;
+            }
+
+            if (!detail::parseValue<param.type>(value, length, decoded.values[K]))
+            {
+                return false;
+            }
+
+            decoded.present |= 1UL << K;
+            Dictionary_Add(&decoded.dictionary, param.letter, param.type, &decoded.values[K]);
+            return true;
+        }
+
+        template <size_t I>
+        static constexpr uint32_t getRequired()
+        {
+            uint32_t required = 0;
+
+            for (size_t k = 0; k < Triggers[I].numOfParams && k < CPARSER_CONFIG_MAX_NUM_OF_PARAMS;
+                 k++)
+            {
+                required |= Triggers[I].params[k].required ? (1UL << k) : 0;
+            }
+
+            return required;
+        }
+
+        Cp_Parser_t *fallback_ = nullptr;
+    };
+}
+
+#endif
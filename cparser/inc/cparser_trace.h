@@ -0,0 +1,87 @@
+/**
+ * @file cparser_trace.h
+ * 
+ * Trace of the parsing stages. When CPARSER_CONFIG_TRACE is enabled, the
+ * parser records the begin and the end of each stage of a line(tokenizing,
+ * trigger lookup, value decoding and the callback) into the trace buffer of
+ * the calling thread, so the stage which has taken the time of a particular
+ * slow line can be found. Buffers are rings of fixed size records which are
+ * written only by their threads, without locks. Records are exported as a
+ * Chrome trace(JSON), which can be opened with chrome://tracing or Perfetto.
+ */
+#ifndef __CPARSER_TRACE_H
+#define __CPARSER_TRACE_H
+
+#include "cparser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Constants ---------------------------------------------------------------*/
+    /** Trigger of the records which don't belong to a trigger(yet). */
+#define CP_TRACE_NO_TRIGGER 0xFFFF
+
+    /* Typedefs ----------------------------------------------------------------*/
+    /*! Traced stages of the line parsing. */
+    enum _Cp_TraceStage_t
+    {
+        CP_TRACE_STAGE_LINE = 0,     /*!< Whole line, from the feed to the return */
+        CP_TRACE_STAGE_TOKENIZE = 1, /*!< Splitting the line into fields */
+        CP_TRACE_STAGE_LOOKUP = 2,   /*!< Finding the trigger of the name */
+        CP_TRACE_STAGE_DECODE = 3,   /*!< Parsing the parameter values */
+        CP_TRACE_STAGE_CALLBACK = 4  /*!< User callback */
+    };
+    typedef uint8_t Cp_TraceStage_t;
+
+    /** Number of the traced stages. */
+#define CP_NUM_OF_TRACE_STAGES 5
+
+    /**
+     * Trace record; 16 bytes.
+     */
+    typedef struct
+    {
+        uint64_t timestamp; /**< Clock of the record, see CPARSER_CONFIG_STATS_CLOCK */
+        uint32_t line;      /**< Sequence number of the line in the buffer */
+        uint16_t trigger;   /**< Registry position of the trigger or CP_TRACE_NO_TRIGGER */
+        uint8_t stage;      /**< Stage of the record */
+        uint8_t end;        /**< TRUE at the end of the stage, FALSE at its begin */
+    } Cp_TraceRecord_t;
+
+    /**
+     * Trace buffer of a thread; a ring which keeps the latest records.
+     * Members are internal; initialize with Cp_TraceInit.
+     */
+    typedef struct
+    {
+        Cp_TraceRecord_t records[CPARSER_CONFIG_TRACE_BUFFER_SIZE]; /**< Ring of the records */
+        uint32_t head;                                              /**< Records written */
+        uint32_t line;                                              /**< Lines begun */
+        uint32_t threadId;                                          /**< Thread id in the trace */
+    } Cp_TraceBuffer_t;
+
+    /**
+     * Writer of the exported text; called with consecutive pieces of it.
+     */
+    typedef void (*Cp_TraceWriter_t)(const char *text, size_t length, void *context);
+
+    /* Variables ---------------------------------------------------------------*/
+    /** Number of the threads which have a buffer attached; the trace points 
+    skip the call of Cp_TraceRecord while it is zero. */
+    extern uint32_t Cp_TraceNumOfAttached;
+
+    /* Functions ---------------------------------------------------------------*/
+    extern void Cp_TraceInit(Cp_TraceBuffer_t *buffer, uint32_t threadId);
+    extern void Cp_TraceAttach(Cp_TraceBuffer_t *buffer);
+    extern Cp_TraceBuffer_t *Cp_TraceGetBuffer(void);
+    extern void Cp_TraceRecord(Cp_TraceStage_t stage, Bool_t end, uint16_t trigger);
+    extern size_t Cp_TraceExport(const Cp_TraceBuffer_t *const *buffers, uint8_t numOfBuffers,
+                                 uint32_t ticksPerMicrosecond, Cp_TraceWriter_t writer,
+                                 void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
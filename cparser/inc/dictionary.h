@@ -15,8 +15,18 @@
 extern "C"
 {
 #endif
+    /* Constants ---------------------------------------------------------------*/
+    /** First key which is indexed directly. */
+#define DICTIONARY_DIRECT_KEY_FIRST 'A'
+
+    /** Number of keys which are indexed directly(0x41 'A' to 0x80, covering 
+    both the upper and lower case letters); one bit of the presence mask each. */
+#define DICTIONARY_DIRECT_KEY_COUNT 64
+
     /**
- * Dictionary structure.
+ * Dictionary structure. Elements are kept in arrays in the order they are 
+ * added, letters also have a direct index so they are found in constant time.
+ * Other keys are searched linearly.
  */
     typedef struct
     {
@@ -25,11 +35,27 @@ extern "C"
         uint8_t types[CPARSER_CONFIG_MAX_NUM_OF_PARAMS]; /**< Types of the values */
         void *values[CPARSER_CONFIG_MAX_NUM_OF_PARAMS];  /**< Pointers to the values */
         uint8_t numberOfElements;                        /**< Number of elements */
+        uint64_t presence;                               /**< Bit per directly indexed key present */
+        uint8_t slots[DICTIONARY_DIRECT_KEY_COUNT];      /**< Element index of each present key */
         /*@}*/
     } Dictionary_t;
 
     /**
-     * @brief Adds element to the dictionary.
+     * @brief Gets the direct index of a key.
+     * 
+     * @param key: Key.
+     * 
+     * @retval DICTIONARY_DIRECT_KEY_COUNT or bigger if the key isn't indexed 
+     * directly, index otherwise.
+     */
+    static inline uint8_t Dictionary_GetKeyIndex(char key)
+    {
+        return (uint8_t)((uint8_t)key - (uint8_t)DICTIONARY_DIRECT_KEY_FIRST);
+    }
+
+    /**
+     * @brief Adds element to the dictionary. If the key already exists, the 
+     * earlier element is kept being found.
      * 
      * @param dictionary: Pointer to the dictionary object.
      * @param key: Key of the element.
@@ -39,6 +65,14 @@ extern "C"
     static inline void Dictionary_Add(Dictionary_t *dictionary, char key, uint8_t type,
                                       void *value)
     {
+        uint8_t index = Dictionary_GetKeyIndex(key);
+
+        if (index < DICTIONARY_DIRECT_KEY_COUNT && !(dictionary->presence & (1ULL << index)))
+        {
+            dictionary->presence |= 1ULL << index;
+            dictionary->slots[index] = dictionary->numberOfElements;
+        }
+
         dictionary->keys[dictionary->numberOfElements] = key;
         dictionary->types[dictionary->numberOfElements] = type;
         dictionary->values[dictionary->numberOfElements] = value;
@@ -46,29 +80,69 @@ extern "C"
     }
 
     /**
-     * @brief Removes element from the dictionary.
+     * @brief Finds the element index of a key.
      * 
      * @param dictionary: Pointer to the dictionary object.
      * @param key: Key of the element.
+     * 
+     * @retval Element index, or numberOfElements if the key doesn't exist.
      */
-    static inline void Dictionary_Remove(Dictionary_t *dictionary, char key)
+    static inline uint8_t Dictionary_Find(const Dictionary_t *dictionary, char key)
     {
-        // For all elements including the last element.
+        uint8_t index = Dictionary_GetKeyIndex(key);
+
+        if (index < DICTIONARY_DIRECT_KEY_COUNT)
+        {
+            return (dictionary->presence & (1ULL << index)) ? dictionary->slots[index]
+                                                            : dictionary->numberOfElements;
+        }
+
         for (uint8_t i = 0; i < dictionary->numberOfElements; i++)
         {
             if (dictionary->keys[i] == key)
             {
-                // Put last element to the place of the removed element. If the element
-                //to be removed is the last element, this procedure would also lead to
-                //removing it.
-                dictionary->keys[i] = dictionary->keys[dictionary->numberOfElements - 1];
-                dictionary->types[i] = dictionary->types[dictionary->numberOfElements - 1];
-                dictionary->values[i] = dictionary->values[dictionary->numberOfElements - 1];
+                return i;
+            }
+        }
+
+        return dictionary->numberOfElements;
+    }
+
+    /**
+     * @brief Removes element from the dictionary.
+     * 
+     * @param dictionary: Pointer to the dictionary object.
+     * @param key: Key of the element.
+     */
+    static inline void Dictionary_Remove(Dictionary_t *dictionary, char key)
+    {
+        uint8_t i = Dictionary_Find(dictionary, key);
+
+        if (i == dictionary->numberOfElements)
+        {
+            return;
+        }
 
-                // Decrease number of elements.
-                dictionary->numberOfElements--;
+        // Put last element to the place of the removed element. If the element
+        //to be removed is the last element, this procedure would also lead to
+        //removing it.
+        dictionary->keys[i] = dictionary->keys[dictionary->numberOfElements - 1];
+        dictionary->types[i] = dictionary->types[dictionary->numberOfElements - 1];
+        dictionary->values[i] = dictionary->values[dictionary->numberOfElements - 1];
 
-                return;
+        // Decrease number of elements.
+        dictionary->numberOfElements--;
+
+        // Rebuild the direct index; removing is rare compared to the lookups.
+        dictionary->presence = 0;
+        for (i = 0; i < dictionary->numberOfElements; i++)
+        {
+            uint8_t index = Dictionary_GetKeyIndex(dictionary->keys[i]);
+
+            if (index < DICTIONARY_DIRECT_KEY_COUNT && !(dictionary->presence & (1ULL << index)))
+            {
+                dictionary->presence |= 1ULL << index;
+                dictionary->slots[index] = i;
             }
         }
     }
@@ -81,6 +155,7 @@ extern "C"
     static inline void Dictionary_Clear(Dictionary_t *dictionary)
     {
         dictionary->numberOfElements = 0;
+        dictionary->presence = 0;
     }
 
     /**
@@ -91,17 +166,9 @@ extern "C"
      * 
      * @retval TRUE or FALSE.
      */
-    static inline Bool_t Dictionary_DoesExist(Dictionary_t *dictionary, char key)
+    static inline Bool_t Dictionary_DoesExist(const Dictionary_t *dictionary, char key)
     {
-        for (uint8_t i = 0; i < dictionary->numberOfElements; i++)
-        {
-            if (dictionary->keys[i] == key)
-            {
-                return TRUE;
-            }
-        }
-
-        return FALSE;
+        return (Dictionary_Find(dictionary, key) < dictionary->numberOfElements) ? TRUE : FALSE;
     }
 
     /**
@@ -115,20 +182,19 @@ extern "C"
      */
     static inline void *Dictionary_Get(Dictionary_t *dictionary, char key, uint8_t *type)
     {
-        for (uint8_t i = 0; i < dictionary->numberOfElements; i++)
+        uint8_t i = Dictionary_Find(dictionary, key);
+
+        if (i == dictionary->numberOfElements)
         {
-            if (dictionary->keys[i] == key)
-            {
-                if (type)
-                {
-                    *type = dictionary->types[i];
-                }
+            return NULL;
+        }
 
-                return dictionary->values[i];
-            }
+        if (type)
+        {
+            *type = dictionary->types[i];
         }
 
-        return NULL;
+        return dictionary->values[i];
     }
 
 #ifdef __cplusplus
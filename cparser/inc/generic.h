@@ -7,6 +7,7 @@
 #define __GENERIC_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 #ifndef NULL
 #define NULL ((void *)0U)
@@ -0,0 +1,54 @@
+/**
+ * @file number.h
+ * 
+ * Number conversions which are shared by the line and stream parsers.
+ */
+#ifndef __NUMBER_H
+#define __NUMBER_H
+
+#include "generic.h"
+#include "cparser_config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Constants ---------------------------------------------------------------*/
+    /** Maximum number of significant decimal digits a mantissa can hold. */
+#define NUMBER_MAX_MANTISSA_DIGITS 19
+
+    /** Exponents are saturated at this value, far beyond the float range. */
+#define NUMBER_MAX_EXPONENT_VALUE 9999
+
+    /** Maximum length of a formatted integer("-2147483648"). */
+#define NUMBER_MAX_INTEGER_LENGTH 11
+
+    /** Maximum length of a formatted float("-1.2345678E-38"). */
+#define NUMBER_MAX_FLOAT_LENGTH 15
+
+    /** Maximum length of a formatted fixed point value(sign, ten integral 
+    digits, point and ten fraction digits). */
+#define NUMBER_MAX_FIXED_LENGTH 22
+
+    /* Functions ---------------------------------------------------------------*/
+    extern Bool_t Number_ParseInteger(const char *input, uint8_t length, int32_t *value);
+#if CPARSER_CONFIG_REAL
+    extern Bool_t Number_ParseFloat(const char *input, uint8_t length, float *value);
+    extern float Number_ComposeFloat(uint64_t mantissa, int32_t exponent, Bool_t negative);
+    extern float Number_ComposeFloatEx(uint64_t mantissa, const uint64_t *tail,
+                                       uint8_t tailDigits, Bool_t sticky, int32_t exponent,
+                                       Bool_t negative);
+    extern uint8_t Number_FormatFloat(float value, char *output);
+#endif
+    extern Bool_t Number_ParseFixed(const char *input, uint8_t length, int32_t *value);
+    extern int32_t Number_ComposeFixed(uint64_t mantissa, int32_t exponent, Bool_t negative);
+    extern int32_t Number_ComposeFixedEx(uint64_t mantissa, uint64_t tail, uint8_t tailDigits,
+                                         Bool_t sticky, int32_t exponent, Bool_t negative);
+    extern uint8_t Number_FormatInteger(int32_t value, char *output);
+    extern uint8_t Number_FormatFixed(int32_t value, char *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file tokenizer.h
+ * 
+ * Field tokenizer of the trigger lines. Besides the portable scalar 
+ * implementation there are SSE2 and AVX2 implementations which find the
+ * separators 16 or 32 characters at a time. The fastest implementation
+ * supported by the running processor is picked automatically. Framed lines
+ * are tokenized up to their checksum marker while the checksum is computed,
+ * lines of several commands up to each command separator.
+ */
+#ifndef __TOKENIZER_H
+#define __TOKENIZER_H
+
+#include "generic.h"
+#include "cparser_config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /* Constants ---------------------------------------------------------------*/
+    /** Maximum length of a line which can be tokenized into fields. */
+#define TOKENIZER_MAX_LINE_LENGTH 0xFF
+
+    /** Number of fields which is returned for the lines that can't be 
+    tokenized(too long lines or lines with too many fields). */
+#define TOKENIZER_FIELD_COUNT_INVALID 0xFF
+
+    /* Typedefs ----------------------------------------------------------------*/
+    /**
+     * Field of a line. 
+     */
+    typedef struct
+    {
+        uint8_t start;  /**< Index of the first character */
+        uint8_t length; /**< Number of characters */
+    } Field_t;
+
+    /*! Tokenizer implementation enumeration. */
+    enum _Tokenizer_Impl_t
+    {
+        TOKENIZER_IMPL_SCALAR = 0, /*!< Portable, character at a time */
+        TOKENIZER_IMPL_SSE2 = 1,   /*!< 16 characters at a time */
+        TOKENIZER_IMPL_AVX2 = 2    /*!< 32 characters at a time */
+    };
+    typedef uint8_t Tokenizer_Impl_t;
+
+    /* Functions ---------------------------------------------------------------*/
+    extern uint16_t Tokenizer_ParseFields(const char *input, uint16_t inputLength,
+                                          Field_t *fields, uint8_t maxFields,
+                                          uint8_t *numOfFields);
+    extern uint16_t Tokenizer_ParseFieldsWith(Tokenizer_Impl_t impl, const char *input,
+                                              uint16_t inputLength, Field_t *fields,
+                                              uint8_t maxFields, uint8_t *numOfFields);
+    extern size_t Tokenizer_ParseNextLine(const char *buffer, size_t length, Field_t *fields,
+                                          uint8_t maxFields, uint8_t *numOfFields,
+                                          size_t *lineLength);
+    extern uint16_t Tokenizer_ParseFramedFields(const char *input, uint16_t inputLength,
+                                                Field_t *fields, uint8_t maxFields,
+                                                uint8_t *numOfFields, uint8_t *checksum);
+    extern uint16_t Tokenizer_ParseFramedFieldsWith(Tokenizer_Impl_t impl, const char *input,
+                                                    uint16_t inputLength, Field_t *fields,
+                                                    uint8_t maxFields, uint8_t *numOfFields,
+                                                    uint8_t *checksum);
+    extern uint16_t Tokenizer_ParseCommandFields(const char *input, uint16_t inputLength,
+                                                 Field_t *fields, uint8_t maxFields,
+                                                 uint8_t *numOfFields);
+    extern uint16_t Tokenizer_ParseCommandFieldsWith(Tokenizer_Impl_t impl, const char *input,
+                                                     uint16_t inputLength, Field_t *fields,
+                                                     uint8_t maxFields, uint8_t *numOfFields);
+    extern Bool_t Tokenizer_IsSupported(Tokenizer_Impl_t impl);
+    extern Tokenizer_Impl_t Tokenizer_GetImpl(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -4,198 +4,1706 @@
  * Cparser library core module.
  */
 #include "../inc/cparser.h"
+#include "../inc/cparser_cache.h"
+#include "../inc/cparser_internal.h"
+#include "../inc/cparser_trace.h"
+#include "../inc/tokenizer.h"
+#include "../inc/number.h"
 #include "math.h"
+#include "string.h"
 
 /* Private constants -------------------------------------------------------*/
 #define MAX_FIELD_COUNT (CPARSER_CONFIG_MAX_NUM_OF_PARAMS + 1)
-#define MAX_PARAM_DATA_SIZE sizeof(float)
+#define MAX_CHECKSUM 0xFF
+#define NO_TRIGGER 0xFFFF
+#define NO_PARAM 0xFF
+
+/* Seen and required parameters are tracked in 32 bit masks. */
+#if CPARSER_CONFIG_MAX_NUM_OF_PARAMS > 32
+#error "CPARSER_CONFIG_MAX_NUM_OF_PARAMS can't be bigger than 32"
+#endif
+
+/* Stream states. */
+#define STREAM_STATE_IDLE 0       /* Waiting for the next field. */
+#define STREAM_STATE_NAME 1       /* Inside the trigger name field. */
+#define STREAM_STATE_VALUE 2      /* Inside a parameter field which is being decoded. */
+#define STREAM_STATE_SKIP_FIELD 3 /* Inside a parameter field which is ignored. */
+#define STREAM_STATE_SKIP_LINE 4  /* Line is rejected, waiting for the terminator. */
+
+/* Number phases of the value accumulator. */
+#define NUMBER_PHASE_SIGN 0
+#define NUMBER_PHASE_INTEGRAL 1
+#define NUMBER_PHASE_FRACTION 2
+#define NUMBER_PHASE_EXPONENT_SIGN 3
+#define NUMBER_PHASE_EXPONENT 4
+
+/* Registry generations are drawn from a counter which is shared by all the 
+registries, so a registry which is rebuilt at the address of a freed one 
+doesn't repeat its generations. */
+#if defined(__GNUC__)
+#define NEXT_GENERATION() (__atomic_fetch_add(&Generations, 1, __ATOMIC_RELAXED) + 1)
+#else
+#define NEXT_GENERATION() (++Generations)
+#endif
+
+/* Trace points of the parsing stages; when disabled the macros expand to 
+nothing. Record is only called while a thread is traced, so the untraced 
+threads pay a load of a shared counter. */
+#if CPARSER_CONFIG_TRACE
+#if defined(__GNUC__)
+#define TRACE_ACTIVE() __atomic_load_n(&Cp_TraceNumOfAttached, __ATOMIC_RELAXED)
+#else
+#define TRACE_ACTIVE() Cp_TraceNumOfAttached
+#endif
+#define TRACE_BEGIN(stage, trigger)                \
+    do                                             \
+    {                                              \
+        if (TRACE_ACTIVE())                        \
+        {                                          \
+            Cp_TraceRecord(stage, FALSE, trigger); \
+        }                                          \
+    } while (0)
+#define TRACE_END(stage, trigger)                 \
+    do                                            \
+    {                                             \
+        if (TRACE_ACTIVE())                       \
+        {                                         \
+            Cp_TraceRecord(stage, TRUE, trigger); \
+        }                                         \
+    } while (0)
+#else
+#define TRACE_BEGIN(stage, trigger)
+#define TRACE_END(stage, trigger)
+#endif
+
+/* A stream line begins with its first non-separator character and is traced
+from there up to its terminator. */
+#define STREAM_LINE_BEGUN(stream) \
+    ((stream)->state != STREAM_STATE_IDLE || (stream)->command.trigger != NULL)
 
-/* Private typedefs --------------------------------------------------------*/
-typedef struct
+/* Private function prototypes ---------------------------------------------*/
+static void resetStream(Cp_Parser_t *parser);
+static Bool_t endStreamField(Cp_Parser_t *parser);
+static void startStreamParam(Cp_Parser_t *parser, char letter);
+static void resetAccumulator(Cp_Accumulator_t *accumulator);
+static Bool_t accumulate(Cp_Accumulator_t *accumulator, Cp_ParamType_t type, char c);
+static Bool_t finishAccumulator(Cp_Accumulator_t *accumulator, Cp_ParamType_t type, void *data,
+                                uint8_t *size);
+static void indexTrigger(Cp_Registry_t *registry, uint16_t position);
+static Bool_t isTypedLayoutValid(const Cp_Trigger_t *trigger);
+static Bool_t areLettersUnique(const Cp_Trigger_t *trigger);
+static uint8_t getValueSize(Cp_ParamType_t type);
+static void bindParams(Cp_Registry_t *registry, uint16_t position);
+static uint8_t bindParam(const Cp_Trigger_t *trigger, const Cp_Binding_t *binding, char letter);
+static uint8_t countBits(uint64_t value);
+static uint16_t findTrigger(const Cp_Registry_t *registry, const char *input, uint8_t length);
+static uint16_t lookupTrigger(const Cp_Registry_t *registry, uint32_t hash, const char *name,
+                              uint8_t length);
+static uint32_t hashName(const char *name, uint8_t length);
+static uint32_t hashStep(uint32_t hash, char c);
+static uint32_t hashFinish(uint32_t hash, uint8_t length);
+static Bool_t doesMatch(const char *tname, uint8_t tnameLength, const char *input,
+                        uint8_t length);
+static Cp_RejectReason_t decodeFields(const Cp_Parser_t *parser, const char *input,
+                                      const Field_t *fields, uint8_t numOfFields,
+                                      Cp_Command_t *command);
+static Bool_t parseValue(const char *input, uint8_t inputLength, uint8_t type, void *data, uint8_t *size);
+static uint8_t getLength(const char *input);
+static Bool_t decodeLine(Cp_Parser_t *parser, const char *input, uint16_t length,
+                         Cp_Command_t *command);
+static size_t decodeNextLine(Cp_Parser_t *parser, const char *buffer, size_t length,
+                             Cp_Command_t *command, Cp_LineStatus_t *status);
+static size_t findCachedLineEnd(const char *input, size_t length);
+static Cp_FrameStatus_t checkFrame(Cp_Parser_t *parser, const char *input, uint16_t length,
+                                   uint16_t stop, uint8_t checksum, const Field_t *fields,
+                                   uint8_t numOfFields);
+
+/* Private variables -------------------------------------------------------*/
+static Cp_Parser_t DefaultParser;
+static uint32_t Generations = 0;
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Clears the trigger parser registry of the default parser.
+ */
+void Cp_Reset(void)
+{
+    Cp_ResetEx(&DefaultParser);
+}
+
+/**
+ * @brief Registers a trigger to the default parser.
+ * 
+ * @param triggers: Pointer to the trigger array.
+ * @param numOfTriggers: Number of triggers to be registered.
+ * 
+ * @retval Number of the registered triggers, see Cp_RegistryAdd.
+ */
+uint16_t Cp_Register(Cp_Trigger_t *triggers, uint16_t numOfTriggers)
+{
+    return Cp_RegisterEx(&DefaultParser, triggers, numOfTriggers);
+}
+
+/**
+ * @brief Feeds line of char array to the default parser.
+ * 
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * 
+ * @retval TRUE or FALSE.
+ */
+uint8_t Cp_FeedLine(const char *input, uint16_t length)
+{
+    return Cp_FeedLineEx(&DefaultParser, input, length);
+}
+
+/**
+ * @brief Feeds a buffer of lines to the default parser.
+ * 
+ * @param buffer: Pointer to the buffer.
+ * @param length: Length of the buffer.
+ * 
+ * @retval Numbers of the accepted and rejected lines.
+ */
+Cp_FeedResult_t Cp_FeedBuffer(const char *buffer, size_t length)
+{
+    return Cp_FeedBufferEx(&DefaultParser, buffer, length);
+}
+
+/**
+ * @brief Feeds bytes of the trigger stream to the default parser.
+ * 
+ * @param data: Pointer to the received bytes.
+ * @param n: Number of the bytes.
+ * 
+ * @retval Number of the lines which have been parsed and dispatched.
+ */
+size_t Cp_FeedBytes(const char *data, size_t n)
+{
+    return Cp_FeedBytesEx(&DefaultParser, data, n);
+}
+
+/**
+ * @brief Feeds a framed line to the default parser.
+ * 
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * 
+ * @retval Status of the frame.
+ */
+Cp_FrameStatus_t Cp_FeedFramedLine(const char *input, uint16_t length)
+{
+    return Cp_FeedFramedLineEx(&DefaultParser, input, length);
+}
+
+/**
+ * @brief Feeds a line of ';' separated commands to the default parser.
+ * 
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * @param statuses: Pointer to return the status of each non-empty 
+ * sub-command, can be NULL.
+ * @param maxStatuses: Capacity of the statuses array.
+ * 
+ * @retval Numbers of the accepted and rejected sub-commands.
+ */
+Cp_FeedResult_t Cp_FeedCommands(const char *input, uint16_t length, Cp_LineStatus_t *statuses,
+                                uint8_t maxStatuses)
+{
+    return Cp_FeedCommandsEx(&DefaultParser, input, length, statuses, maxStatuses);
+}
+
+/**
+ * @brief Gets a snapshot of the statistics of the default parser.
+ * 
+ * @param stats: Pointer to the statistics which receives the snapshot.
+ * 
+ * @retval FALSE if the statistics are disabled, TRUE otherwise.
+ */
+Bool_t Cp_GetStats(Cp_Stats_t *stats)
+{
+    return Cp_GetStatsEx(&DefaultParser, stats);
+}
+
+/**
+ * @brief Attaches a command queue to the default parser.
+ * 
+ * @param queue: Pointer to the queue, NULL to dispatch the commands directly.
+ */
+void Cp_SetQueue(Cp_Queue_t *queue)
+{
+    Cp_SetQueueEx(&DefaultParser, queue);
+}
+
+/**
+ * @brief Attaches a line cache to the default parser.
+ * 
+ * @param cache: Pointer to the cache, NULL to parse every line.
+ */
+void Cp_SetLineCache(Cp_LineCache_t *cache)
+{
+    Cp_SetLineCacheEx(&DefaultParser, cache);
+}
+
+/**
+ * @brief Initializes a parser instance with an empty registry. A zero
+ * initialized(e.g. static) instance is already in this state.
+ * 
+ * @param parser: Pointer to the parser.
+ */
+void Cp_Init(Cp_Parser_t *parser)
+{
+    memset(parser, 0, sizeof(Cp_Parser_t));
+}
+
+/**
+ * @brief Clears the own trigger registry of the parser and the statistics.
+ * 
+ * @param parser: Pointer to the parser.
+ */
+void Cp_ResetEx(Cp_Parser_t *parser)
+{
+    Cp_RegistryInit(&parser->registry);
+    resetStream(parser);
+    parser->lineNumber = 0;
+
+#if CPARSER_CONFIG_STATS
+    // Hit counters are kept per registry position, so they are cleared too.
+    memset(&parser->stats, 0, sizeof(Cp_Stats_t));
+#endif
+}
+
+/**
+ * @brief Attaches a command queue to the parser. While a queue is attached,
+ * commands of the lines which are fed by Cp_FeedLineEx, Cp_FeedBufferEx and
+ * Cp_FeedBytesEx are put into the queue instead of being dispatched. Lines 
+ * which don't fit into a full queue are dropped and counted as rejected. 
+ * Queue should be initialized before; it keeps the parser for timing the 
+ * callbacks which it dispatches. Cp_FeedBufferParallel bypasses the queue 
+ * and dispatches the commands directly.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param queue: Pointer to the queue, NULL to dispatch the commands directly.
+ */
+void Cp_SetQueueEx(Cp_Parser_t *parser, Cp_Queue_t *queue)
+{
+    parser->queue = queue;
+    if (queue)
+    {
+        queue->parser = parser;
+    }
+}
+
+/**
+ * @brief Attaches a line cache to the parser. Lines which are fed by 
+ * Cp_FeedLineEx and Cp_FeedBufferEx are looked up in the cache first; 
+ * accepted lines are stored in it. Cache is emptied when it is attached.
+ * Cp_FeedBufferParallel doesn't use the cache.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param cache: Pointer to the cache, NULL to parse every line.
+ */
+void Cp_SetLineCacheEx(Cp_Parser_t *parser, Cp_LineCache_t *cache)
+{
+    if (cache)
+    {
+        Cp_LineCacheInit(cache);
+    }
+
+    parser->cache = cache;
+}
+
+/**
+ * @brief Registers a trigger to the own registry of the parser.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param triggers: Pointer to the trigger array.
+ * @param numOfTriggers: Number of triggers to be registered.
+ * 
+ * @retval Number of the registered triggers, see Cp_RegistryAdd.
+ */
+uint16_t Cp_RegisterEx(Cp_Parser_t *parser, Cp_Trigger_t *triggers, uint16_t numOfTriggers)
+{
+    return Cp_RegistryAdd(&parser->registry, triggers, numOfTriggers);
+}
+
+/**
+ * @brief Initializes an empty registry. A zero initialized registry is 
+ * already in this state.
+ * 
+ * @param registry: Pointer to the registry.
+ */
+void Cp_RegistryInit(Cp_Registry_t *registry)
+{
+    // A new generation, so a rebuilt registry doesn't match the lines cached
+    //from its earlier contents.
+    registry->numOfTriggers = 0;
+    registry->generation = NEXT_GENERATION();
+
+    // Empty all the index slots.
+    for (uint16_t i = 0; i < CPARSER_CONFIG_TRIGGER_INDEX_SIZE; i++)
+    {
+        registry->triggerIndex[i] = 0;
+    }
+}
+
+/**
+ * @brief Registers a trigger to a registry. Triggers which don't fit into 
+ * the registry, triggers which repeat a parameter letter and typed triggers
+ * whose output struct can't hold their parameters are ignored.
+ * 
+ * @param registry: Pointer to the registry.
+ * @param triggers: Pointer to the trigger array.
+ * @param numOfTriggers: Number of triggers to be registered.
+ * 
+ * @retval Number of the registered triggers; less than numOfTriggers if 
+ * some of them are ignored.
+ */
+uint16_t Cp_RegistryAdd(Cp_Registry_t *registry, Cp_Trigger_t *triggers, uint16_t numOfTriggers)
+{
+    uint16_t registered = 0;
+
+    for (uint16_t i = 0; i < numOfTriggers; i++)
+    {
+        if (registry->numOfTriggers == CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS)
+        {
+            break;
+        }
+
+        if (!isTypedLayoutValid(&triggers[i]) || !areLettersUnique(&triggers[i]))
+        {
+            continue;
+        }
+
+        registry->triggerTable[registry->numOfTriggers] = &triggers[i];
+        registry->triggerNameLengths[registry->numOfTriggers] = getLength(triggers[i].name);
+        indexTrigger(registry, registry->numOfTriggers);
+        bindParams(registry, registry->numOfTriggers);
+        registry->numOfTriggers++;
+        registered++;
+    }
+
+    registry->generation = NEXT_GENERATION();
+    return registered;
+}
+
+/**
+ * @brief Feeds line of char array.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * 
+ * @retval TRUE or FALSE.
+ */
+uint8_t Cp_FeedLineEx(Cp_Parser_t *parser, const char *input, uint16_t length)
+{
+    Cp_Command_t command;
+    Bool_t decoded;
+    TRACE_BEGIN(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+
+    // Registry is only needed while decoding; a callback may publish a new one.
+    lockRegistry(parser);
+    decoded = decodeLine(parser, input, length, &command);
+    unlockRegistry(parser);
+
+    if (!decoded)
+    {
+        TRACE_END(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+        return FALSE;
+    }
+
+    decoded = dispatch(parser, &command);
+    TRACE_END(CP_TRACE_STAGE_LINE, command.position);
+    return decoded;
+}
+
+/**
+ * @brief Feeds a framed line("N<line number> <trigger> ... *<checksum>"),
+ * e.g. from a noisy serial link. Checksum is the XOR of the characters 
+ * before the '*' and it is computed while the line is tokenized. A line is
+ * decoded and dispatched only if its checksum matches and its line number is
+ * the expected one, which then advances; also if the command is rejected. 
+ * On a framing failure, for an oversized line and for a command which 
+ * doesn't fit into the full queue the expected line number stays the same,
+ * so the sender can be asked to resend from Cp_GetLineNumberEx. Line cache 
+ * isn't used for the framed lines.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * 
+ * @retval Status of the frame.
+ */
+Cp_FrameStatus_t Cp_FeedFramedLineEx(Cp_Parser_t *parser, const char *input, uint16_t length)
+{
+    Field_t fields[MAX_FIELD_COUNT + 1];
+    uint8_t field_count;
+    uint8_t checksum;
+    uint16_t stop;
+    Cp_FrameStatus_t status;
+    Cp_Command_t command;
+    Cp_RejectReason_t reason;
+    STATS_START(start);
+    TRACE_BEGIN(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+
+    TRACE_BEGIN(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+    stop = Tokenizer_ParseFramedFields(input, length, fields, MAX_FIELD_COUNT + 1, &field_count,
+                                       &checksum);
+    TRACE_END(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+
+    status = checkFrame(parser, input, length, stop, checksum, fields, field_count);
+    if (status != CP_FRAME_STATUS_ACCEPTED)
+    {
+        if (status == CP_FRAME_STATUS_OVERSIZED)
+        {
+            STATS_REJECT(parser, CP_REJECT_REASON_OVERSIZED);
+        }
+        TRACE_END(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+        return status;
+    }
+
+    // Line number field isn't a part of the command.
+    lockRegistry(parser);
+    reason = decodeFields(parser, input, &fields[1], field_count - 1, &command);
+    STATS_PARSE_TIME(parser, start);
+    unlockRegistry(parser);
+
+    // A dropped command can be resent with the same line number.
+    if (reason == CP_REJECT_REASON_NONE && !dispatch(parser, &command))
+    {
+        TRACE_END(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+        return CP_FRAME_STATUS_QUEUE_FULL;
+    }
+
+    parser->lineNumber++;
+    if (reason != CP_REJECT_REASON_NONE)
+    {
+        TRACE_END(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+        return CP_FRAME_STATUS_REJECTED;
+    }
+
+    TRACE_END(CP_TRACE_STAGE_LINE, command.position);
+    return CP_FRAME_STATUS_ACCEPTED;
+}
+
+/**
+ * @brief Feeds a line of commands which are separated by ';'(e.g. 
+ * "move D1 S5; pump MD V1.25"). Sub-commands are tokenized, decoded and 
+ * dispatched in order during a single scan of the line; the same fields and
+ * command storage are used for all of them. Each one is accepted or rejected
+ * on its own, a rejected one doesn't stop the rest. Line ends at the first 
+ * new line character. Empty sub-commands are skipped without being counted.
+ * Line cache isn't used for these lines.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * @param statuses: Pointer to return the status of each non-empty 
+ * sub-command in order, can be NULL. Statuses which don't fit are dropped.
+ * @param maxStatuses: Capacity of the statuses array.
+ * 
+ * @retval Numbers of the accepted and rejected sub-commands.
+ */
+Cp_FeedResult_t Cp_FeedCommandsEx(Cp_Parser_t *parser, const char *input, uint16_t length,
+                                  Cp_LineStatus_t *statuses, uint8_t maxStatuses)
+{
+    Cp_FeedResult_t result = {0, 0};
+    Field_t fields[MAX_FIELD_COUNT];
+    Cp_Command_t command;
+    uint16_t offset = 0;
+
+    while (offset < length)
+    {
+        uint8_t field_count;
+        uint16_t stop;
+        Cp_LineStatus_t status;
+        STATS_START(start);
+
+        // Each sub-command is traced as a line. Field positions are relative 
+        //to the sub-command.
+        TRACE_BEGIN(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+        TRACE_BEGIN(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+        stop = Tokenizer_ParseCommandFields(&input[offset], length - offset, fields,
+                                            MAX_FIELD_COUNT, &field_count);
+        TRACE_END(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+
+        if (field_count == 0)
+        {
+            TRACE_END(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+        }
+        else
+        {
+            lockRegistry(parser);
+            status = (decodeFields(parser, &input[offset], fields, field_count, &command) ==
+                      CP_REJECT_REASON_NONE)
+                         ? CP_LINE_STATUS_ACCEPTED
+                         : CP_LINE_STATUS_REJECTED;
+            STATS_PARSE_TIME(parser, start);
+            unlockRegistry(parser);
+
+            if (status == CP_LINE_STATUS_ACCEPTED && !dispatch(parser, &command))
+            {
+                status = CP_LINE_STATUS_REJECTED;
+            }
+
+            if (statuses && (result.accepted + result.rejected) < maxStatuses)
+            {
+                statuses[result.accepted + result.rejected] = status;
+            }
+
+            if (status == CP_LINE_STATUS_ACCEPTED)
+            {
+                result.accepted++;
+                TRACE_END(CP_TRACE_STAGE_LINE, command.position);
+            }
+            else
+            {
+                result.rejected++;
+                TRACE_END(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+            }
+        }
+
+        // Only a command separator continues the line.
+        offset += stop;
+        if (offset >= length || input[offset] != ';')
+        {
+            break;
+        }
+        offset++;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Sets the expected line number of the next framed line, e.g. when 
+ * the sender restarts its numbering.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param lineNumber: Line number of the next framed line.
+ */
+void Cp_SetLineNumberEx(Cp_Parser_t *parser, uint32_t lineNumber)
+{
+    parser->lineNumber = lineNumber;
+}
+
+/**
+ * @brief Gets the expected line number of the next framed line; the line to
+ * be resent after a failed frame.
+ * 
+ * @param parser: Pointer to the parser.
+ * 
+ * @retval Line number.
+ */
+uint32_t Cp_GetLineNumberEx(const Cp_Parser_t *parser)
+{
+    return parser->lineNumber;
+}
+
+/**
+ * @brief Feeds a buffer of lines which are separated by new line characters.
+ * Lines are split and tokenized in the same pass, then each one is 
+ * dispatched like Cp_FeedLine does. Last line doesn't need a terminator. 
+ * Empty lines are skipped without being counted.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param buffer: Pointer to the buffer.
+ * @param length: Length of the buffer.
+ * 
+ * @retval Numbers of the accepted and rejected lines.
+ */
+Cp_FeedResult_t Cp_FeedBufferEx(Cp_Parser_t *parser, const char *buffer, size_t length)
+{
+    Cp_FeedResult_t result = {0, 0};
+    Cp_Command_t command;
+    Cp_LineStatus_t status;
+    size_t offset = 0;
+
+    while (offset < length)
+    {
+        TRACE_BEGIN(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+        lockRegistry(parser);
+        offset += decodeNextLine(parser, &buffer[offset], length - offset, &command, &status);
+        unlockRegistry(parser);
+
+        if (status == CP_LINE_STATUS_ACCEPTED && dispatch(parser, &command))
+        {
+            result.accepted++;
+        }
+        else if (status != CP_LINE_STATUS_EMPTY)
+        {
+            result.rejected++;
+        }
+        TRACE_END(CP_TRACE_STAGE_LINE, (status == CP_LINE_STATUS_ACCEPTED) ? command.position
+                                                                          : CP_TRACE_NO_TRIGGER);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Feeds bytes of the trigger stream. Bytes can be given in arbitrary
+ * pieces, state of the partially received line is kept between the calls. 
+ * Each line is terminated by a new line character and its callback is 
+ * invoked as soon as the terminator arrives. Fields are separated by spaces,
+ * carriage returns are ignored.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param data: Pointer to the received bytes.
+ * @param n: Number of the bytes.
+ * 
+ * @retval Number of the lines which have been parsed and dispatched(or 
+ * queued).
+ */
+size_t Cp_FeedBytesEx(Cp_Parser_t *parser, const char *data, size_t n)
+{
+    Cp_Stream_t *stream = &parser->stream;
+    size_t dispatched = 0;
+
+    // Binding of the trigger is copied into the stream state, so a line can
+    //continue in the next call even if another registry is published between.
+    lockRegistry(parser);
+
+    // Lines are tokenized and decoded as their bytes arrive; each received 
+    //piece of a line is traced as a tokenize stage.
+    if (STREAM_LINE_BEGUN(stream))
+    {
+        TRACE_BEGIN(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        char c = data[i];
+
+        if (c == '\n')
+        {
+            Bool_t begun = STREAM_LINE_BEGUN(stream);
+            Bool_t accepted = FALSE;
+
+            // A rejected or empty line doesn't invoke any callback.
+            Bool_t complete = stream->state != STREAM_STATE_SKIP_LINE && endStreamField(parser) &&
+                              stream->command.trigger;
+
+            if (begun)
+            {
+                TRACE_END(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+            }
+
+            if (complete)
+            {
+                uint32_t required = stream->binding.required;
+
+                if ((stream->command.present & required) == required)
+                {
+                    STATS_ACCEPT(parser, stream->position);
+                    accepted = dispatch(parser, &stream->command);
+                    dispatched += accepted ? 1 : 0;
+                }
+                else
+                {
+                    STATS_REJECT(parser, CP_REJECT_REASON_MISSING_PARAM);
+                }
+            }
+
+            if (begun)
+            {
+                TRACE_END(CP_TRACE_STAGE_LINE,
+                          accepted ? stream->position : CP_TRACE_NO_TRIGGER);
+            }
+
+            resetStream(parser);
+
+            // Next line is decoded with the latest published registry.
+            unlockRegistry(parser);
+            lockRegistry(parser);
+        }
+        else if (c == ' ' || c == '\r')
+        {
+            if (stream->state != STREAM_STATE_SKIP_LINE)
+            {
+                stream->state = endStreamField(parser) ? STREAM_STATE_IDLE : STREAM_STATE_SKIP_LINE;
+            }
+        }
+        else
+        {
+            switch (stream->state)
+            {
+            case STREAM_STATE_IDLE:
+                // First field is the trigger name, the others are parameters.
+                if (stream->command.trigger)
+                {
+                    startStreamParam(parser, c);
+                }
+                else
+                {
+                    TRACE_BEGIN(CP_TRACE_STAGE_LINE, CP_TRACE_NO_TRIGGER);
+                    TRACE_BEGIN(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+                    stream->state = STREAM_STATE_NAME;
+                    stream->name[0] = c;
+                    stream->nameLength = 1;
+                    stream->nameHash = hashStep(hashName(NULL, 0), c);
+                }
+                break;
+
+            case STREAM_STATE_NAME:
+                // Names longer than the limit can't match; just keep the length.
+                if (stream->nameLength < CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH)
+                {
+                    stream->name[stream->nameLength] = c;
+                    stream->nameHash = hashStep(stream->nameHash, c);
+                }
+
+                if (stream->nameLength < 0xFF)
+                {
+                    stream->nameLength++;
+                }
+                break;
+
+            case STREAM_STATE_VALUE:
+                if (!accumulate(&stream->accumulator,
+                                stream->command.trigger->params[stream->paramIdx].type, c))
+                {
+                    STATS_REJECT(parser, CP_REJECT_REASON_MALFORMED_VALUE);
+                    stream->state = STREAM_STATE_SKIP_LINE;
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    if (STREAM_LINE_BEGUN(stream))
+    {
+        TRACE_END(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+    }
+
+    unlockRegistry(parser);
+    return dispatched;
+}
+
+/**
+ * @brief Decodes a line without invoking its callback. Parser is only read,
+ * so several threads can decode with the same parser at the same time.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * @param command: Pointer to the command which receives the decoded line.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t Cp_DecodeLineEx(const Cp_Parser_t *parser, const char *input, uint16_t length,
+                       Cp_Command_t *command)
+{
+    Field_t fields[MAX_FIELD_COUNT];
+    uint8_t field_count;
+    Cp_RejectReason_t reason;
+    STATS_START(start);
+
+    // Parse fields.
+    TRACE_BEGIN(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+    Tokenizer_ParseFields(input, length, fields, MAX_FIELD_COUNT, &field_count);
+    TRACE_END(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+
+    reason = decodeFields(parser, input, fields, field_count, command);
+    STATS_PARSE_TIME(parser, start);
+
+    return (reason == CP_REJECT_REASON_NONE) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Decodes the first line of a buffer of new line separated lines, 
+ * without invoking its callback. Line is split and tokenized in the same 
+ * pass. Parser is only read.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param buffer: Pointer to the buffer.
+ * @param length: Length of the buffer; should be bigger than zero.
+ * @param command: Pointer to the command which receives the decoded line.
+ * @param status: Pointer to the status of the line.
+ * 
+ * @retval Number of bytes consumed, including the line terminator.
+ */
+size_t Cp_DecodeNextLineEx(const Cp_Parser_t *parser, const char *buffer, size_t length,
+                           Cp_Command_t *command, Cp_LineStatus_t *status)
+{
+    Field_t fields[MAX_FIELD_COUNT];
+    uint8_t field_count;
+    size_t consumed;
+    STATS_START(start);
+
+    // A line which doesn't fit into the tokenizer window is rejected as a 
+    //whole.
+    TRACE_BEGIN(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+    consumed = Tokenizer_ParseNextLine(buffer, length, fields, MAX_FIELD_COUNT, &field_count, NULL);
+    TRACE_END(CP_TRACE_STAGE_TOKENIZE, CP_TRACE_NO_TRIGGER);
+
+    if (field_count == 0)
+    {
+        *status = CP_LINE_STATUS_EMPTY;
+    }
+    else
+    {
+        *status = (decodeFields(parser, buffer, fields, field_count, command) ==
+                   CP_REJECT_REASON_NONE)
+                      ? CP_LINE_STATUS_ACCEPTED
+                      : CP_LINE_STATUS_REJECTED;
+        STATS_PARSE_TIME(parser, start);
+    }
+
+    return consumed;
+}
+
+/**
+ * @brief Invokes the callback of a decoded command. Values of a typed 
+ * trigger are written into a zeroed output struct on the stack which is 
+ * given to its typed callback; others are given in a dictionary.
+ * 
+ * @param command: Pointer to the command.
+ */
+void Cp_DispatchCommand(const Cp_Command_t *command)
+{
+    const Cp_Trigger_t *trigger = command->trigger;
+
+    if (trigger->typedCallback)
+    {
+        uint64_t output[(CPARSER_CONFIG_MAX_OUTPUT_SIZE + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+
+        memset(output, 0, sizeof(output));
+        for (uint8_t i = 0; i < command->numOfValues; i++)
+        {
+            const Cp_Param_t *param = &trigger->params[command->params[i]];
+            uint8_t *field = (uint8_t *)output + param->offset;
+
+            // Constant sizes let the copies compile to single stores.
+            if (param->type == CP_PARAM_TYPE_LETTER)
+            {
+                memcpy(field, &command->values[i], sizeof(char));
+            }
+            else
+            {
+                memcpy(field, &command->values[i], sizeof(uint32_t));
+            }
+        }
+
+        trigger->typedCallback(output, command->present);
+        return;
+    }
+
+    Dictionary_t dictionary;
+
+    Dictionary_Clear(&dictionary);
+    for (uint8_t i = 0; i < command->numOfValues; i++)
+    {
+        const Cp_Param_t *param = &trigger->params[command->params[i]];
+
+        Dictionary_Add(&dictionary, param->letter, param->type, (void *)&command->values[i]);
+    }
+
+    trigger->callback(&dictionary);
+}
+
+/**
+ * @brief Invokes the callback of a command which is decoded by the parser, 
+ * like Cp_DispatchCommand does. Callback time is recorded to the statistics
+ * of the parser.
+ * 
+ * @param parser: Pointer to the parser which has decoded the command.
+ * @param command: Pointer to the command.
+ */
+void Cp_DispatchCommandEx(const Cp_Parser_t *parser, const Cp_Command_t *command)
+{
+    STATS_START(start);
+
+    TRACE_BEGIN(CP_TRACE_STAGE_CALLBACK, command->position);
+    Cp_DispatchCommand(command);
+    TRACE_END(CP_TRACE_STAGE_CALLBACK, command->position);
+    STATS_CALLBACK_TIME(parser, start);
+    (void)parser;
+}
+
+/**
+ * @brief Gets a snapshot of the statistics. Counters are read one by one 
+ * while the parser may be in use, so the snapshot isn't necessarily 
+ * consistent as a whole.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param stats: Pointer to the statistics which receives the snapshot.
+ * 
+ * @retval FALSE if the statistics are disabled, TRUE otherwise.
+ */
+Bool_t Cp_GetStatsEx(const Cp_Parser_t *parser, Cp_Stats_t *stats)
+{
+#if CPARSER_CONFIG_STATS
+    const Cp_Stats_t *source = getStats(parser);
+
+    stats->accepted = STATS_LOAD(source->accepted);
+    for (uint8_t i = 0; i < CP_NUM_OF_REJECT_REASONS; i++)
+    {
+        stats->rejected[i] = STATS_LOAD(source->rejected[i]);
+    }
+
+    for (uint16_t i = 0; i < CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS; i++)
+    {
+        stats->hits[i] = STATS_LOAD(source->hits[i]);
+    }
+
+    for (uint8_t i = 0; i < CP_STATS_HISTOGRAM_SIZE; i++)
+    {
+        stats->parseTime[i] = STATS_LOAD(source->parseTime[i]);
+        stats->callbackTime[i] = STATS_LOAD(source->callbackTime[i]);
+    }
+
+    return TRUE;
+#else
+    (void)parser;
+    memset(stats, 0, sizeof(Cp_Stats_t));
+    return FALSE;
+#endif
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Resets the stream state for a new line.
+ * 
+ * @param parser: Pointer to the parser.
+ */
+void resetStream(Cp_Parser_t *parser)
+{
+    Cp_Stream_t *stream = &parser->stream;
+
+    stream->state = STREAM_STATE_IDLE;
+    stream->nameLength = 0;
+    stream->command.trigger = NULL;
+    stream->command.present = 0;
+    stream->command.numOfValues = 0;
+}
+
+/**
+ * @brief Completes the stream field which is being received. Trigger name 
+ * is resolved and parameter value is added to the command.
+ * 
+ * @param parser: Pointer to the parser.
+ * 
+ * @retval FALSE if the line should be rejected, TRUE otherwise.
+ */
+Bool_t endStreamField(Cp_Parser_t *parser)
+{
+    Cp_Stream_t *stream = &parser->stream;
+    const Cp_Registry_t *registry;
+
+    switch (stream->state)
+    {
+    case STREAM_STATE_NAME:
+        // Names longer than the limit can't be registered at all.
+        if (stream->nameLength > CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH)
+        {
+            STATS_REJECT(parser, CP_REJECT_REASON_UNKNOWN_TRIGGER);
+            return FALSE;
+        }
+
+        registry = getRegistry(parser);
+        stream->position = lookupTrigger(registry, hashFinish(stream->nameHash, stream->nameLength),
+                                         stream->name, stream->nameLength);
+        if (stream->position == NO_TRIGGER)
+        {
+            STATS_REJECT(parser, CP_REJECT_REASON_UNKNOWN_TRIGGER);
+            return FALSE;
+        }
+
+        stream->command.trigger = registry->triggerTable[stream->position];
+        stream->command.position = stream->position;
+        stream->binding = registry->bindings[stream->position];
+        return TRUE;
+
+    case STREAM_STATE_VALUE:
+    {
+        Cp_Command_t *command = &stream->command;
+        uint8_t param_size;
+
+        Cp_ParamType_t type = command->trigger->params[stream->paramIdx].type;
+
+        if (!finishAccumulator(&stream->accumulator, type, &command->values[command->numOfValues],
+                               &param_size))
+        {
+            STATS_REJECT(parser, CP_REJECT_REASON_MALFORMED_VALUE);
+            return FALSE;
+        }
+
+        command->params[command->numOfValues] = stream->paramIdx;
+        command->numOfValues++;
+        command->present |= 1UL << stream->paramIdx;
+        return TRUE;
+    }
+
+    default:
+        return TRUE;
+    }
+}
+
+/**
+ * @brief Starts a parameter field of the stream. Fields of unknown 
+ * parameters and repeated parameters are ignored, like Cp_FeedLine does.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param letter: First character of the field.
+ */
+void startStreamParam(Cp_Parser_t *parser, char letter)
 {
-    uint8_t start;
-    uint8_t length;
-} Field_t;
+    Cp_Stream_t *stream = &parser->stream;
+    uint8_t param_idx = bindParam(stream->command.trigger, &stream->binding, letter);
 
-/* Private function prototypes ---------------------------------------------*/
-static Bool_t doesMatch(const char *cname, char *input, uint8_t length);
-static void parseFields(char *input, uint8_t inputLength, Field_t *fields, uint8_t *numOfFields);
-static Bool_t parseValue(char *input, uint8_t inputLength, uint8_t type, void *data, uint8_t *size);
-static Bool_t parseFloat(char *input, uint8_t start_idx, uint8_t length, float *value);
-static Bool_t parseFractional(char *input, uint8_t start_idx, uint8_t length, float *value);
-static Bool_t parseSignedInteger(char *input, uint8_t start_idx, uint8_t length, int32_t *value);
-static Bool_t parseUnsignedInteger(char *input, uint8_t start_idx, uint8_t length,
-                                   uint32_t *value);
-static void getSign(char *input, uint8_t start_idx, uint8_t length, int8_t *sign, uint8_t *stop_idx);
-static void cropJerk(char *input, uint8_t start_idx, uint8_t length, uint8_t *stop_idx);
-static uint8_t getLength(const char *input);
+    if (param_idx == NO_PARAM || (stream->command.present & (1UL << param_idx)))
+    {
+        stream->state = STREAM_STATE_SKIP_FIELD;
+        return;
+    }
+
+    stream->paramIdx = param_idx;
+    stream->state = STREAM_STATE_VALUE;
+    resetAccumulator(&stream->accumulator);
+}
+
+/**
+ * @brief Resets the value accumulator.
+ * 
+ * @param accumulator: Pointer to the accumulator.
+ */
+void resetAccumulator(Cp_Accumulator_t *accumulator)
+{
+    accumulator->mantissa = 0;
+    for (uint8_t i = 0; i < CP_ACCUMULATOR_TAIL_WORDS; i++)
+    {
+        accumulator->tail[i] = 0;
+    }
+    accumulator->exponent = 0;
+    accumulator->expValue = 0;
+    accumulator->digits = 0;
+    accumulator->tailDigits = 0;
+    accumulator->sticky = FALSE;
+    accumulator->length = 0;
+    accumulator->phase = NUMBER_PHASE_SIGN;
+    accumulator->hasDigits = FALSE;
+    accumulator->sign = 1;
+    accumulator->expSign = 1;
+    accumulator->letter = '\0';
+}
+
+/**
+ * @brief Consumes the next character of a parameter value.
+ * 
+ * @param accumulator: Pointer to the accumulator.
+ * @param type: Type of the parameter.
+ * @param c: Character to be consumed.
+ * 
+ * @retval FALSE if the character is invalid for the type, TRUE otherwise.
+ */
+Bool_t accumulate(Cp_Accumulator_t *accumulator, Cp_ParamType_t type, char c)
+{
+    uint8_t digit = c - '0';
+    uint8_t phase = accumulator->phase;
+
+    if (accumulator->length < 0xFF)
+    {
+        accumulator->length++;
+    }
+
+    if (type == CP_PARAM_TYPE_LETTER)
+    {
+        accumulator->letter = (accumulator->length == 1) ? c : accumulator->letter;
+        return TRUE;
+    }
+
+    // Sign is only allowed as the first character of the number or the exponent.
+    if (phase == NUMBER_PHASE_SIGN || phase == NUMBER_PHASE_EXPONENT_SIGN)
+    {
+        accumulator->phase++;
+        if (c == '-' || c == '+')
+        {
+            int8_t sign = (c == '-') ? -1 : 1;
+            if (phase == NUMBER_PHASE_SIGN)
+            {
+                accumulator->sign = sign;
+            }
+            else
+            {
+                accumulator->expSign = sign;
+            }
+
+            return TRUE;
+        }
+    }
+
+    if (digit <= 9)
+    {
+        if (accumulator->phase == NUMBER_PHASE_EXPONENT)
+        {
+            if (accumulator->expValue < NUMBER_MAX_EXPONENT_VALUE)
+            {
+                accumulator->expValue = accumulator->expValue * 10 + digit;
+            }
+        }
+        else
+        {
+            accumulator->hasDigits = TRUE;
+
+            // Leading zeros aren't significant. Digits beyond the mantissa
+            //capacity only shift the integral part.
+            if (accumulator->digits < NUMBER_MAX_MANTISSA_DIGITS)
+            {
+                accumulator->mantissa = accumulator->mantissa * 10 + digit;
+                accumulator->digits += (accumulator->mantissa != 0) ? 1 : 0;
+                accumulator->exponent -= (accumulator->phase == NUMBER_PHASE_FRACTION) ? 1 : 0;
+            }
+            else
+            {
+                uint8_t word = accumulator->tailDigits / NUMBER_MAX_MANTISSA_DIGITS;
+
+                accumulator->exponent += (accumulator->phase == NUMBER_PHASE_FRACTION) ? 0 : 1;
+
+                // Dropped digits are kept as far as they can decide the 
+                //rounding of a float.
+                if (word < CP_ACCUMULATOR_TAIL_WORDS)
+                {
+                    accumulator->tail[word] = accumulator->tail[word] * 10 + digit;
+                    accumulator->tailDigits++;
+                }
+                else
+                {
+                    accumulator->sticky |= (digit != 0) ? TRUE : FALSE;
+                }
+            }
+        }
+
+        return TRUE;
+    }
+
+    if (type != CP_PARAM_TYPE_REAL && type != CP_PARAM_TYPE_FIXED)
+    {
+        return FALSE;
+    }
+
+    if (c == '.' && accumulator->phase == NUMBER_PHASE_INTEGRAL)
+    {
+        accumulator->phase = NUMBER_PHASE_FRACTION;
+        return TRUE;
+    }
+
+    if ((c == 'e' || c == 'E') && accumulator->phase <= NUMBER_PHASE_FRACTION)
+    {
+        // Exponent without a mantissa means a mantissa of one.
+        if (!accumulator->hasDigits && accumulator->length == 1)
+        {
+            accumulator->mantissa = 1;
+            accumulator->digits = 1;
+        }
+
+        accumulator->phase = NUMBER_PHASE_EXPONENT_SIGN;
+        accumulator->length = 0;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/**
+ * @brief Completes the parameter value and writes it to the given memory.
+ * 
+ * @param accumulator: Pointer to the accumulator.
+ * @param type: Type of the parameter.
+ * @param data: Pointer to the return value.
+ * @param size: Pointer to the return value memory size.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t finishAccumulator(Cp_Accumulator_t *accumulator, Cp_ParamType_t type, void *data,
+                         uint8_t *size)
+{
+    switch (type)
+    {
+    case CP_PARAM_TYPE_LETTER:
+        *((char *)data) = accumulator->letter;
+        *size = sizeof(char) + 3;
+        return (accumulator->length == 1) ? TRUE : FALSE;
+
+    case CP_PARAM_TYPE_INTEGER:
+        *size = sizeof(int32_t);
+
+        // Same range as Number_ParseInteger; digits beyond the mantissa 
+        //capacity shift the exponent, so such values are out of range too.
+        if (accumulator->exponent != 0 ||
+            accumulator->mantissa > ((accumulator->sign < 0) ? 0x80000000ULL : (uint64_t)INT32_MAX))
+        {
+            return FALSE;
+        }
+
+        *((int32_t *)data) = (accumulator->sign < 0) ? (int32_t)(0U - (uint32_t)accumulator->mantissa)
+                                                     : (int32_t)accumulator->mantissa;
+        return TRUE;
+
+#if CPARSER_CONFIG_REAL
+    case CP_PARAM_TYPE_REAL:
+        // Exponent sign has to be followed by something.
+        if (accumulator->phase >= NUMBER_PHASE_EXPONENT_SIGN && accumulator->length == 0)
+        {
+            return FALSE;
+        }
+
+        // Dropped digits round the same way as in Number_ParseFloat.
+        *((float *)data) = Number_ComposeFloatEx(
+            accumulator->mantissa, accumulator->tail, accumulator->tailDigits,
+            accumulator->sticky, accumulator->exponent + accumulator->expSign * accumulator->expValue,
+            (accumulator->sign < 0) ? TRUE : FALSE);
+        *size = sizeof(float);
+        return TRUE;
+#endif
+
+    case CP_PARAM_TYPE_FIXED:
+    {
+        Bool_t sticky = accumulator->sticky;
+
+        if (accumulator->phase >= NUMBER_PHASE_EXPONENT_SIGN && accumulator->length == 0)
+        {
+            return FALSE;
+        }
+
+        // Dropped digits round the same way as in Number_ParseFixed; the 
+        //first tail word decides the ties and the rest only breaks them.
+        for (uint8_t i = 1; i < CP_ACCUMULATOR_TAIL_WORDS; i++)
+        {
+            sticky |= (accumulator->tail[i] != 0) ? TRUE : FALSE;
+        }
+        *((int32_t *)data) = Number_ComposeFixedEx(
+            accumulator->mantissa, accumulator->tail[0],
+            (accumulator->tailDigits < NUMBER_MAX_MANTISSA_DIGITS) ? accumulator->tailDigits
+                                                                   : NUMBER_MAX_MANTISSA_DIGITS,
+            sticky, accumulator->exponent + accumulator->expSign * accumulator->expValue,
+            (accumulator->sign < 0) ? TRUE : FALSE);
+        *size = sizeof(int32_t);
+        return TRUE;
+    }
+
+    default:
+        return FALSE;
+    }
+}
+
+/**
+ * @brief Decodes a tokenized line; finds the trigger and parses the 
+ * parameter values. Result of a non-empty line is counted in the statistics.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param input: Line char array.
+ * @param fields: Fields of the line.
+ * @param numOfFields: Number of fields.
+ * @param command: Pointer to the command which receives the result.
+ * 
+ * @retval CP_REJECT_REASON_NONE or reason of the rejection.
+ */
+Cp_RejectReason_t decodeFields(const Cp_Parser_t *parser, const char *input,
+                               const Field_t *fields, uint8_t numOfFields,
+                               Cp_Command_t *command)
+{
+    // An empty line has no trigger, but it isn't counted as a rejection.
+    if (numOfFields == 0)
+    {
+        return CP_REJECT_REASON_UNKNOWN_TRIGGER;
+    }
+
+    if (numOfFields == TOKENIZER_FIELD_COUNT_INVALID)
+    {
+        STATS_REJECT(parser, CP_REJECT_REASON_OVERSIZED);
+        return CP_REJECT_REASON_OVERSIZED;
+    }
+
+    // Find trigger.
+    const Cp_Registry_t *registry = getRegistry(parser);
+    TRACE_BEGIN(CP_TRACE_STAGE_LOOKUP, CP_TRACE_NO_TRIGGER);
+    uint16_t position = findTrigger(registry, &input[fields[0].start], fields[0].length);
+    TRACE_END(CP_TRACE_STAGE_LOOKUP, position);
+
+    // If the trigger is not found; reject the line.
+    if (position == NO_TRIGGER)
+    {
+        STATS_REJECT(parser, CP_REJECT_REASON_UNKNOWN_TRIGGER);
+        return CP_REJECT_REASON_UNKNOWN_TRIGGER;
+    }
+
+    const Cp_Trigger_t *trigger = registry->triggerTable[position];
+    const Cp_Binding_t *binding = &registry->bindings[position];
+
+    command->trigger = registry->triggerTable[position];
+    command->position = position;
+    command->present = 0;
+    command->numOfValues = 0;
+
+    // Bind each field to its parameter in a single pass and parse its value.
+    //Fields of unknown parameters and repeated parameters are ignored.
+    TRACE_BEGIN(CP_TRACE_STAGE_DECODE, position);
+    for (uint8_t j = 1; j < numOfFields; j++)
+    {
+        uint8_t i = bindParam(trigger, binding, input[fields[j].start]);
+        uint8_t param_size;
+
+        if (i == NO_PARAM || (command->present & (1UL << i)))
+        {
+            continue;
+        }
+
+        if (!parseValue(&input[fields[j].start + 1], fields[j].length - 1,
+                        trigger->params[i].type, &command->values[command->numOfValues],
+                        &param_size))
+        {
+            TRACE_END(CP_TRACE_STAGE_DECODE, position);
+            STATS_REJECT(parser, CP_REJECT_REASON_MALFORMED_VALUE);
+            return CP_REJECT_REASON_MALFORMED_VALUE;
+        }
+
+        command->params[command->numOfValues] = i;
+        command->numOfValues++;
+        command->present |= 1UL << i;
+    }
+    TRACE_END(CP_TRACE_STAGE_DECODE, position);
+
+    // Every required parameter should be given.
+    if ((command->present & binding->required) != binding->required)
+    {
+        STATS_REJECT(parser, CP_REJECT_REASON_MISSING_PARAM);
+        return CP_REJECT_REASON_MISSING_PARAM;
+    }
+
+    STATS_ACCEPT(parser, position);
+    return CP_REJECT_REASON_NONE;
+}
+
+/**
+ * @brief Checks if the output struct of a typed trigger can hold all of its
+ * parameters. Triggers which aren't typed are always valid.
+ * 
+ * @param trigger: Pointer to the trigger.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t isTypedLayoutValid(const Cp_Trigger_t *trigger)
+{
+    if (!trigger->typedCallback)
+    {
+        return TRUE;
+    }
+
+    if (trigger->outputSize > CPARSER_CONFIG_MAX_OUTPUT_SIZE)
+    {
+        return FALSE;
+    }
+
+    for (uint8_t i = 0; i < trigger->numOfParams; i++)
+    {
+        if (trigger->params[i].offset + getValueSize(trigger->params[i].type) > trigger->outputSize)
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Checks if every parameter of a trigger has a different letter.
+ * 
+ * @param trigger: Pointer to the trigger.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t areLettersUnique(const Cp_Trigger_t *trigger)
+{
+    for (uint8_t i = 1; i < trigger->numOfParams; i++)
+    {
+        for (uint8_t k = 0; k < i; k++)
+        {
+            if (trigger->params[k].letter == trigger->params[i].letter)
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Gets the size of a parameter value in the output struct.
+ * 
+ * @param type: Type of the parameter.
+ * 
+ * @retval Size in bytes.
+ */
+uint8_t getValueSize(Cp_ParamType_t type)
+{
+    switch (type)
+    {
+    case CP_PARAM_TYPE_LETTER:
+        return sizeof(char);
+
+    case CP_PARAM_TYPE_INTEGER:
+    case CP_PARAM_TYPE_FIXED:
+        return sizeof(int32_t);
+
+    default:
+        return sizeof(float);
+    }
+}
+
+/**
+ * @brief Builds the parameter binding of a registered trigger. Letters which
+ * are indexed directly get a bit in the letter mask, their parameter indexes
+ * are kept in the bit order. Letters of a registered trigger are unique.
+ * 
+ * @param registry: Pointer to the registry.
+ * @param position: Position of the trigger in the trigger table.
+ */
+void bindParams(Cp_Registry_t *registry, uint16_t position)
+{
+    const Cp_Trigger_t *trigger = registry->triggerTable[position];
+    Cp_Binding_t *binding = &registry->bindings[position];
+
+    binding->letters = 0;
+    binding->required = 0;
+
+    for (uint8_t i = 0; i < trigger->numOfParams; i++)
+    {
+        uint8_t index = Dictionary_GetKeyIndex(trigger->params[i].letter);
+
+        if (trigger->params[i].required)
+        {
+            binding->required |= 1UL << i;
+        }
+
+        if (index < DICTIONARY_DIRECT_KEY_COUNT)
+        {
+            uint8_t rank = countBits(binding->letters & ((1ULL << index) - 1));
+
+            // Make room for the new letter in the bit order.
+            for (uint8_t k = countBits(binding->letters); k > rank; k--)
+            {
+                binding->params[k] = binding->params[k - 1];
+            }
+
+            binding->params[rank] = i;
+            binding->letters |= 1ULL << index;
+        }
+    }
+}
+
+/**
+ * @brief Finds the parameter of a letter. Letters which are indexed directly
+ * are found in constant time; others are searched in the parameter list.
+ * 
+ * @param trigger: Pointer to the trigger.
+ * @param binding: Pointer to the parameter binding of the trigger.
+ * @param letter: Letter of the parameter.
+ * 
+ * @retval NO_PARAM or index of the parameter.
+ */
+uint8_t bindParam(const Cp_Trigger_t *trigger, const Cp_Binding_t *binding, char letter)
+{
+    uint8_t index = Dictionary_GetKeyIndex(letter);
+
+    if (index < DICTIONARY_DIRECT_KEY_COUNT)
+    {
+        uint64_t bit = 1ULL << index;
+
+        if (!(binding->letters & bit))
+        {
+            return NO_PARAM;
+        }
+
+        return binding->params[countBits(binding->letters & (bit - 1))];
+    }
+
+    for (uint8_t i = 0; i < trigger->numOfParams; i++)
+    {
+        if (trigger->params[i].letter == letter)
+        {
+            return i;
+        }
+    }
 
-/* Private variables -------------------------------------------------------*/
-static Cp_Trigger_t *TriggerTable[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS];
-static uint16_t NumOfTriggers = 0;
-static Dictionary_t ParameterDictionary;
+    return NO_PARAM;
+}
 
-/* Exported functions ------------------------------------------------------*/
 /**
- * @brief Clears the trigger parser registry.
+ * @brief Counts the set bits of a value.
+ * 
+ * @param value: Value.
+ * 
+ * @retval Number of set bits.
  */
-void Cp_Reset(void)
+uint8_t countBits(uint64_t value)
 {
-    NumOfTriggers = 0;
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (uint8_t)((value * 0x0101010101010101ULL) >> 56);
+#endif
 }
 
 /**
- * @brief Registers a trigger.
+ * @brief Puts a registered trigger into the name index. The index is an open
+ * addressed hash table with linear probing, each slot keeps the registry 
+ * position of a trigger plus one(zero means empty slot). If a trigger with
+ * the same name is already indexed, the earlier one is kept.
  * 
- * @param triggers: Pointer to the trigger array.
- * @param numOfTriggers: Number of triggers to be registered.
+ * @param registry: Pointer to the registry.
+ * @param position: Position of the trigger in the trigger table.
  */
-void Cp_Register(Cp_Trigger_t *triggers, uint16_t numOfTriggers)
+void indexTrigger(Cp_Registry_t *registry, uint16_t position)
 {
-    for (uint16_t i = 0; i < numOfTriggers; i++)
+    const char *name = registry->triggerTable[position]->name;
+    uint8_t name_len = registry->triggerNameLengths[position];
+    uint32_t slot = hashName(name, name_len) % CPARSER_CONFIG_TRIGGER_INDEX_SIZE;
+
+    while (registry->triggerIndex[slot] != 0)
     {
-        TriggerTable[NumOfTriggers++] = &triggers[i];
+        uint16_t indexed = registry->triggerIndex[slot] - 1;
+
+        if (doesMatch(registry->triggerTable[indexed]->name, registry->triggerNameLengths[indexed],
+                      name, name_len))
+        {
+            return;
+        }
+
+        slot = (slot + 1) % CPARSER_CONFIG_TRIGGER_INDEX_SIZE;
     }
+
+    registry->triggerIndex[slot] = position + 1;
 }
 
 /**
- * @brief Feeds line of char array.
+ * @brief Finds the registered trigger whose name matches the input. Cost 
+ * depends on the name length only, not on the number of registered triggers.
  * 
- * @param input: Line char array.
- * @param length: Length of the char array.
+ * @param registry: Pointer to the registry.
+ * @param input: Input char array.
+ * @param length: Length of the input.
  * 
- * @retval TRUE or FALSE.
+ * @retval NO_TRIGGER or position of the trigger.
  */
-uint8_t Cp_FeedLine(char *input, uint16_t length)
+uint16_t findTrigger(const Cp_Registry_t *registry, const char *input, uint8_t length)
 {
-    Field_t fields[MAX_FIELD_COUNT];
-    uint8_t field_count;
-
-    // Parse fields.
-    parseFields(input, length, fields, &field_count);
-    if (field_count == 0)
+    // Longer names can't be registered at all.
+    if (length > CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH)
     {
-        return FALSE;
+        return NO_TRIGGER;
     }
 
-    // Find trigger.
-    Cp_Trigger_t *trigger = NULL;
-    for (uint8_t i = 0; i < NumOfTriggers; i++)
+    return lookupTrigger(registry, hashName(input, length), input, length);
+}
+
+/**
+ * @brief Finds the registered trigger by the precalculated name hash.
+ * 
+ * @param registry: Pointer to the registry.
+ * @param hash: Hash of the name.
+ * @param name: Name char array.
+ * @param length: Length of the name.
+ * 
+ * @retval NO_TRIGGER or position of the trigger.
+ */
+uint16_t lookupTrigger(const Cp_Registry_t *registry, uint32_t hash, const char *name,
+                       uint8_t length)
+{
+    uint32_t slot = hash % CPARSER_CONFIG_TRIGGER_INDEX_SIZE;
+
+    // Probe until an empty slot is hit.
+    while (registry->triggerIndex[slot] != 0)
     {
-        if (doesMatch(TriggerTable[i]->name, &input[fields[0].start],
-                      fields[0].length))
+        uint16_t position = registry->triggerIndex[slot] - 1;
+
+        if (doesMatch(registry->triggerTable[position]->name, registry->triggerNameLengths[position],
+                      name, length))
         {
-            trigger = TriggerTable[i];
-            break;
+            return position;
         }
-    }
 
-    // If the trigger is not found; return FALSE.
-    if (!trigger)
-    {
-        return FALSE;
+        slot = (slot + 1) % CPARSER_CONFIG_TRIGGER_INDEX_SIZE;
     }
 
-    // Clear the dictionary for the current parsing.
-    Dictionary_Clear(&ParameterDictionary);
+    return NO_TRIGGER;
+}
 
-    // Allocate memory for parsed values.
-    uint8_t bulk_data[CPARSER_CONFIG_MAX_NUM_OF_PARAMS * MAX_PARAM_DATA_SIZE];
-    uint16_t bulk_data_size = 0;
+/**
+ * @brief Calculates the hash of a trigger name(32 bit FNV-1a, finished with
+ * the length). Zero length gives the initial value for the incremental 
+ * hashing.
+ * 
+ * @param name: Name char array.
+ * @param length: Length of the name.
+ * 
+ * @retval Hash value.
+ */
+uint32_t hashName(const char *name, uint8_t length)
+{
+    uint32_t hash = 2166136261U;
 
-    // Find params and parse their values.
-    for (uint8_t i = 0; i < trigger->numOfParams; i++)
+    if (length == 0)
     {
-        for (uint8_t j = 1; j < field_count; j++)
-        {
-            uint8_t param_size;
-
-            // If parameter is found; it should be parsed and added to the dictionary. Then next parameter
-            //should be searched.
-            if (input[fields[j].start] == trigger->params[i].letter)
-            {
-                if (parseValue(&input[fields[j].start + 1], fields[j].length - 1,
-                               trigger->params[i].type, &bulk_data[bulk_data_size], &param_size))
-                {
-                    // Add parameter to dictionary.
-                    Dictionary_Add(&ParameterDictionary, trigger->params[i].letter,
-                                   trigger->params[i].type, &bulk_data[bulk_data_size]);
-                    bulk_data_size += param_size;
-
-                    break;
-                }
-                else
-                {
-                    return FALSE;
-                }
-            }
-        }
+        return hash;
     }
 
-    // Call related callback.
-    trigger->callback(&ParameterDictionary);
+    for (uint8_t i = 0; i < length; i++)
+    {
+        hash = hashStep(hash, name[i]);
+    }
 
-    return TRUE;
+    return hashFinish(hash, length);
 }
 
-/* Private functions -------------------------------------------------------*/
 /**
- * @brief Parse fields of the trigger string.
+ * @brief Adds a character to the name hash.
  * 
- * @param input: Trigger line string.
- * @param inputLength: Length of the input line string.
- * @param fields: Pointer to return fields of the line string.
- * @param numOfFields: Pointer to return number of fields.
+ * @param hash: Hash of the previous characters.
+ * @param c: Character to be added.
+ * 
+ * @retval Hash value.
  */
-void parseFields(char *input, uint8_t inputLength, Field_t *fields, uint8_t *numOfFields)
+uint32_t hashStep(uint32_t hash, char c)
 {
-    uint8_t field_count = 0;
-    uint8_t field_start;
-
-    field_start = 0;
-    for (uint8_t i = 0; i < inputLength; i++)
-    {
-        // If seperator found or this is the last element,
-        //this is the end of this field. Besides the next element is first element
-        //of the next field.
-        if ((input[i] == ' ' && field_start < i) || (i == (inputLength - 1) && field_start <= i))
-        {
-            if (i == (inputLength - 1))
-            {
-                fields[field_count].length = i + 1 - field_start;
-            }
-            else
-            {
-                fields[field_count].length = i - field_start;
-            }
-
-            fields[field_count].start = field_start;
-            field_count++;
-            field_start = i + 1;
-        }
-    }
+    return (hash ^ (uint8_t)c) * 16777619U;
+}
 
-    *numOfFields = field_count;
+/**
+ * @brief Mixes the name length into the hash.
+ * 
+ * @param hash: Hash of the characters.
+ * @param length: Length of the name.
+ * 
+ * @retval Hash value.
+ */
+uint32_t hashFinish(uint32_t hash, uint8_t length)
+{
+    return (hash ^ length) * 16777619U;
 }
 
 /**
  * @brief Compare if the input matches to the trigger name.
  * 
- * @param tname: Null terminated trigger name string.
+ * @param tname: Trigger name string.
+ * @param tnameLength: Length of the trigger name.
  * @param input: Input char array.
  * @param length: Length of the input.
  * 
  * @retval TRUE or FALSE.
  */
-Bool_t doesMatch(const char *tname, char *input, uint8_t length)
+Bool_t doesMatch(const char *tname, uint8_t tnameLength, const char *input, uint8_t length)
 {
-    uint8_t name_len = 0;
-
-    // Parse length of the trigger name.
-    name_len = getLength(tname);
-
     // If length of the name isn't equal to field length, return false.
-    if (name_len != length)
+    if (tnameLength != length)
     {
         return FALSE;
     }
@@ -225,27 +1733,40 @@ Bool_t doesMatch(const char *tname, char *input, uint8_t length)
  * 
  * @retval TRUE or FALSE.
  */
-Bool_t parseValue(char *input, uint8_t inputLength, Cp_ParamType_t type, void *data, uint8_t *size)
+Bool_t parseValue(const char *input, uint8_t inputLength, Cp_ParamType_t type, void *data, uint8_t *size)
 {
     Bool_t retval = FALSE;
 
     switch (type)
     {
     case CP_PARAM_TYPE_LETTER:
-        retval = (inputLength == 1) ? TRUE : FALSE;
+        // Value of a letter field without one is past the end of the input.
+        if (inputLength != 1)
+        {
+            break;
+        }
+
+        retval = TRUE;
         *((char *)data) = input[0];
         *size = sizeof(char) + 3;
         break;
 
     case CP_PARAM_TYPE_INTEGER:
-        retval = parseSignedInteger(input, 0, inputLength, data);
+        retval = Number_ParseInteger(input, inputLength, data);
         *size = sizeof(int32_t);
         break;
 
+#if CPARSER_CONFIG_REAL
     case CP_PARAM_TYPE_REAL:
-        retval = parseFloat(input, 0, inputLength, data);
+        retval = Number_ParseFloat(input, inputLength, data);
         *size = sizeof(float);
         break;
+#endif
+
+    case CP_PARAM_TYPE_FIXED:
+        retval = Number_ParseFixed(input, inputLength, data);
+        *size = sizeof(int32_t);
+        break;
 
     default:
         break;
@@ -255,331 +1776,186 @@ Bool_t parseValue(char *input, uint8_t inputLength, Cp_ParamType_t type, void *d
 }
 
 /**
- * @brief Parses the floating point value.
+ * @brief Gets the length of a null terminated string(length except null 
+ * termination)
  * 
- * @param input: Input char array.
- * @param start_idx: Start index of the number.
- * @param length: Length of the char array.
- * @param value: Pointer to the return value.
+ * @param input: Pointer to the string.
  * 
- * @retval TRUE or FALSE.
+ * @retval 0xFF if not found. Length if found.
  */
-Bool_t parseFloat(char *input, uint8_t start_idx, uint8_t length, float *value)
+uint8_t getLength(const char *input)
 {
-    uint8_t e_idx = 0xFF;
-
-    if (length > start_idx)
-    {
-        // Search for scientific notation number.
-        for (uint8_t i = start_idx; i < length; i++)
-        {
-            if ((input[i] == 'e' || input[i] == 'E'))
-            {
-                e_idx = i;
-                break;
-            }
-        }
-
-        // E sign at the end doesn't mean anything. So evaluate as
-        //there isn't any exponent part if it's like that.
-        e_idx = e_idx < length - 1 ? e_idx : 0xFF;
-
-        // If scientific notation has not been used, simply parse the
-        //fractional number.
-        if (e_idx == 0xFF)
-        {
-            if (!parseFractional(input, start_idx, length, value))
-            {
-                return FALSE;
-            }
-        }
-        else
-        {
-            float __value;
-            int32_t power;
-
-            // Parse until e sign.
-            if (e_idx > 0)
-            {
-                if (!parseFractional(input, start_idx, e_idx, &__value))
-                {
-                    return FALSE;
-                }
-            }
-            else
-            {
-                __value = 1.0f;
-            }
-
-            // Parse the exponent.
-            if (!parseSignedInteger(input, (e_idx + 1), length, &power))
-            {
-                return FALSE;
-            }
-
-            uint32_t abspower = power > 0 ? power : -power;
-            for (uint8_t i = 0; i < abspower; i++)
-            {
-                if (power > 0)
-                {
-                    __value *= 10.0f;
-                }
-                else
-                {
-                    __value *= 0.1f;
-                }
-            }
-
-            *value = __value;
-        }
-    }
-    else
+    uint8_t i = 0;
+    while (input[i] != '\0')
     {
-        *value = 0.0f;
+        if (i == 0xFF)
+            break;
+        i++;
     }
 
-    return TRUE;
+    return i;
 }
 
 /**
- * @brief Parses the fractional value.
+ * @brief Decodes a line through the line cache of the parser, if one is 
+ * attached.
  * 
- * @param input: Input char array.
- * @param start_idx: Start index of the number.
+ * @param parser: Pointer to the parser.
+ * @param input: Line char array.
  * @param length: Length of the char array.
- * @param value: Pointer to the return value.
+ * @param command: Pointer to the command which receives the decoded line.
  * 
  * @retval TRUE or FALSE.
  */
-Bool_t parseFractional(char *input, uint8_t start_idx, uint8_t length, float *value)
+Bool_t decodeLine(Cp_Parser_t *parser, const char *input, uint16_t length, Cp_Command_t *command)
 {
-    if (length > start_idx)
-    {
-        uint8_t decimal_point_idx = 0xFF;
-        uint32_t integral = 0;
-        int8_t sign;
-        uint8_t parse_idx;
-        float fraction = 0.0f;
-
-        // Get sign.
-        getSign(input, start_idx, length, &sign, &parse_idx);
-
-        if (parse_idx >= length)
-        {
-            *value = 0.0f;
-            return TRUE;
-        }
-
-        // Search for decimal point.
-        for (uint8_t i = parse_idx; i < length; i++)
-        {
-            if (input[i] == '.')
-            {
-                decimal_point_idx = i;
-                break;
-            }
-        }
-
-        // Parse integral part.
-        uint8_t integral_length;
-        integral_length = decimal_point_idx != 0xFF ? decimal_point_idx : length;
-
-        if (integral_length > parse_idx)
-        {
-            if (!parseUnsignedInteger(input, parse_idx, integral_length, &integral))
-            {
-                return FALSE;
-            }
-        }
-
-        // Parse fractional part. Note that 0xFF is also bigger than any value of the (length - 1) expression.
-        if (decimal_point_idx < length - 1)
-        {
-            uint32_t divisor = 10U;
-
-            // Parse digits.
-            for (uint8_t i = (decimal_point_idx + 1); i < length; i++)
-            {
-                uint8_t digit;
-                digit = input[i] - 48;
-
-                // Tried to parse something which is not a number.
-                if (digit > 9)
-                {
-                    return FALSE;
-                }
+    const Cp_Registry_t *registry = getRegistry(parser);
+    size_t line_length;
 
-                fraction += (float)digit / divisor;
-                divisor *= 10U;
-            }
-        }
+    if (parser->cache == NULL)
+    {
+        return Cp_DecodeLineEx(parser, input, length, command);
+    }
 
-        *value = sign * (((float)integral) + fraction);
+    line_length = findCachedLineEnd(input, length);
+    if (Cp_LineCacheFind(parser->cache, registry, input, line_length, command))
+    {
+        STATS_ACCEPT(parser, command->position);
+        return TRUE;
     }
-    else
+
+    if (!Cp_DecodeLineEx(parser, input, length, command))
     {
-        *value = 0.0f;
+        return FALSE;
     }
 
+    Cp_LineCacheStore(parser->cache, registry, input, line_length, command);
     return TRUE;
 }
 
 /**
- * @brief Parses the signed integer value.
+ * @brief Decodes the first line of a buffer through the line cache of the
+ * parser, if one is attached.
  * 
- * @param input: Input char array.
- * @param start_idx: Start index of the number.
- * @param length: Length of the char array.
- * @param value: Pointer to the return value.
+ * @param parser: Pointer to the parser.
+ * @param buffer: Pointer to the buffer.
+ * @param length: Length of the buffer; should be bigger than zero.
+ * @param command: Pointer to the command which receives the decoded line.
+ * @param status: Pointer to the status of the line.
  * 
- * @retval TRUE or FALSE.
+ * @retval Number of bytes consumed, including the line terminator.
  */
-Bool_t parseSignedInteger(char *input, uint8_t start_idx, uint8_t length, int32_t *value)
+size_t decodeNextLine(Cp_Parser_t *parser, const char *buffer, size_t length,
+                      Cp_Command_t *command, Cp_LineStatus_t *status)
 {
-    if (length > start_idx)
-    {
-        uint32_t __value = 0;
-        int8_t sign = 1;
-        uint8_t parse_idx = 0;
+    const Cp_Registry_t *registry = getRegistry(parser);
+    size_t line_length;
+    size_t consumed;
 
-        getSign(input, start_idx, length, &sign, &parse_idx);
-
-        if (!parseUnsignedInteger(input, parse_idx, length, &__value))
-        {
-            return FALSE;
-        }
+    if (parser->cache == NULL)
+    {
+        return Cp_DecodeNextLineEx(parser, buffer, length, command, status);
+    }
 
-        *value = __value * sign;
+    line_length = findCachedLineEnd(buffer, length);
+    if (Cp_LineCacheFind(parser->cache, registry, buffer, line_length, command))
+    {
+        STATS_ACCEPT(parser, command->position);
+        *status = CP_LINE_STATUS_ACCEPTED;
+        return (line_length < length) ? line_length + 1 : length;
     }
-    else
+
+    consumed = Cp_DecodeNextLineEx(parser, buffer, length, command, status);
+    if (*status == CP_LINE_STATUS_ACCEPTED)
     {
-        *value = 0;
+        Cp_LineCacheStore(parser->cache, registry, buffer, line_length, command);
     }
 
-    return TRUE;
+    return consumed;
 }
 
 /**
- * @brief Parses the unsigned integer value.
+ * @brief Finds the end of a line which may be in the line cache. Only the 
+ * lines which fit into the cache are worth searching the terminator of.
  * 
- * @param input: Input char array.
- * @param start_idx: Start index of the number.
+ * @param input: Line char array.
  * @param length: Length of the char array.
- * @param value: Pointer to the return value.
  * 
- * @retval TRUE or FALSE.
+ * @retval Length of the line without the terminator; longer than 
+ * CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH if it can't be cached.
  */
-Bool_t parseUnsignedInteger(char *input, uint8_t start_idx, uint8_t length,
-                            uint32_t *value)
+size_t findCachedLineEnd(const char *input, size_t length)
 {
-    if (length > start_idx)
-    {
-        uint32_t __value = 0;
-
-        // Parse digits.
-        for (uint8_t i = start_idx; i < length; i++)
-        {
-            uint8_t digit;
-            digit = input[i] - 48;
-
-            // Tried to parse something which is not a number.
-            if (digit > 9)
-            {
-                return FALSE;
-            }
+    const char *end = memchr(input, '\n', (length > CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH)
+                                              ? CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH + 1
+                                              : length);
 
-            __value = __value * 10 + digit;
-        }
-
-        *value = __value;
-    }
-    else
-    {
-        *value = 0;
-    }
-
-    return TRUE;
+    return end ? (size_t)(end - input) : length;
 }
 
 /**
- * @brief Gets the sign of a given value in the given char array.
+ * @brief Validates the framing of a tokenized framed line; its checksum 
+ * field and its line number.
  * 
- * @param input: Char array to be processed.
- * @param start_idx: Start index of the processing.
- * @param length: Window of the process.
- * @param sign: Pointer to return 1 or -1(positive or negative respectively).
- * @param stop_idx: Pointer to return index next to the sign element index.
+ * @param parser: Pointer to the parser.
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * @param stop: Index where the tokenizer stopped.
+ * @param checksum: Checksum of the characters before the stop.
+ * @param fields: Fields of the line.
+ * @param numOfFields: Number of fields.
+ * 
+ * @retval CP_FRAME_STATUS_ACCEPTED if the frame is valid, or the failure.
  */
-void getSign(char *input, uint8_t start_idx, uint8_t length, int8_t *sign, uint8_t *stop_idx)
+Cp_FrameStatus_t checkFrame(Cp_Parser_t *parser, const char *input, uint16_t length,
+                            uint16_t stop, uint8_t checksum, const Field_t *fields,
+                            uint8_t numOfFields)
 {
-    uint8_t parse_idx = start_idx;
-    int8_t __sign = 1;
+    uint16_t end = stop + 1;
+    int32_t value;
 
-    if (length > start_idx)
+    if (stop >= length || input[stop] != '*')
     {
-        if (input[parse_idx] == '-')
-        {
-            parse_idx++;
-            __sign = -1;
-        }
-        else if (input[parse_idx] == '+')
-        {
-            parse_idx++;
-            __sign = 1;
-        }
-
-        cropJerk(input, parse_idx, length, stop_idx);
+        return CP_FRAME_STATUS_MISSING_CHECKSUM;
+    }
 
-        *sign = __sign;
+    // Checksum digits run up to the end of the line; trailing carriage 
+    //return and spaces are allowed.
+    while (end < length && input[end] != '\n')
+    {
+        end++;
     }
-    else
+    while (end > stop + 1 && (input[end - 1] == '\r' || input[end - 1] == ' '))
     {
-        *sign = 1;
+        end--;
     }
-}
 
-/**
- * @brief Crops the meaningless data out of the char array.
- * 
- * @param input: Pointer to the input char array.
- * @param start_idx: Start index of the process.
- * @param length: Window of the process.
- * @param stop_idx: Pointer to the meaningfull data.
- */
-void cropJerk(char *input, uint8_t start_idx, uint8_t length, uint8_t *stop_idx)
-{
-    uint8_t __stop_idx = start_idx;
+    if (end == stop + 1 || end - (stop + 1) > 3 || (uint8_t)(input[stop + 1] - '0') > 9 ||
+        !Number_ParseInteger(&input[stop + 1], (uint8_t)(end - (stop + 1)), &value) ||
+        value > MAX_CHECKSUM)
+    {
+        return CP_FRAME_STATUS_MISSING_CHECKSUM;
+    }
 
-    // Get rid of trailing spaces or zeros.
-    while ((input[__stop_idx] == '0') || input[__stop_idx] == ' ')
+    if ((uint8_t)value != checksum)
     {
-        __stop_idx++;
-        if (__stop_idx == length)
-        {
-            *stop_idx = length - 1;
-        }
+        return CP_FRAME_STATUS_CHECKSUM_MISMATCH;
     }
 
-    *stop_idx = __stop_idx;
-}
+    // Fields of an oversized line aren't reliable, its line number included.
+    if (numOfFields == TOKENIZER_FIELD_COUNT_INVALID)
+    {
+        return CP_FRAME_STATUS_OVERSIZED;
+    }
 
-/**
- * @brief Gets the length of a null terminated string(length except null 
- * termination)
- * 
- * @param input: Pointer to the string.
- * 
- * @retval 0xFF if not found. Length if found.
- */
-uint8_t getLength(const char *input)
-{
-    uint8_t i = 0;
-    while (input[i] != '\0')
+    // Line number is unsigned; it should start with a digit.
+    if (numOfFields == 0 || fields[0].length < 2 || input[fields[0].start] != 'N' ||
+        (uint8_t)(input[fields[0].start + 1] - '0') > 9 ||
+        !Number_ParseInteger(&input[fields[0].start + 1], fields[0].length - 1, &value))
     {
-        if (i == 0xFF)
-            break;
-        i++;
+        return CP_FRAME_STATUS_MISSING_LINE_NUMBER;
     }
 
-    return i;
-}
\ No newline at end of file
+    return ((uint32_t)value == parser->lineNumber) ? CP_FRAME_STATUS_ACCEPTED
+                                                   : CP_FRAME_STATUS_LINE_NUMBER_MISMATCH;
+}
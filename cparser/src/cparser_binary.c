@@ -0,0 +1,356 @@
+/**
+ * @file cparser_binary.c
+ * 
+ * Binary command encoding module. Frames are decoded into the same 
+ * Cp_Command_t as the text lines, so they are dispatched through the same 
+ * triggers and callbacks; only the tokenizing and the number parsing are 
+ * skipped.
+ */
+#include "../inc/cparser_binary.h"
+#include "../inc/cparser_internal.h"
+#include "string.h"
+
+/* Private constants -------------------------------------------------------*/
+#define HEADER_SIZE (1 + 2 + CP_BINARY_PRESENCE_SIZE)
+
+/* Frames can't be longer than the length byte can express. */
+#if CP_BINARY_MAX_FRAME_SIZE > 256
+#error "CPARSER_CONFIG_MAX_NUM_OF_PARAMS is too big for the binary frames"
+#endif
+
+/* Private function prototypes ---------------------------------------------*/
+static uint8_t getEncodedSize(Cp_ParamType_t type);
+static uint32_t getWireValue(const uint32_t *value, Cp_ParamType_t type);
+static void setWireValue(uint32_t *value, Cp_ParamType_t type, uint32_t wireValue);
+static void writeValue(uint8_t *output, uint32_t value, uint8_t size);
+static uint32_t readValue(const uint8_t *input, uint8_t size);
+static Cp_RejectReason_t decodeFrame(const Cp_Registry_t *registry, const uint8_t *frame,
+                                     size_t frameSize, Cp_Command_t *command);
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Encodes a decoded command into a frame.
+ * 
+ * @param command: Pointer to the command.
+ * @param output: Pointer to the output buffer.
+ * @param size: Size of the output buffer.
+ * 
+ * @retval Size of the frame, zero if it doesn't fit into the buffer.
+ */
+size_t Cp_EncodeCommand(const Cp_Command_t *command, uint8_t *output, size_t size)
+{
+    const Cp_Trigger_t *trigger = command->trigger;
+    uint8_t values[CPARSER_CONFIG_MAX_NUM_OF_PARAMS];
+    size_t frame_size = HEADER_SIZE;
+
+    // Values are kept in the field order, frames keep them in the parameter
+    //order.
+    for (uint8_t i = 0; i < command->numOfValues; i++)
+    {
+        values[command->params[i]] = i;
+        frame_size += getEncodedSize(trigger->params[command->params[i]].type);
+    }
+
+    if (frame_size > size)
+    {
+        return 0;
+    }
+
+    output[0] = (uint8_t)(frame_size - 1);
+    writeValue(&output[1], command->position, 2);
+    writeValue(&output[3], command->present, CP_BINARY_PRESENCE_SIZE);
+
+    uint8_t *cursor = &output[HEADER_SIZE];
+    for (uint8_t p = 0; p < trigger->numOfParams; p++)
+    {
+        if (command->present & (1UL << p))
+        {
+            uint8_t value_size = getEncodedSize(trigger->params[p].type);
+
+            writeValue(cursor, getWireValue(&command->values[values[p]], trigger->params[p].type),
+                       value_size);
+            cursor += value_size;
+        }
+    }
+
+    return frame_size;
+}
+
+/**
+ * @brief Transcodes a text line into a frame.
+ * 
+ * @param parser: Pointer to the parser which decodes the line.
+ * @param input: Line char array.
+ * @param length: Length of the char array.
+ * @param output: Pointer to the output buffer.
+ * @param size: Size of the output buffer.
+ * 
+ * @retval Size of the frame, zero if the line is rejected or the frame 
+ * doesn't fit into the buffer.
+ */
+size_t Cp_TranscodeLineEx(const Cp_Parser_t *parser, const char *input, uint16_t length,
+                          uint8_t *output, size_t size)
+{
+    Cp_Command_t command;
+
+    if (!Cp_DecodeLineEx(parser, input, length, &command))
+    {
+        return 0;
+    }
+
+    return Cp_EncodeCommand(&command, output, size);
+}
+
+/**
+ * @brief Decodes the first frame of a buffer without invoking its callback.
+ * Parser is only read.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param frame: Pointer to the buffer.
+ * @param length: Length of the buffer.
+ * @param command: Pointer to the command which receives the decoded frame.
+ * @param status: Pointer to the status of the frame; frames with zero length
+ * are empty.
+ * 
+ * @retval Number of bytes consumed, zero if the buffer doesn't hold the 
+ * whole frame.
+ */
+size_t Cp_DecodeFrameEx(const Cp_Parser_t *parser, const uint8_t *frame, size_t length,
+                        Cp_Command_t *command, Cp_LineStatus_t *status)
+{
+    Cp_RejectReason_t reason;
+    size_t frame_size;
+    STATS_START(start);
+
+    if (length == 0 || (size_t)frame[0] + 1 > length)
+    {
+        return 0;
+    }
+
+    frame_size = (size_t)frame[0] + 1;
+    if (frame_size == 1)
+    {
+        *status = CP_LINE_STATUS_EMPTY;
+        return frame_size;
+    }
+
+    // Frames are counted in the statistics like the lines.
+    reason = decodeFrame(getRegistry(parser), frame, frame_size, command);
+    if (reason == CP_REJECT_REASON_NONE)
+    {
+        *status = CP_LINE_STATUS_ACCEPTED;
+        STATS_ACCEPT(parser, command->position);
+    }
+    else
+    {
+        *status = CP_LINE_STATUS_REJECTED;
+        STATS_REJECT(parser, reason);
+    }
+    STATS_PARSE_TIME(parser, start);
+
+    return frame_size;
+}
+
+/**
+ * @brief Feeds a buffer of frames; each one is dispatched like 
+ * Cp_FeedBufferEx does with the lines. A frame which is cut at the end of 
+ * the buffer is rejected.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param buffer: Pointer to the buffer.
+ * @param length: Length of the buffer.
+ * 
+ * @retval Numbers of the accepted and rejected frames.
+ */
+Cp_FeedResult_t Cp_FeedFramesEx(Cp_Parser_t *parser, const uint8_t *buffer, size_t length)
+{
+    Cp_FeedResult_t result = {0, 0};
+    Cp_Command_t command;
+    Cp_LineStatus_t status;
+    size_t offset = 0;
+
+    while (offset < length)
+    {
+        size_t consumed;
+
+        lockRegistry(parser);
+        consumed = Cp_DecodeFrameEx(parser, &buffer[offset], length - offset, &command, &status);
+        unlockRegistry(parser);
+
+        if (consumed == 0)
+        {
+            STATS_REJECT(parser, CP_REJECT_REASON_MALFORMED_VALUE);
+            result.rejected++;
+            break;
+        }
+
+        offset += consumed;
+        if (status == CP_LINE_STATUS_ACCEPTED && dispatch(parser, &command))
+        {
+            result.accepted++;
+        }
+        else if (status != CP_LINE_STATUS_EMPTY)
+        {
+            result.rejected++;
+        }
+    }
+
+    return result;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Decodes a whole frame.
+ * 
+ * @param registry: Pointer to the registry which decodes the frame.
+ * @param frame: Pointer to the frame.
+ * @param frameSize: Size of the frame, including the length byte.
+ * @param command: Pointer to the command which receives the decoded frame.
+ * 
+ * @retval Reason of the rejection, CP_REJECT_REASON_NONE if the frame is 
+ * accepted.
+ */
+Cp_RejectReason_t decodeFrame(const Cp_Registry_t *registry, const uint8_t *frame,
+                              size_t frameSize, Cp_Command_t *command)
+{
+    if (frameSize < HEADER_SIZE)
+    {
+        return CP_REJECT_REASON_MALFORMED_VALUE;
+    }
+
+    uint16_t position = (uint16_t)readValue(&frame[1], 2);
+    uint32_t present = readValue(&frame[3], CP_BINARY_PRESENCE_SIZE);
+
+    if (position >= registry->numOfTriggers)
+    {
+        return CP_REJECT_REASON_UNKNOWN_TRIGGER;
+    }
+
+    const Cp_Trigger_t *trigger = registry->triggerTable[position];
+    uint32_t required = registry->bindings[position].required;
+    const uint8_t *cursor = &frame[HEADER_SIZE];
+    const uint8_t *end = &frame[frameSize];
+
+    // Every given parameter should be known and every required one given.
+    if (trigger->numOfParams < 32 && (present >> trigger->numOfParams) != 0)
+    {
+        return CP_REJECT_REASON_MALFORMED_VALUE;
+    }
+
+    if ((present & required) != required)
+    {
+        return CP_REJECT_REASON_MISSING_PARAM;
+    }
+
+    command->trigger = registry->triggerTable[position];
+    command->position = position;
+    command->present = present;
+    command->numOfValues = 0;
+
+    for (uint8_t p = 0; p < trigger->numOfParams; p++)
+    {
+        if (present & (1UL << p))
+        {
+            uint8_t value_size = getEncodedSize(trigger->params[p].type);
+
+            if (cursor + value_size > end)
+            {
+                return CP_REJECT_REASON_MALFORMED_VALUE;
+            }
+
+            setWireValue(&command->values[command->numOfValues], trigger->params[p].type,
+                         readValue(cursor, value_size));
+            command->params[command->numOfValues] = p;
+            command->numOfValues++;
+            cursor += value_size;
+        }
+    }
+
+    // Length should match the given values exactly.
+    return (cursor == end) ? CP_REJECT_REASON_NONE : CP_REJECT_REASON_MALFORMED_VALUE;
+}
+
+/**
+ * @brief Gets the size of a parameter value in a frame.
+ * 
+ * @param type: Type of the parameter.
+ * 
+ * @retval Size in bytes.
+ */
+uint8_t getEncodedSize(Cp_ParamType_t type)
+{
+    return (type == CP_PARAM_TYPE_LETTER) ? 1 : 4;
+}
+
+/**
+ * @brief Gets the value which is written to a frame. A letter is kept in 
+ * the first byte of its storage, others are kept as 32 bit words.
+ * 
+ * @param value: Pointer to the storage of the value.
+ * @param type: Type of the parameter.
+ * 
+ * @retval Value.
+ */
+uint32_t getWireValue(const uint32_t *value, Cp_ParamType_t type)
+{
+    if (type == CP_PARAM_TYPE_LETTER)
+    {
+        return (uint8_t)(*(const char *)value);
+    }
+
+    return *value;
+}
+
+/**
+ * @brief Sets the storage of a value which is read from a frame.
+ * 
+ * @param value: Pointer to the storage of the value.
+ * @param type: Type of the parameter.
+ * @param wireValue: Value.
+ */
+void setWireValue(uint32_t *value, Cp_ParamType_t type, uint32_t wireValue)
+{
+    if (type == CP_PARAM_TYPE_LETTER)
+    {
+        *value = 0;
+        *(char *)value = (char)wireValue;
+        return;
+    }
+
+    *value = wireValue;
+}
+
+/**
+ * @brief Writes a value in little endian byte order.
+ * 
+ * @param output: Pointer to the output.
+ * @param value: Value.
+ * @param size: Number of bytes to be written.
+ */
+void writeValue(uint8_t *output, uint32_t value, uint8_t size)
+{
+    for (uint8_t i = 0; i < size; i++)
+    {
+        output[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Reads a value in little endian byte order.
+ * 
+ * @param input: Pointer to the input.
+ * @param size: Number of bytes to be read.
+ * 
+ * @retval Value.
+ */
+uint32_t readValue(const uint8_t *input, uint8_t size)
+{
+    uint32_t value = 0;
+
+    for (uint8_t i = 0; i < size; i++)
+    {
+        value |= (uint32_t)input[i] << (8 * i);
+    }
+
+    return value;
+}
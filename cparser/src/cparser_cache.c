@@ -0,0 +1,165 @@
+/**
+ * @file cparser_cache.c
+ * 
+ * Line cache module. A line is hashed a word at a time and looked up in a 
+ * single slot; its bytes are compared before a hit is reported, so hash 
+ * collisions only cost a miss.
+ */
+#include "../inc/cparser_cache.h"
+#include "string.h"
+
+/* Private constants -------------------------------------------------------*/
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+#if (CPARSER_CONFIG_LINE_CACHE_SIZE & (CPARSER_CONFIG_LINE_CACHE_SIZE - 1)) != 0
+#error "CPARSER_CONFIG_LINE_CACHE_SIZE should be a power of two"
+#endif
+
+#if CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH > 255
+#error "CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH should be less than 256"
+#endif
+
+/* Private function prototypes ---------------------------------------------*/
+static uint32_t hashLine(const char *line, size_t length);
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Empties the cache and clears its counters.
+ * 
+ * @param cache: Pointer to the cache.
+ */
+void Cp_LineCacheInit(Cp_LineCache_t *cache)
+{
+    memset(cache, 0, sizeof(Cp_LineCache_t));
+}
+
+/**
+ * @brief Finds a line which has been decoded with the current state of a 
+ * registry. Called by the feed functions of the parser which has the cache
+ * attached.
+ * 
+ * @param cache: Pointer to the cache.
+ * @param registry: Pointer to the registry which decodes the line.
+ * @param line: Line char array, without the terminator.
+ * @param length: Length of the line.
+ * @param command: Pointer to the command which receives the cached line.
+ * 
+ * @retval TRUE if found, FALSE otherwise.
+ */
+Bool_t Cp_LineCacheFind(Cp_LineCache_t *cache, const Cp_Registry_t *registry, const char *line,
+                        size_t length, Cp_Command_t *command)
+{
+    const Cp_LineCacheEntry_t *entry;
+    uint32_t hash;
+
+    if (length > CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH)
+    {
+        return FALSE;
+    }
+
+    hash = hashLine(line, length);
+    entry = &cache->entries[hash & (CPARSER_CONFIG_LINE_CACHE_SIZE - 1)];
+
+    // Registries change their generation with every modification.
+    if (entry->hash != hash || entry->length != length || entry->registry != registry ||
+        entry->generation != registry->generation || memcmp(entry->line, line, length) != 0)
+    {
+        cache->misses++;
+        return FALSE;
+    }
+
+    memcpy(command, &entry->command, sizeof(Cp_Command_t));
+    cache->hits++;
+
+    return TRUE;
+}
+
+/**
+ * @brief Stores an accepted line, replacing the one in its slot. Lines 
+ * longer than CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH aren't stored.
+ * 
+ * @param cache: Pointer to the cache.
+ * @param registry: Pointer to the registry which decoded the line.
+ * @param line: Line char array, without the terminator.
+ * @param length: Length of the line.
+ * @param command: Pointer to the decoded line.
+ */
+void Cp_LineCacheStore(Cp_LineCache_t *cache, const Cp_Registry_t *registry, const char *line,
+                       size_t length, const Cp_Command_t *command)
+{
+    Cp_LineCacheEntry_t *entry;
+    uint32_t hash;
+
+    if (length > CPARSER_CONFIG_LINE_CACHE_MAX_LENGTH)
+    {
+        return;
+    }
+
+    hash = hashLine(line, length);
+    entry = &cache->entries[hash & (CPARSER_CONFIG_LINE_CACHE_SIZE - 1)];
+
+    entry->registry = registry;
+    entry->generation = registry->generation;
+    entry->hash = hash;
+    entry->length = (uint8_t)length;
+    memcpy(entry->line, line, length);
+    memcpy(&entry->command, command, sizeof(Cp_Command_t));
+}
+
+/**
+ * @brief Gets the number of lines which have been dispatched from the cache.
+ * 
+ * @param cache: Pointer to the cache.
+ * 
+ * @retval Number of hits.
+ */
+size_t Cp_LineCacheGetHits(const Cp_LineCache_t *cache)
+{
+    return cache->hits;
+}
+
+/**
+ * @brief Gets the number of lines which have been looked up and parsed.
+ * 
+ * @param cache: Pointer to the cache.
+ * 
+ * @retval Number of misses.
+ */
+size_t Cp_LineCacheGetMisses(const Cp_LineCache_t *cache)
+{
+    return cache->misses;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Hashes the line bytes eight at a time.
+ * 
+ * @param line: Line char array.
+ * @param length: Length of the line.
+ * 
+ * @retval Hash of the line.
+ */
+uint32_t hashLine(const char *line, size_t length)
+{
+    uint64_t hash = (uint64_t)length * HASH_MULTIPLIER;
+    uint64_t word;
+
+    while (length >= 8)
+    {
+        memcpy(&word, line, 8);
+        hash = (hash ^ word) * HASH_MULTIPLIER;
+        hash ^= hash >> 29;
+        line += 8;
+        length -= 8;
+    }
+
+    if (length > 0)
+    {
+        word = 0;
+        memcpy(&word, line, length);
+        hash = (hash ^ word) * HASH_MULTIPLIER;
+        hash ^= hash >> 29;
+    }
+
+    return (uint32_t)(hash >> 32);
+}
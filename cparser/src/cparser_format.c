@@ -0,0 +1,219 @@
+/**
+ * @file cparser_format.c
+ * 
+ * Response formatter module. Fields are written straight into the buffer of
+ * the application without any allocation or printf; integers two digits at 
+ * a time, reals and fixed point values as the shortest digits which parse 
+ * back to the same value, so formatting and parsing a value round trips 
+ * exactly.
+ */
+#include "../inc/cparser_format.h"
+#include "../inc/number.h"
+#include "string.h"
+
+/* Private constants -------------------------------------------------------*/
+/* Separator, letter and the longest value of a field. */
+#define MAX_FIELD_LENGTH (2 + NUMBER_MAX_FIXED_LENGTH)
+
+/* Private function prototypes ---------------------------------------------*/
+static size_t writeName(const char *name, char *output, size_t size);
+static size_t writeField(char letter, Cp_ParamType_t type, const void *value, char *output,
+                         size_t length, size_t size);
+static uint8_t formatField(char letter, Cp_ParamType_t type, const void *value, char *output);
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Formats a trigger name and the elements of a dictionary, in the
+ * order they are added.
+ * 
+ * @param name: Null terminated trigger name.
+ * @param dictionary: Pointer to the parameters.
+ * @param output: Pointer to the output buffer.
+ * @param size: Size of the output buffer.
+ * 
+ * @retval Length of the null terminated line, zero if it doesn't fit into 
+ * the buffer or a value can't be written(infinity or NaN).
+ */
+size_t Cp_Format(const char *name, const Dictionary_t *dictionary, char *output, size_t size)
+{
+    size_t length = writeName(name, output, size);
+
+    for (uint8_t i = 0; (i < dictionary->numberOfElements) && (length != 0); i++)
+    {
+        length = writeField(dictionary->keys[i], dictionary->types[i], dictionary->values[i],
+                            output, length, size);
+    }
+
+    return length;
+}
+
+/**
+ * @brief Formats the output struct of a typed trigger.
+ * 
+ * @param trigger: Pointer to the typed trigger.
+ * @param input: Pointer to the struct.
+ * @param present: Bit per parameter to be written, in parameter order.
+ * @param output: Pointer to the output buffer.
+ * @param size: Size of the output buffer.
+ * 
+ * @retval Length of the null terminated line, zero if it doesn't fit into 
+ * the buffer or a value can't be written(infinity or NaN).
+ */
+size_t Cp_FormatTyped(const Cp_Trigger_t *trigger, const void *input, uint32_t present,
+                      char *output, size_t size)
+{
+    size_t length = writeName(trigger->name, output, size);
+
+    for (uint8_t p = 0; (p < trigger->numOfParams) && (length != 0); p++)
+    {
+        const Cp_Param_t *param = &trigger->params[p];
+
+        if (present & (1UL << p))
+        {
+            length = writeField(param->letter, param->type,
+                                (const uint8_t *)input + param->offset, output, length, size);
+        }
+    }
+
+    return length;
+}
+
+/**
+ * @brief Formats a decoded command, e.g. to log or forward it.
+ * 
+ * @param command: Pointer to the command.
+ * @param output: Pointer to the output buffer.
+ * @param size: Size of the output buffer.
+ * 
+ * @retval Length of the null terminated line, zero if it doesn't fit into 
+ * the buffer or a value can't be written(infinity or NaN).
+ */
+size_t Cp_FormatCommand(const Cp_Command_t *command, char *output, size_t size)
+{
+    const Cp_Trigger_t *trigger = command->trigger;
+    size_t length = writeName(trigger->name, output, size);
+
+    for (uint8_t i = 0; (i < command->numOfValues) && (length != 0); i++)
+    {
+        const Cp_Param_t *param = &trigger->params[command->params[i]];
+
+        length = writeField(param->letter, param->type, &command->values[i], output, length,
+                            size);
+    }
+
+    return length;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Writes the trigger name and the null termination.
+ * 
+ * @retval Length of the name, zero if it doesn't fit.
+ */
+size_t writeName(const char *name, char *output, size_t size)
+{
+    size_t length = strlen(name);
+
+    if (length == 0 || length + 1 > size)
+    {
+        return 0;
+    }
+
+    memcpy(output, name, length);
+    output[length] = '\0';
+
+    return length;
+}
+
+/**
+ * @brief Appends a field and moves the null termination after it.
+ * 
+ * @param letter: Letter of the parameter.
+ * @param type: Type of the parameter.
+ * @param value: Pointer to the value.
+ * @param output: Pointer to the output buffer.
+ * @param length: Length of the line so far.
+ * @param size: Size of the output buffer.
+ * 
+ * @retval New length of the line, zero if the field doesn't fit or can't be 
+ * written.
+ */
+size_t writeField(char letter, Cp_ParamType_t type, const void *value, char *output,
+                  size_t length, size_t size)
+{
+    uint8_t field_length;
+
+    if (size - length > MAX_FIELD_LENGTH)
+    {
+        // Longest field fits; written in place.
+        field_length = formatField(letter, type, value, &output[length]);
+    }
+    else
+    {
+        char field[MAX_FIELD_LENGTH];
+
+        field_length = formatField(letter, type, value, field);
+        if (length + field_length + 1 > size)
+        {
+            return 0;
+        }
+        memcpy(&output[length], field, field_length);
+    }
+
+    if (field_length == 0)
+    {
+        return 0;
+    }
+
+    length += field_length;
+    output[length] = '\0';
+
+    return length;
+}
+
+/**
+ * @brief Writes " <letter><value>" without the null termination.
+ * 
+ * @retval Length of the field, zero if the value can't be written.
+ */
+uint8_t formatField(char letter, Cp_ParamType_t type, const void *value, char *output)
+{
+    uint8_t value_length = 0;
+    int32_t integer;
+#if CPARSER_CONFIG_REAL
+    float real;
+#endif
+
+    output[0] = ' ';
+    output[1] = letter;
+
+    switch (type)
+    {
+    case CP_PARAM_TYPE_LETTER:
+        output[2] = *(const char *)value;
+        value_length = 1;
+        break;
+
+    case CP_PARAM_TYPE_INTEGER:
+        memcpy(&integer, value, sizeof(integer));
+        value_length = Number_FormatInteger(integer, &output[2]);
+        break;
+
+#if CPARSER_CONFIG_REAL
+    case CP_PARAM_TYPE_REAL:
+        memcpy(&real, value, sizeof(real));
+        value_length = Number_FormatFloat(real, &output[2]);
+        break;
+#endif
+
+    case CP_PARAM_TYPE_FIXED:
+        memcpy(&integer, value, sizeof(integer));
+        value_length = Number_FormatFixed(integer, &output[2]);
+        break;
+
+    default:
+        break;
+    }
+
+    return (value_length == 0) ? 0 : (uint8_t)(2 + value_length);
+}
@@ -0,0 +1,422 @@
+/**
+ * @file cparser_parallel.c
+ * 
+ * Parallel batch parsing module.
+ */
+#include "../inc/cparser_parallel.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Private constants -------------------------------------------------------*/
+#define MAX_NUM_OF_THREADS 64
+#define SLOTS_PER_THREAD 2
+#define INITIAL_SLOT_CAPACITY 256
+
+/* Private typedefs --------------------------------------------------------*/
+/* Decoded commands of a chunk which are waiting for the ordered dispatch. */
+typedef struct
+{
+    Cp_Command_t *commands;
+    size_t numOfCommands;
+    size_t capacity;
+    size_t rejected;
+    atomic_size_t chunk; /* Index of the chunk in the slot plus one, zero if none. */
+} Slot_t;
+
+/* State shared by the threads of a parallel feed. */
+typedef struct
+{
+    const Cp_Parser_t *parser;
+    const char *buffer;
+    size_t length;
+    size_t chunkSize;
+    size_t numOfChunks;
+    Bool_t unordered;
+    Slot_t *slots;
+    size_t numOfSlots;
+    atomic_size_t nextChunk;    /* Next chunk to be claimed by a thread. */
+    atomic_size_t nextDispatch; /* Next chunk to be dispatched. */
+    atomic_flag dispatching;    /* Held by the thread which dispatches. */
+    atomic_size_t accepted;
+    atomic_size_t rejected;
+} Job_t;
+
+/* Private function prototypes ---------------------------------------------*/
+static void *work(void *arg);
+static void getChunkBounds(const Job_t *job, size_t chunk, size_t *begin, size_t *end);
+static size_t findLineStart(const Job_t *job, size_t offset);
+static void feedChunk(Job_t *job, size_t chunk);
+static void decodeChunk(Job_t *job, size_t chunk);
+static void dispatchReady(Job_t *job);
+static Bool_t reserveCommand(Slot_t *slot);
+static uint16_t getNumOfThreads(const Cp_ParallelConfig_t *config, size_t numOfChunks);
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Feeds a buffer of lines which are separated by new line characters,
+ * using several threads. Lines are handled like Cp_FeedBufferEx does. Chunks
+ * of the buffer are claimed by the threads dynamically, so a thread which
+ * gets easy chunks takes over the rest of the work.
+ * In ordered mode callbacks are invoked one at a time in the line order, but
+ * not necessarily from the calling thread. Decoded lines of at most two
+ * chunks per thread are kept in memory; lines which can't be kept because of
+ * memory exhaustion are counted as rejected. In unordered mode callbacks are
+ * invoked concurrently, right after their line is decoded.
+ * Queue and line cache of the parser aren't used; commands are dispatched
+ * directly even if a queue is attached.
+ * 
+ * @param parser: Pointer to the parser. It is only read; triggers shouldn't be
+ * registered during the call.
+ * @param buffer: Pointer to the buffer.
+ * @param length: Length of the buffer.
+ * @param config: Pointer to the options, NULL for the defaults.
+ * 
+ * @retval Numbers of the accepted and rejected lines.
+ */
+Cp_FeedResult_t Cp_FeedBufferParallel(const Cp_Parser_t *parser, const char *buffer,
+                                      size_t length, const Cp_ParallelConfig_t *config)
+{
+    static const Cp_ParallelConfig_t defaults = {0, 0, FALSE};
+    Cp_FeedResult_t result = {0, 0};
+    pthread_t threads[MAX_NUM_OF_THREADS];
+    uint16_t num_of_threads;
+    uint16_t started = 0;
+    Job_t job;
+
+    if (!config)
+    {
+        config = &defaults;
+    }
+
+    job.parser = parser;
+    job.buffer = buffer;
+    job.length = length;
+    job.chunkSize = config->chunkSize ? config->chunkSize : CPARSER_CONFIG_PARALLEL_CHUNK_SIZE;
+    job.numOfChunks = (length + job.chunkSize - 1) / job.chunkSize;
+    job.unordered = config->unordered;
+    job.slots = NULL;
+    job.numOfSlots = 0;
+    atomic_init(&job.nextChunk, 0);
+    atomic_init(&job.nextDispatch, 0);
+    atomic_flag_clear(&job.dispatching);
+    atomic_init(&job.accepted, 0);
+    atomic_init(&job.rejected, 0);
+
+    num_of_threads = getNumOfThreads(config, job.numOfChunks);
+
+    if (!job.unordered)
+    {
+        job.numOfSlots = (size_t)num_of_threads * SLOTS_PER_THREAD;
+        job.slots = calloc(job.numOfSlots, sizeof(Slot_t));
+
+        for (size_t i = 0; job.slots && i < job.numOfSlots; i++)
+        {
+            atomic_init(&job.slots[i].chunk, 0);
+        }
+
+        // Without the slots, lines are fed by the caller alone which keeps
+        //the order as well.
+        if (!job.slots)
+        {
+            job.unordered = TRUE;
+            num_of_threads = 1;
+        }
+    }
+
+    // Caller is one of the workers.
+    while (started < num_of_threads - 1 &&
+           pthread_create(&threads[started], NULL, work, &job) == 0)
+    {
+        started++;
+    }
+
+    work(&job);
+
+    for (uint16_t i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (job.slots)
+    {
+        for (size_t i = 0; i < job.numOfSlots; i++)
+        {
+            free(job.slots[i].commands);
+        }
+
+        free(job.slots);
+    }
+
+    result.accepted = atomic_load(&job.accepted);
+    result.rejected = atomic_load(&job.rejected);
+    return result;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Worker thread; claims chunks until none is left.
+ * 
+ * @param arg: Pointer to the job.
+ * 
+ * @retval NULL.
+ */
+void *work(void *arg)
+{
+    Job_t *job = (Job_t *)arg;
+    size_t chunk;
+
+    while ((chunk = atomic_fetch_add(&job->nextChunk, 1)) < job->numOfChunks)
+    {
+        if (job->unordered)
+        {
+            feedChunk(job, chunk);
+        }
+        else
+        {
+            decodeChunk(job, chunk);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Gets the bounds of a chunk. A chunk owns the lines which start in
+ * its nominal range, so the lines crossing the range end are completed by the
+ * chunk they start in.
+ * 
+ * @param job: Pointer to the job.
+ * @param chunk: Index of the chunk.
+ * @param begin: Pointer to the offset of the first line.
+ * @param end: Pointer to the offset after the last line start.
+ */
+void getChunkBounds(const Job_t *job, size_t chunk, size_t *begin, size_t *end)
+{
+    *begin = findLineStart(job, chunk * job->chunkSize);
+    *end = findLineStart(job, (chunk + 1) * job->chunkSize);
+}
+
+/**
+ * @brief Finds the first line start at or after an offset.
+ * 
+ * @param job: Pointer to the job.
+ * @param offset: Offset in the buffer.
+ * 
+ * @retval Offset of the line start, or the buffer length.
+ */
+size_t findLineStart(const Job_t *job, size_t offset)
+{
+    const char *terminator;
+
+    if (offset == 0)
+    {
+        return 0;
+    }
+
+    if (offset >= job->length)
+    {
+        return job->length;
+    }
+
+    terminator = memchr(&job->buffer[offset - 1], '\n', job->length - offset + 1);
+    return terminator ? (size_t)(terminator - job->buffer) + 1 : job->length;
+}
+
+/**
+ * @brief Decodes lines of a chunk and invokes their callbacks immediately.
+ * 
+ * @param job: Pointer to the job.
+ * @param chunk: Index of the chunk.
+ */
+void feedChunk(Job_t *job, size_t chunk)
+{
+    Cp_Command_t command;
+    Cp_LineStatus_t status;
+    size_t accepted = 0;
+    size_t rejected = 0;
+    size_t offset;
+    size_t end;
+
+    getChunkBounds(job, chunk, &offset, &end);
+
+    while (offset < end)
+    {
+        offset += Cp_DecodeNextLineEx(job->parser, &job->buffer[offset], job->length - offset,
+                                      &command, &status);
+
+        if (status == CP_LINE_STATUS_ACCEPTED)
+        {
+            Cp_DispatchCommandEx(job->parser, &command);
+            accepted++;
+        }
+        else if (status == CP_LINE_STATUS_REJECTED)
+        {
+            rejected++;
+        }
+    }
+
+    atomic_fetch_add_explicit(&job->accepted, accepted, memory_order_relaxed);
+    atomic_fetch_add_explicit(&job->rejected, rejected, memory_order_relaxed);
+}
+
+/**
+ * @brief Decodes lines of a chunk into its slot, then dispatches the chunks
+ * which are ready. Waits while the slot is used by an earlier chunk.
+ * 
+ * @param job: Pointer to the job.
+ * @param chunk: Index of the chunk.
+ */
+void decodeChunk(Job_t *job, size_t chunk)
+{
+    Slot_t *slot = &job->slots[chunk % job->numOfSlots];
+    Cp_LineStatus_t status;
+    size_t offset;
+    size_t end;
+
+    // Chunk which is waited for is being decoded by another thread; help it
+    //with the dispatching meanwhile.
+    while (chunk >= atomic_load(&job->nextDispatch) + job->numOfSlots)
+    {
+        dispatchReady(job);
+        sched_yield();
+    }
+
+    slot->numOfCommands = 0;
+    slot->rejected = 0;
+    getChunkBounds(job, chunk, &offset, &end);
+
+    while (offset < end)
+    {
+        if (!reserveCommand(slot))
+        {
+            Cp_Command_t command;
+
+            offset += Cp_DecodeNextLineEx(job->parser, &job->buffer[offset],
+                                          job->length - offset, &command, &status);
+            slot->rejected += (status != CP_LINE_STATUS_EMPTY) ? 1 : 0;
+            continue;
+        }
+
+        offset += Cp_DecodeNextLineEx(job->parser, &job->buffer[offset], job->length - offset,
+                                      &slot->commands[slot->numOfCommands], &status);
+
+        if (status == CP_LINE_STATUS_ACCEPTED)
+        {
+            slot->numOfCommands++;
+        }
+        else if (status == CP_LINE_STATUS_REJECTED)
+        {
+            slot->rejected++;
+        }
+    }
+
+    // Publish the slot contents.
+    atomic_store(&slot->chunk, chunk + 1);
+    dispatchReady(job);
+}
+
+/**
+ * @brief Dispatches the decoded chunks in order, as long as the next chunk
+ * is ready. Returns immediately if another thread is dispatching.
+ * 
+ * @param job: Pointer to the job.
+ */
+void dispatchReady(Job_t *job)
+{
+    while (!atomic_flag_test_and_set(&job->dispatching))
+    {
+        size_t next = atomic_load(&job->nextDispatch);
+        Slot_t *slot;
+
+        while (next < job->numOfChunks)
+        {
+            slot = &job->slots[next % job->numOfSlots];
+            if (atomic_load(&slot->chunk) != next + 1)
+            {
+                break;
+            }
+
+            for (size_t i = 0; i < slot->numOfCommands; i++)
+            {
+                Cp_DispatchCommandEx(job->parser, &slot->commands[i]);
+            }
+
+            atomic_fetch_add_explicit(&job->accepted, slot->numOfCommands, memory_order_relaxed);
+            atomic_fetch_add_explicit(&job->rejected, slot->rejected, memory_order_relaxed);
+
+            // Slot can be reused from now on.
+            next++;
+            atomic_store(&job->nextDispatch, next);
+        }
+
+        atomic_flag_clear(&job->dispatching);
+
+        // A chunk which got ready after the check above would be left behind
+        //if its thread had found the flag set; check it once more.
+        if (next >= job->numOfChunks ||
+            atomic_load(&job->slots[next % job->numOfSlots].chunk) != next + 1)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Makes room for one more command in a slot.
+ * 
+ * @param slot: Pointer to the slot.
+ * 
+ * @retval FALSE if memory couldn't be allocated, TRUE otherwise.
+ */
+Bool_t reserveCommand(Slot_t *slot)
+{
+    if (slot->numOfCommands == slot->capacity)
+    {
+        size_t capacity = slot->capacity ? 2 * slot->capacity : INITIAL_SLOT_CAPACITY;
+        Cp_Command_t *commands = realloc(slot->commands, capacity * sizeof(Cp_Command_t));
+
+        if (!commands)
+        {
+            return FALSE;
+        }
+
+        slot->commands = commands;
+        slot->capacity = capacity;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Gets the number of threads to be used.
+ * 
+ * @param config: Pointer to the options.
+ * @param numOfChunks: Number of chunks.
+ * 
+ * @retval Number of threads including the caller.
+ */
+uint16_t getNumOfThreads(const Cp_ParallelConfig_t *config, size_t numOfChunks)
+{
+    long count = config->numOfThreads;
+
+    if (count == 0)
+    {
+        count = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+
+    if (count > MAX_NUM_OF_THREADS)
+    {
+        count = MAX_NUM_OF_THREADS;
+    }
+
+    if ((size_t)count > numOfChunks)
+    {
+        count = (long)numOfChunks;
+    }
+
+    return (count < 1) ? 1 : (uint16_t)count;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file cparser_queue.c
+ * 
+ * Command queue module. Head and tail are free running counts; the producer
+ * only writes the head and the consumer only writes the tail, so no locks or
+ * read-modify-write operations are needed.
+ */
+#include "../inc/cparser_queue.h"
+
+/* Private constants -------------------------------------------------------*/
+/* A slot is published by the release store of the count and seen by the 
+acquire load on the other side. Other compilers get plain accesses, which is
+only safe on single core targets. */
+#if defined(__GNUC__)
+#define LOAD_RELAXED(variable) __atomic_load_n(&(variable), __ATOMIC_RELAXED)
+#define LOAD_ACQUIRE(variable) __atomic_load_n(&(variable), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(variable, value) __atomic_store_n(&(variable), (value), __ATOMIC_RELEASE)
+#else
+#define LOAD_RELAXED(variable) (*(volatile size_t *)&(variable))
+#define LOAD_ACQUIRE(variable) (*(volatile size_t *)&(variable))
+#define STORE_RELEASE(variable, value) (*(volatile size_t *)&(variable) = (value))
+#endif
+
+/* Private function prototypes ---------------------------------------------*/
+static Cp_Command_t *peekCommand(Cp_Queue_t *queue);
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Initializes an empty queue.
+ * 
+ * @param queue: Pointer to the queue.
+ * @param storage: Pointer to the array which keeps the commands.
+ * @param capacity: Number of the commands in the array; should be a power 
+ * of two.
+ * 
+ * @retval FALSE if the capacity isn't a power of two, TRUE otherwise.
+ */
+Bool_t Cp_QueueInit(Cp_Queue_t *queue, Cp_Command_t *storage, size_t capacity)
+{
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+    {
+        return FALSE;
+    }
+
+    queue->commands = storage;
+    queue->mask = capacity - 1;
+    queue->head = 0;
+    queue->cachedTail = 0;
+    queue->dropped = 0;
+    queue->tail = 0;
+    queue->cachedHead = 0;
+    queue->parser = NULL;
+
+    return TRUE;
+}
+
+/**
+ * @brief Puts a command into the queue. Should only be called by the 
+ * producer. Commands which don't fit are counted as dropped.
+ * 
+ * @param queue: Pointer to the queue.
+ * @param command: Pointer to the command.
+ * 
+ * @retval FALSE if the queue is full, TRUE otherwise.
+ */
+Bool_t Cp_QueuePush(Cp_Queue_t *queue, const Cp_Command_t *command)
+{
+    size_t head = queue->head;
+
+    // Tail is read again only if the queue looks full.
+    if (head - queue->cachedTail > queue->mask)
+    {
+        queue->cachedTail = LOAD_ACQUIRE(queue->tail);
+
+        if (head - queue->cachedTail > queue->mask)
+        {
+            STORE_RELEASE(queue->dropped, queue->dropped + 1);
+            return FALSE;
+        }
+    }
+
+    queue->commands[head & queue->mask] = *command;
+    STORE_RELEASE(queue->head, head + 1);
+
+    return TRUE;
+}
+
+/**
+ * @brief Takes the oldest command from the queue. Should only be called by 
+ * the consumer.
+ * 
+ * @param queue: Pointer to the queue.
+ * @param command: Pointer to the command which receives it.
+ * 
+ * @retval FALSE if the queue is empty, TRUE otherwise.
+ */
+Bool_t Cp_QueuePop(Cp_Queue_t *queue, Cp_Command_t *command)
+{
+    const Cp_Command_t *oldest = peekCommand(queue);
+
+    if (!oldest)
+    {
+        return FALSE;
+    }
+
+    *command = *oldest;
+    STORE_RELEASE(queue->tail, queue->tail + 1);
+
+    return TRUE;
+}
+
+/**
+ * @brief Invokes the callbacks of the queued commands, in the order they 
+ * have been put. Should only be called by the consumer. Commands of an 
+ * attached queue are dispatched by Cp_DispatchCommandEx, so their callbacks
+ * are timed and traced for the parser.
+ * 
+ * @param queue: Pointer to the queue.
+ * @param maxCommands: Maximum number of the commands to be dispatched, zero
+ * for no limit. A limit bounds the time which is spent in a main loop turn.
+ * 
+ * @retval Number of the dispatched commands.
+ */
+size_t Cp_QueueDispatch(Cp_Queue_t *queue, size_t maxCommands)
+{
+    const Cp_Command_t *command;
+    size_t dispatched = 0;
+
+    while ((maxCommands == 0 || dispatched < maxCommands) && (command = peekCommand(queue)))
+    {
+        // Slot is released after the callback, so the command isn't copied.
+        if (queue->parser)
+        {
+            Cp_DispatchCommandEx(queue->parser, command);
+        }
+        else
+        {
+            Cp_DispatchCommand(command);
+        }
+        STORE_RELEASE(queue->tail, queue->tail + 1);
+        dispatched++;
+    }
+
+    return dispatched;
+}
+
+/**
+ * @brief Gets the number of the commands which have been dropped since the 
+ * queue was full. Can be called from any thread.
+ * 
+ * @param queue: Pointer to the queue.
+ * 
+ * @retval Number of the dropped commands.
+ */
+size_t Cp_QueueGetDropped(const Cp_Queue_t *queue)
+{
+    return LOAD_RELAXED(queue->dropped);
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Gets the oldest command without taking it from the queue.
+ * 
+ * @param queue: Pointer to the queue.
+ * 
+ * @retval NULL if the queue is empty, pointer to the command otherwise.
+ */
+Cp_Command_t *peekCommand(Cp_Queue_t *queue)
+{
+    size_t tail = queue->tail;
+
+    // Head is read again only if the queue looks empty.
+    if (tail == queue->cachedHead)
+    {
+        queue->cachedHead = LOAD_ACQUIRE(queue->head);
+
+        if (tail == queue->cachedHead)
+        {
+            return NULL;
+        }
+    }
+
+    return &queue->commands[tail & queue->mask];
+}
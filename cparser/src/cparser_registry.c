@@ -0,0 +1,249 @@
+/**
+ * @file cparser_registry.c
+ * 
+ * Shared registry module. Readers announce the global epoch in their slots 
+ * while they hold the read lock; a registry which has been replaced at epoch
+ * E can be reclaimed once no reader announces an epoch older than E. Readers
+ * never wait, the publisher doesn't wait either; it polls the reclamation.
+ */
+#include "../inc/cparser_registry.h"
+
+/* Private constants -------------------------------------------------------*/
+/* Reader slot store and the load of the published registry should be ordered
+against the publication and the slot scan of the writer, which needs 
+sequential consistency. Other compilers get plain accesses, which is only 
+safe on single core targets. */
+#if defined(__GNUC__)
+#define LOAD_ACQUIRE(variable) __atomic_load_n(&(variable), __ATOMIC_ACQUIRE)
+#define LOAD_SEQ(variable) __atomic_load_n(&(variable), __ATOMIC_SEQ_CST)
+#define STORE_SEQ(variable, value) __atomic_store_n(&(variable), (value), __ATOMIC_SEQ_CST)
+#define STORE_RELEASE(variable, value) __atomic_store_n(&(variable), (value), __ATOMIC_RELEASE)
+#define EXCHANGE_SEQ(variable, value) __atomic_exchange_n(&(variable), (value), __ATOMIC_SEQ_CST)
+#define INCREMENT_SEQ(variable) __atomic_add_fetch(&(variable), 1, __ATOMIC_SEQ_CST)
+#define CLAIM(variable) __atomic_exchange_n(&(variable), 1, __ATOMIC_ACQUIRE)
+#else
+#define LOAD_ACQUIRE(variable) (variable)
+#define LOAD_SEQ(variable) (variable)
+#define STORE_SEQ(variable, value) ((variable) = (value))
+#define STORE_RELEASE(variable, value) ((variable) = (value))
+#define EXCHANGE_SEQ(variable, value) exchangePlain((const void **)&(variable), (value))
+#define INCREMENT_SEQ(variable) (++(variable))
+#define CLAIM(variable) claimPlain(&(variable))
+#endif
+
+/* Private function prototypes ---------------------------------------------*/
+#if !defined(__GNUC__)
+static const void *exchangePlain(const void **variable, const void *value);
+static uint8_t claimPlain(uint8_t *variable);
+#endif
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Initializes a shared registry with no attached parsers.
+ * 
+ * @param shared: Pointer to the shared registry.
+ * @param registry: Pointer to the registry which is published first.
+ */
+void Cp_SharedRegistryInit(Cp_SharedRegistry_t *shared, const Cp_Registry_t *registry)
+{
+    shared->current = registry;
+    shared->epoch = 1;
+    shared->numOfRetired = 0;
+
+    for (uint8_t i = 0; i < CPARSER_CONFIG_MAX_NUM_OF_READERS; i++)
+    {
+        shared->attached[i] = FALSE;
+        shared->readers[i].epoch = 0;
+    }
+}
+
+/**
+ * @brief Publishes a registry. Attached parsers decode the lines which they
+ * start afterwards with it. Published registry shouldn't be modified until 
+ * it is reclaimed. Publication and reclamation should be done by a single 
+ * thread at a time.
+ * 
+ * @param shared: Pointer to the shared registry.
+ * @param registry: Pointer to the registry.
+ * 
+ * @retval FALSE if too many replaced registries are waiting to be reclaimed, 
+ * TRUE otherwise.
+ */
+Bool_t Cp_SharedRegistryPublish(Cp_SharedRegistry_t *shared, const Cp_Registry_t *registry)
+{
+    if (shared->numOfRetired == CPARSER_CONFIG_MAX_NUM_OF_RETIRED)
+    {
+        return FALSE;
+    }
+
+    shared->retired[shared->numOfRetired] = EXCHANGE_SEQ(shared->current, registry);
+    shared->retiredEpochs[shared->numOfRetired] = INCREMENT_SEQ(shared->epoch);
+    shared->numOfRetired++;
+
+    return TRUE;
+}
+
+/**
+ * @brief Takes the oldest replaced registry if no parser can be reading it 
+ * anymore. Returned registry can be modified or freed by the application. 
+ * Never blocks; when it gives NULL it can be called again later.
+ * 
+ * @param shared: Pointer to the shared registry.
+ * 
+ * @retval NULL or pointer to the reclaimed registry.
+ */
+const Cp_Registry_t *Cp_SharedRegistryReclaim(Cp_SharedRegistry_t *shared)
+{
+    const Cp_Registry_t *registry;
+
+    if (shared->numOfRetired == 0)
+    {
+        return NULL;
+    }
+
+    // A reader which has taken the lock before the replacement may still be
+    //reading it. Later ones have loaded the replacing registry.
+    for (uint8_t i = 0; i < CPARSER_CONFIG_MAX_NUM_OF_READERS; i++)
+    {
+        size_t epoch = LOAD_SEQ(shared->readers[i].epoch);
+
+        if (epoch != 0 && epoch < shared->retiredEpochs[0])
+        {
+            return NULL;
+        }
+    }
+
+    registry = shared->retired[0];
+    shared->numOfRetired--;
+    for (uint8_t i = 0; i < shared->numOfRetired; i++)
+    {
+        shared->retired[i] = shared->retired[i + 1];
+        shared->retiredEpochs[i] = shared->retiredEpochs[i + 1];
+    }
+
+    return registry;
+}
+
+/**
+ * @brief Attaches a parser to a shared registry. From then on the parser 
+ * decodes with the published registry instead of its own one. Shouldn't be
+ * called while the parser is in use.
+ * 
+ * @param parser: Pointer to the parser.
+ * @param shared: Pointer to the shared registry.
+ * 
+ * @retval FALSE if all the reader slots are in use, TRUE otherwise.
+ */
+Bool_t Cp_AttachRegistryEx(Cp_Parser_t *parser, Cp_SharedRegistry_t *shared)
+{
+    for (uint8_t i = 0; i < CPARSER_CONFIG_MAX_NUM_OF_READERS; i++)
+    {
+        if (!CLAIM(shared->attached[i]))
+        {
+            parser->shared = shared;
+            parser->reader = i;
+            parser->active = NULL;
+            parser->lockDepth = 0;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/**
+ * @brief Detaches a parser from its shared registry; the parser decodes 
+ * with its own registry again. Shouldn't be called while the parser is in 
+ * use.
+ * 
+ * @param parser: Pointer to the parser.
+ */
+void Cp_DetachRegistryEx(Cp_Parser_t *parser)
+{
+    Cp_SharedRegistry_t *shared = parser->shared;
+
+    if (!shared)
+    {
+        return;
+    }
+
+    STORE_RELEASE(shared->readers[parser->reader].epoch, 0);
+    STORE_RELEASE(shared->attached[parser->reader], FALSE);
+    parser->shared = NULL;
+    parser->active = NULL;
+    parser->lockDepth = 0;
+}
+
+/**
+ * @brief Takes the read lock; pins the published registry until the lock is
+ * released. Feed functions take the lock by themselves; it is needed around
+ * Cp_DecodeLineEx, Cp_DecodeNextLineEx and Cp_FeedBufferParallel calls. 
+ * Locks can be nested. Without a shared registry it does nothing.
+ * 
+ * @param parser: Pointer to the parser.
+ */
+void Cp_ReadLockEx(Cp_Parser_t *parser)
+{
+    Cp_SharedRegistry_t *shared = parser->shared;
+
+    if (!shared || parser->lockDepth++ != 0)
+    {
+        return;
+    }
+
+    STORE_SEQ(shared->readers[parser->reader].epoch, LOAD_ACQUIRE(shared->epoch));
+    parser->active = LOAD_SEQ(shared->current);
+}
+
+/**
+ * @brief Releases the read lock. Pinned registry shouldn't be used 
+ * afterwards.
+ * 
+ * @param parser: Pointer to the parser.
+ */
+void Cp_ReadUnlockEx(Cp_Parser_t *parser)
+{
+    Cp_SharedRegistry_t *shared = parser->shared;
+
+    if (!shared || --parser->lockDepth != 0)
+    {
+        return;
+    }
+
+    parser->active = NULL;
+    STORE_RELEASE(shared->readers[parser->reader].epoch, 0);
+}
+
+/* Private functions -------------------------------------------------------*/
+#if !defined(__GNUC__)
+/**
+ * @brief Exchanges a pointer without atomicity.
+ * 
+ * @param variable: Pointer to the variable.
+ * @param value: New value.
+ * 
+ * @retval Old value.
+ */
+const void *exchangePlain(const void **variable, const void *value)
+{
+    const void *old = *variable;
+
+    *variable = value;
+    return old;
+}
+
+/**
+ * @brief Sets a flag without atomicity.
+ * 
+ * @param variable: Pointer to the flag.
+ * 
+ * @retval Old value of the flag.
+ */
+uint8_t claimPlain(uint8_t *variable)
+{
+    uint8_t old = *variable;
+
+    *variable = TRUE;
+    return old;
+}
+#endif
@@ -0,0 +1,350 @@
+/**
+ * @file cparser_trace.c
+ * 
+ * Trace module. A buffer is attached to a thread through a thread local
+ * pointer and written only by that thread; a record is filled first and
+ * then published by advancing the head with a release store. The exporter
+ * can run on another thread while the buffer is being written; records
+ * which the writer may have overwritten during the copy are skipped.
+ */
+#include "../inc/cparser_trace.h"
+#include "string.h"
+
+/* Private constants -------------------------------------------------------*/
+#define RECORD_MASK (CPARSER_CONFIG_TRACE_BUFFER_SIZE - 1)
+#define MAX_EVENT_LENGTH 192
+
+#if (CPARSER_CONFIG_TRACE_BUFFER_SIZE & (CPARSER_CONFIG_TRACE_BUFFER_SIZE - 1)) != 0
+#error "CPARSER_CONFIG_TRACE_BUFFER_SIZE should be a power of two"
+#endif
+
+/* Thread local storage of the attached buffer. Targets without threads don't
+need it. */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define THREAD_LOCAL __thread
+#else
+#define THREAD_LOCAL
+#endif
+
+#if defined(__GNUC__)
+#define LOAD_ACQUIRE(value) __atomic_load_n(&(value), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(value, x) __atomic_store_n(&(value), (x), __ATOMIC_RELEASE)
+#define FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define FETCH_ADD(value, x) __atomic_fetch_add(&(value), (x), __ATOMIC_RELAXED)
+#else
+#define LOAD_ACQUIRE(value) (value)
+#define STORE_RELEASE(value, x) ((value) = (x))
+#define FENCE_ACQUIRE()
+#define FETCH_ADD(value, x) ((value) += (x))
+#endif
+
+#if defined(CPARSER_CONFIG_STATS_CLOCK)
+#define TRACE_CLOCK() ((uint64_t)(CPARSER_CONFIG_STATS_CLOCK()))
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRACE_CLOCK() ((uint64_t)__builtin_ia32_rdtsc())
+#else
+#define TRACE_CLOCK() ((uint64_t)0)
+#endif
+
+/* Private function prototypes ---------------------------------------------*/
+static uint64_t getBaseTimestamp(const Cp_TraceBuffer_t *const *buffers, uint8_t numOfBuffers);
+static uint32_t getFirstIndex(uint32_t head);
+static size_t formatEvent(const Cp_TraceRecord_t *record, uint32_t threadId, uint64_t base,
+                          uint32_t ticksPerMicrosecond, char *output);
+static char *appendText(char *output, const char *text);
+static char *appendUnsigned(char *output, uint64_t value);
+
+/* Exported variables ------------------------------------------------------*/
+uint32_t Cp_TraceNumOfAttached = 0;
+
+/* Private variables -------------------------------------------------------*/
+static THREAD_LOCAL Cp_TraceBuffer_t *AttachedBuffer = NULL;
+
+static const char *const StageNames[CP_NUM_OF_TRACE_STAGES] = {
+    "line", "parseFields", "lookup", "parseValue", "callback"};
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Empties the buffer.
+ * 
+ * @param buffer: Pointer to the buffer.
+ * @param threadId: Id of the thread in the exported trace.
+ */
+void Cp_TraceInit(Cp_TraceBuffer_t *buffer, uint32_t threadId)
+{
+    memset(buffer, 0, sizeof(Cp_TraceBuffer_t));
+    buffer->threadId = threadId;
+}
+
+/**
+ * @brief Attaches a buffer to the calling thread; the stages which are run
+ * on the thread are recorded into it from then on. A buffer should be
+ * attached to a single thread.
+ * 
+ * @param buffer: Pointer to the buffer, NULL stops tracing the thread.
+ */
+void Cp_TraceAttach(Cp_TraceBuffer_t *buffer)
+{
+    if (buffer && !AttachedBuffer)
+    {
+        FETCH_ADD(Cp_TraceNumOfAttached, 1);
+    }
+    else if (!buffer && AttachedBuffer)
+    {
+        FETCH_ADD(Cp_TraceNumOfAttached, (uint32_t)-1);
+    }
+
+    AttachedBuffer = buffer;
+}
+
+/**
+ * @brief Gets the buffer of the calling thread.
+ * 
+ * @retval Pointer to the buffer, NULL if none is attached.
+ */
+Cp_TraceBuffer_t *Cp_TraceGetBuffer(void)
+{
+    return AttachedBuffer;
+}
+
+/**
+ * @brief Records the begin or the end of a stage into the buffer of the
+ * calling thread, if one is attached. Begin of a line starts a new line
+ * number. Called by the trace points of the parser.
+ * 
+ * @param stage: Stage.
+ * @param end: TRUE at the end of the stage, FALSE at its begin.
+ * @param trigger: Registry position of the trigger or CP_TRACE_NO_TRIGGER.
+ */
+void Cp_TraceRecord(Cp_TraceStage_t stage, Bool_t end, uint16_t trigger)
+{
+    Cp_TraceBuffer_t *buffer = AttachedBuffer;
+    Cp_TraceRecord_t *record;
+    uint32_t head;
+
+    if (buffer == NULL)
+    {
+        return;
+    }
+
+    head = buffer->head;
+    record = &buffer->records[head & RECORD_MASK];
+
+    if (stage == CP_TRACE_STAGE_LINE && !end)
+    {
+        buffer->line++;
+    }
+
+    record->timestamp = TRACE_CLOCK();
+    record->line = buffer->line;
+    record->trigger = trigger;
+    record->stage = stage;
+    record->end = end;
+
+    STORE_RELEASE(buffer->head, head + 1);
+}
+
+/**
+ * @brief Exports the records of the buffers as a Chrome trace(JSON object
+ * format), each stage as a duration event. Timestamps start from the
+ * earliest record. Ends whose begins have been overwritten are left out.
+ * 
+ * @param buffers: Array of pointers to the buffers.
+ * @param numOfBuffers: Number of the buffers.
+ * @param ticksPerMicrosecond: Clock ticks in a microsecond.
+ * @param writer: Function which writes the text.
+ * @param context: Context of the writer.
+ * 
+ * @retval Number of the exported events.
+ */
+size_t Cp_TraceExport(const Cp_TraceBuffer_t *const *buffers, uint8_t numOfBuffers,
+                      uint32_t ticksPerMicrosecond, Cp_TraceWriter_t writer, void *context)
+{
+    static const char header[] = "{\"traceEvents\":[";
+    static const char footer[] = "\n],\"displayTimeUnit\":\"ns\"}\n";
+    uint64_t base = getBaseTimestamp(buffers, numOfBuffers);
+    size_t events = 0;
+
+    ticksPerMicrosecond = ticksPerMicrosecond ? ticksPerMicrosecond : 1;
+    writer(header, sizeof(header) - 1, context);
+
+    for (uint8_t i = 0; i < numOfBuffers; i++)
+    {
+        const Cp_TraceBuffer_t *buffer = buffers[i];
+        uint32_t depths[CP_NUM_OF_TRACE_STAGES] = {0};
+        uint32_t head = LOAD_ACQUIRE(buffer->head);
+
+        for (uint32_t index = getFirstIndex(head); index != head; index++)
+        {
+            Cp_TraceRecord_t record = buffer->records[index & RECORD_MASK];
+            char event[MAX_EVENT_LENGTH];
+            size_t length;
+
+            // Writer may have lapped the record while it was being copied.
+            FENCE_ACQUIRE();
+            if (LOAD_ACQUIRE(buffer->head) - index >= CPARSER_CONFIG_TRACE_BUFFER_SIZE ||
+                record.stage >= CP_NUM_OF_TRACE_STAGES)
+            {
+                continue;
+            }
+
+            if (record.end)
+            {
+                if (depths[record.stage] == 0)
+                {
+                    continue;
+                }
+                depths[record.stage]--;
+            }
+            else
+            {
+                depths[record.stage]++;
+            }
+
+            event[0] = events ? ',' : '\n';
+            event[1] = '\n';
+            length = formatEvent(&record, buffer->threadId, base, ticksPerMicrosecond,
+                                 &event[events ? 2 : 1]);
+            writer(event, length + (events ? 2 : 1), context);
+            events++;
+        }
+    }
+
+    writer(footer, sizeof(footer) - 1, context);
+    return events;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Gets the earliest timestamp of the buffers.
+ * 
+ * @param buffers: Array of pointers to the buffers.
+ * @param numOfBuffers: Number of the buffers.
+ * 
+ * @retval Timestamp, zero if the buffers are empty.
+ */
+uint64_t getBaseTimestamp(const Cp_TraceBuffer_t *const *buffers, uint8_t numOfBuffers)
+{
+    uint64_t base = UINT64_MAX;
+
+    for (uint8_t i = 0; i < numOfBuffers; i++)
+    {
+        uint32_t head = LOAD_ACQUIRE(buffers[i]->head);
+        uint64_t timestamp;
+
+        if (head == 0)
+        {
+            continue;
+        }
+
+        timestamp = buffers[i]->records[getFirstIndex(head) & RECORD_MASK].timestamp;
+        base = (timestamp < base) ? timestamp : base;
+    }
+
+    return (base == UINT64_MAX) ? 0 : base;
+}
+
+/**
+ * @brief Gets the index of the oldest record which is kept in a buffer.
+ * 
+ * @param head: Number of the records written into the buffer.
+ * 
+ * @retval Index of the record.
+ */
+uint32_t getFirstIndex(uint32_t head)
+{
+    return (head > CPARSER_CONFIG_TRACE_BUFFER_SIZE) ? head - CPARSER_CONFIG_TRACE_BUFFER_SIZE
+                                                     : 0;
+}
+
+/**
+ * @brief Formats a record as a trace event, e.g. {"name":"lookup",
+ * "cat":"cparser","ph":"E","ts":12.345,"pid":1,"tid":0,
+ * "args":{"line":3,"trigger":2}}.
+ * 
+ * @param record: Pointer to the record.
+ * @param threadId: Id of the thread of the record.
+ * @param base: Timestamp of the trace start.
+ * @param ticksPerMicrosecond: Clock ticks in a microsecond.
+ * @param output: Output char array; should hold MAX_EVENT_LENGTH - 2
+ * characters.
+ * 
+ * @retval Length of the event.
+ */
+size_t formatEvent(const Cp_TraceRecord_t *record, uint32_t threadId, uint64_t base,
+                   uint32_t ticksPerMicrosecond, char *output)
+{
+    uint64_t ticks = (record->timestamp > base) ? record->timestamp - base : 0;
+    uint64_t fraction = (ticks % ticksPerMicrosecond) * 1000 / ticksPerMicrosecond;
+    char *end = output;
+
+    end = appendText(end, "{\"name\":\"");
+    end = appendText(end, StageNames[record->stage]);
+    end = appendText(end, record->end ? "\",\"cat\":\"cparser\",\"ph\":\"E\",\"ts\":"
+                                      : "\",\"cat\":\"cparser\",\"ph\":\"B\",\"ts\":");
+    end = appendUnsigned(end, ticks / ticksPerMicrosecond);
+
+    // Three fraction digits give nanoseconds.
+    *end++ = '.';
+    *end++ = (char)('0' + fraction / 100);
+    *end++ = (char)('0' + fraction / 10 % 10);
+    *end++ = (char)('0' + fraction % 10);
+
+    end = appendText(end, ",\"pid\":1,\"tid\":");
+    end = appendUnsigned(end, threadId);
+    end = appendText(end, ",\"args\":{\"line\":");
+    end = appendUnsigned(end, record->line);
+    if (record->trigger != CP_TRACE_NO_TRIGGER)
+    {
+        end = appendText(end, ",\"trigger\":");
+        end = appendUnsigned(end, record->trigger);
+    }
+    end = appendText(end, "}}");
+
+    return (size_t)(end - output);
+}
+
+/**
+ * @brief Appends a null terminated string, without the null termination.
+ * 
+ * @param output: Output char array.
+ * @param text: Null terminated string.
+ * 
+ * @retval Pointer to the end of the output.
+ */
+char *appendText(char *output, const char *text)
+{
+    size_t length = strlen(text);
+
+    memcpy(output, text, length);
+    return output + length;
+}
+
+/**
+ * @brief Appends an unsigned integer in decimal.
+ * 
+ * @param output: Output char array.
+ * @param value: Value.
+ * 
+ * @retval Pointer to the end of the output.
+ */
+char *appendUnsigned(char *output, uint64_t value)
+{
+    char digits[20];
+    uint8_t count = 0;
+
+    do
+    {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    while (count)
+    {
+        *output++ = digits[--count];
+    }
+
+    return output;
+}
@@ -0,0 +1,1738 @@
+/**
+ * @file number.c
+ * 
+ * Number conversion module. Decimal numbers are collected as a 64 bit 
+ * mantissa and a decimal exponent, then converted to the nearest float 
+ * (ties to even) like strtof does. Small exact cases use a single float 
+ * operation, the others use the Eisel-Lemire algorithm with a table of 
+ * 128 bit truncated powers of five.
+ * 
+ * Runs of integer digits are validated and converted eight at a time in a 
+ * 64 bit word(SWAR) on little endian targets, with an explicit range check.
+ * 
+ * Fixed point values are decoded from the same mantissa and exponent with 
+ * integer operations only; the float code can be compiled out for the 
+ * targets without an FPU.
+ * 
+ * Numbers are formatted without allocations; integers two digits at a time
+ * and floats with the Ryu algorithm, which gives the shortest digit string 
+ * that parses back to the same float.
+ */
+#include "../inc/number.h"
+#include "float.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private constants -------------------------------------------------------*/
+#define MANTISSA_EXPLICIT_BITS 23
+#define MINIMUM_EXPONENT (-127)
+#define INFINITE_POWER 0xFF
+#define SMALLEST_POWER_OF_TEN (-64)
+#define LARGEST_POWER_OF_TEN 38
+#define MIN_EXPONENT_ROUND_TO_EVEN (-17)
+#define MAX_EXPONENT_ROUND_TO_EVEN 10
+#define MAX_EXACT_MANTISSA (1ULL << (MANTISSA_EXPLICIT_BITS + 1))
+#define MAX_EXACT_POWER_OF_TEN 10
+#define FLOAT_EXPONENT_BIAS 127
+#define FLOAT_POW5_INV_BITCOUNT 59
+#define FLOAT_POW5_BITCOUNT 61
+#define MAX_PLAIN_DIGITS 9
+#define MIN_PLAIN_POINT_POSITION (-4)
+#define SWAR_DIGIT_COUNT 8
+#define SWAR_ZEROS 0x3030303030303030ULL
+#define SWAR_HIGH_NIBBLES 0xF0F0F0F0F0F0F0F0ULL
+#define SWAR_SIXES 0x0606060606060606ULL
+#define MAX_NEGATIVE_MAGNITUDE 0x80000000UL
+#define FIXED_FRACTION_BITS CPARSER_CONFIG_FIXED_FRACTION_BITS
+#define FIXED_FRACTION_MASK ((1ULL << FIXED_FRACTION_BITS) - 1)
+#define MAX_FIXED_DIVISOR_POWER 18
+#define MAX_FIXED_FRACTION_DIGITS 10
+
+#if (CPARSER_CONFIG_FIXED_FRACTION_BITS < 0) || (CPARSER_CONFIG_FIXED_FRACTION_BITS > 30)
+#error "CPARSER_CONFIG_FIXED_FRACTION_BITS should be between 0 and 30"
+#endif
+
+/* Eight byte loads hold the characters in the memory order only on little 
+endian targets; others convert a digit at a time. */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define DIGITS_SWAR 1
+#endif
+#elif defined(_MSC_VER)
+#define DIGITS_SWAR 1
+#endif
+
+#ifndef DIGITS_SWAR
+#define DIGITS_SWAR 0
+#endif
+
+/* Private function prototypes ---------------------------------------------*/
+#if CPARSER_CONFIG_REAL
+static Bool_t computeFloat(uint64_t mantissa, int32_t exponent, uint32_t *bits);
+static void multiply(uint64_t a, uint64_t b, uint64_t *high, uint64_t *low);
+static uint8_t countLeadingZeros(uint64_t value);
+static void shortestDecimal(uint32_t bits, uint32_t *digits, int32_t *exponent);
+static uint32_t mulShift(uint32_t m, uint64_t factor, int32_t shift);
+static uint32_t pow5Factor(uint32_t value);
+static int32_t pow5Bits(int32_t e);
+static int32_t log10Pow2(int32_t e);
+static int32_t log10Pow5(int32_t e);
+#endif
+static Bool_t scanDecimal(const char *input, uint8_t length, uint64_t *mantissa, int32_t *exponent,
+                          Bool_t *negative, Bool_t *truncated);
+static int32_t composeFixed(uint64_t mantissa, int32_t exponent, Bool_t negative, Bool_t sticky);
+static void scanTail(const char *input, uint8_t length, uint64_t *tail, uint8_t *tailDigits,
+                     Bool_t *sticky);
+static Bool_t compareTie(uint64_t mantissa, uint64_t tail, uint8_t tailDigits, int32_t exponent,
+                         uint64_t tie, int8_t *comparison);
+static Bool_t parseSignedInteger(const char *input, uint8_t start_idx, uint8_t length,
+                                 int32_t *value);
+static Bool_t parseUnsignedInteger(const char *input, uint8_t start_idx, uint8_t length,
+                                   uint32_t *value);
+static Bool_t parseDigits(const char *input, uint8_t count, uint64_t *value);
+#if DIGITS_SWAR
+static Bool_t areEightDigits(uint64_t chunk);
+static uint32_t convertEightDigits(uint64_t chunk);
+#endif
+static void getSign(const char *input, uint8_t start_idx, uint8_t length, int8_t *sign,
+                    uint8_t *stop_idx);
+static void cropJerk(const char *input, uint8_t start_idx, uint8_t length, uint8_t *stop_idx);
+static uint8_t countDigits(uint32_t value);
+static void writeDigits(uint32_t value, uint8_t count, char *output);
+#if CPARSER_CONFIG_REAL
+static void writeWideDigits(uint64_t value, uint8_t count, char *output);
+#endif
+
+/* Private variables -------------------------------------------------------*/
+#if CPARSER_CONFIG_REAL
+/* Exactly representable powers of ten. */
+static const float PowersOfTen[MAX_EXACT_POWER_OF_TEN + 1] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+/* 128 bit approximations of 5^q for q in [SMALLEST_POWER_OF_TEN, 
+LARGEST_POWER_OF_TEN], high word first. Normalized so that the most 
+significant bit is set; negative powers are rounded up. */
+static const uint64_t PowersOfFive[2 * (LARGEST_POWER_OF_TEN - SMALLEST_POWER_OF_TEN + 1)] = {
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, /* 5^-64 */
+    0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL, /* 5^-63 */
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, /* 5^-62 */
+    0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL, /* 5^-61 */
+    0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, /* 5^-60 */
+    0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL, /* 5^-59 */
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, /* 5^-58 */
+    0xc8de047564d20a8bULL, 0xf245825a5a445275ULL, /* 5^-57 */
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, /* 5^-56 */
+    0x9ced737bb6c4183dULL, 0x55464dd69685606bULL, /* 5^-55 */
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, /* 5^-54 */
+    0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL, /* 5^-53 */
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, /* 5^-52 */
+    0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL, /* 5^-51 */
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, /* 5^-50 */
+    0x95a8637627989aadULL, 0xdde7001379a44aa8ULL, /* 5^-49 */
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, /* 5^-48 */
+    0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL, /* 5^-47 */
+    0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, /* 5^-46 */
+    0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL, /* 5^-45 */
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, /* 5^-44 */
+    0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL, /* 5^-43 */
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, /* 5^-42 */
+    0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL, /* 5^-41 */
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, /* 5^-40 */
+    0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL, /* 5^-39 */
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, /* 5^-38 */
+    0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL, /* 5^-37 */
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, /* 5^-36 */
+    0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL, /* 5^-35 */
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, /* 5^-34 */
+    0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL, /* 5^-33 */
+    0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, /* 5^-32 */
+    0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL, /* 5^-31 */
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, /* 5^-30 */
+    0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL, /* 5^-29 */
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, /* 5^-28 */
+    0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL, /* 5^-27 */
+    0xc612062576589ddaULL, 0x95364afe032a819eULL, /* 5^-26 */
+    0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL, /* 5^-25 */
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, /* 5^-24 */
+    0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL, /* 5^-23 */
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL, /* 5^-22 */
+    0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL, /* 5^-21 */
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL, /* 5^-20 */
+    0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL, /* 5^-19 */
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, /* 5^-18 */
+    0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL, /* 5^-17 */
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL, /* 5^-16 */
+    0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL, /* 5^-15 */
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL, /* 5^-14 */
+    0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL, /* 5^-13 */
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, /* 5^-12 */
+    0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL, /* 5^-11 */
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL, /* 5^-10 */
+    0x89705f4136b4a597ULL, 0x31680a88f8953031ULL, /* 5^-9 */
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL, /* 5^-8 */
+    0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL, /* 5^-7 */
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, /* 5^-6 */
+    0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL, /* 5^-5 */
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL, /* 5^-4 */
+    0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL, /* 5^-3 */
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL, /* 5^-2 */
+    0xccccccccccccccccULL, 0xcccccccccccccccdULL, /* 5^-1 */
+    0x8000000000000000ULL, 0x0000000000000000ULL, /* 5^0 */
+    0xa000000000000000ULL, 0x0000000000000000ULL, /* 5^1 */
+    0xc800000000000000ULL, 0x0000000000000000ULL, /* 5^2 */
+    0xfa00000000000000ULL, 0x0000000000000000ULL, /* 5^3 */
+    0x9c40000000000000ULL, 0x0000000000000000ULL, /* 5^4 */
+    0xc350000000000000ULL, 0x0000000000000000ULL, /* 5^5 */
+    0xf424000000000000ULL, 0x0000000000000000ULL, /* 5^6 */
+    0x9896800000000000ULL, 0x0000000000000000ULL, /* 5^7 */
+    0xbebc200000000000ULL, 0x0000000000000000ULL, /* 5^8 */
+    0xee6b280000000000ULL, 0x0000000000000000ULL, /* 5^9 */
+    0x9502f90000000000ULL, 0x0000000000000000ULL, /* 5^10 */
+    0xba43b74000000000ULL, 0x0000000000000000ULL, /* 5^11 */
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL, /* 5^12 */
+    0x9184e72a00000000ULL, 0x0000000000000000ULL, /* 5^13 */
+    0xb5e620f480000000ULL, 0x0000000000000000ULL, /* 5^14 */
+    0xe35fa931a0000000ULL, 0x0000000000000000ULL, /* 5^15 */
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, /* 5^16 */
+    0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL, /* 5^17 */
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL, /* 5^18 */
+    0x8ac7230489e80000ULL, 0x0000000000000000ULL, /* 5^19 */
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL, /* 5^20 */
+    0xd8d726b7177a8000ULL, 0x0000000000000000ULL, /* 5^21 */
+    0x878678326eac9000ULL, 0x0000000000000000ULL, /* 5^22 */
+    0xa968163f0a57b400ULL, 0x0000000000000000ULL, /* 5^23 */
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL, /* 5^24 */
+    0x84595161401484a0ULL, 0x0000000000000000ULL, /* 5^25 */
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, /* 5^26 */
+    0xcecb8f27f4200f3aULL, 0x0000000000000000ULL, /* 5^27 */
+    0x813f3978f8940984ULL, 0x4000000000000000ULL, /* 5^28 */
+    0xa18f07d736b90be5ULL, 0x5000000000000000ULL, /* 5^29 */
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, /* 5^30 */
+    0xfc6f7c4045812296ULL, 0x4d00000000000000ULL, /* 5^31 */
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, /* 5^32 */
+    0xc5371912364ce305ULL, 0x6c28000000000000ULL, /* 5^33 */
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, /* 5^34 */
+    0x9a130b963a6c115cULL, 0x3c7f400000000000ULL, /* 5^35 */
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, /* 5^36 */
+    0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL, /* 5^37 */
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL /* 5^38 */
+};
+
+#endif
+
+/* Powers of ten which fit into 64 bits. */
+static const uint64_t DecimalPowers[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL};
+
+/* Two digit strings of 00..99 to write the integers two digits at a time. */
+static const char DigitPairs[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+    '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+    '2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+    '4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+    '5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+    '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+    '8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'};
+
+#if CPARSER_CONFIG_REAL
+/* 2^k / 5^q rounded up, normalized to FLOAT_POW5_INV_BITCOUNT bits. */
+static const uint64_t Pow5InvSplit[31] = {
+    0x0800000000000001ULL, 0x0666666666666667ULL, 0x051eb851eb851eb9ULL,
+    0x04189374bc6a7efaULL, 0x068db8bac710cb2aULL, 0x053e2d6238da3c22ULL,
+    0x0431bde82d7b634eULL, 0x06b5fca6af2bd216ULL, 0x055e63b88c230e78ULL,
+    0x044b82fa09b5a52dULL, 0x06df37f675ef6eaeULL, 0x057f5ff85e592558ULL,
+    0x0465e6604b7a8447ULL, 0x0709709a125da071ULL, 0x05a126e1a84ae6c1ULL,
+    0x0480ebe7b9d58567ULL, 0x0734aca5f6226f0bULL, 0x05c3bd5191b525a3ULL,
+    0x049c97747490eae9ULL, 0x0760f253edb4ab0eULL, 0x05e72843249088d8ULL,
+    0x04b8ed0283a6d3e0ULL, 0x078e480405d7b966ULL, 0x060b6cd004ac9452ULL,
+    0x04d5f0a66a23a9dbULL, 0x07bcb43d769f762bULL, 0x063090312bb2c4efULL,
+    0x04f3a68dbc8f03f3ULL, 0x07ec3daf94180651ULL, 0x065697bfa9acd1daULL,
+    0x051212ffbaf0a7e2ULL,
+};
+
+/* 5^i normalized to FLOAT_POW5_BITCOUNT bits. */
+static const uint64_t Pow5Split[48] = {
+    0x1000000000000000ULL, 0x1400000000000000ULL, 0x1900000000000000ULL,
+    0x1f40000000000000ULL, 0x1388000000000000ULL, 0x186a000000000000ULL,
+    0x1e84800000000000ULL, 0x1312d00000000000ULL, 0x17d7840000000000ULL,
+    0x1dcd650000000000ULL, 0x12a05f2000000000ULL, 0x174876e800000000ULL,
+    0x1d1a94a200000000ULL, 0x12309ce540000000ULL, 0x16bcc41e90000000ULL,
+    0x1c6bf52634000000ULL, 0x11c37937e0800000ULL, 0x16345785d8a00000ULL,
+    0x1bc16d674ec80000ULL, 0x1158e460913d0000ULL, 0x15af1d78b58c4000ULL,
+    0x1b1ae4d6e2ef5000ULL, 0x10f0cf064dd59200ULL, 0x152d02c7e14af680ULL,
+    0x1a784379d99db420ULL, 0x108b2a2c28029094ULL, 0x14adf4b7320334b9ULL,
+    0x19d971e4fe8401e7ULL, 0x1027e72f1f128130ULL, 0x1431e0fae6d7217cULL,
+    0x193e5939a08ce9dbULL, 0x1f8def8808b02452ULL, 0x13b8b5b5056e16b3ULL,
+    0x18a6e32246c99c60ULL, 0x1ed09bead87c0378ULL, 0x13426172c74d822bULL,
+    0x1812f9cf7920e2b6ULL, 0x1e17b84357691b64ULL, 0x12ced32a16a1b11eULL,
+    0x178287f49c4a1d66ULL, 0x1d6329f1c35ca4bfULL, 0x125dfa371a19e6f7ULL,
+    0x16f578c4e0a060b5ULL, 0x1cb2d6f618c878e3ULL, 0x11efc659cf7d4b8dULL,
+    0x166bb7f0435c9e71ULL, 0x1c06a5ec5433c60dULL, 0x118427b3b4a05bc8ULL,
+};
+#endif
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Parses a signed integer; an optional sign followed by digits. Empty
+ * input gives zero.
+ * 
+ * @param input: Input char array.
+ * @param length: Length of the char array.
+ * @param value: Pointer to return the value.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t Number_ParseInteger(const char *input, uint8_t length, int32_t *value)
+{
+    return parseSignedInteger(input, 0, length, value);
+}
+
+#if CPARSER_CONFIG_REAL
+/**
+ * @brief Parses a real number; [sign] digits [. digits] [E [sign] digits].
+ * Empty input is zero and an exponent without a mantissa means a mantissa of
+ * one(e.g. E3). Result is bit exact with strtof.
+ * 
+ * @param input: Input char array.
+ * @param length: Length of the char array.
+ * @param value: Pointer to the return value.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t Number_ParseFloat(const char *input, uint8_t length, float *value)
+{
+    uint64_t mantissa;
+    int32_t exponent;
+    Bool_t negative;
+    Bool_t truncated;
+
+    if (!scanDecimal(input, length, &mantissa, &exponent, &negative, &truncated))
+    {
+        return FALSE;
+    }
+
+    *value = Number_ComposeFloat(mantissa, exponent, negative);
+
+    // Dropped digits only matter if they could change the rounding. If so,
+    //let the C library decide.
+    if (truncated && Number_ComposeFloat(mantissa + 1, exponent, negative) != *value)
+    {
+        char buffer[0x100];
+
+        memcpy(buffer, input, length);
+        buffer[length] = '\0';
+        *value = strtof(buffer, NULL);
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Converts mantissa * 10^exponent to the nearest float.
+ * 
+ * @param mantissa: Decimal mantissa.
+ * @param exponent: Decimal exponent.
+ * @param negative: Whether the value is negative.
+ * 
+ * @retval Floating point value.
+ */
+float Number_ComposeFloat(uint64_t mantissa, int32_t exponent, Bool_t negative)
+{
+    uint32_t bits;
+    float value;
+
+#if FLT_EVAL_METHOD == 0
+    // Both operands are exact, so the single rounding of the operation is
+    //the correct one.
+    if (mantissa <= MAX_EXACT_MANTISSA && exponent >= -MAX_EXACT_POWER_OF_TEN &&
+        exponent <= MAX_EXACT_POWER_OF_TEN)
+    {
+        value = (float)mantissa;
+        value = (exponent < 0) ? value / PowersOfTen[-exponent] : value * PowersOfTen[exponent];
+
+        return negative ? -value : value;
+    }
+#endif
+
+    computeFloat(mantissa, exponent, &bits);
+    bits |= negative ? 0x80000000U : 0;
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+/**
+ * @brief Converts a decimal with digits beyond the mantissa capacity to the
+ * nearest float; value is (mantissa + tail / 10^tailDigits + dropped 
+ * digits) * 10^exponent. Like in Number_ParseFloat, the digits are given to
+ * the C library if the tail could change the rounding. A non-zero digit 
+ * after them stands for the dropped ones, which is exact as long as the 
+ * mantissa and the tail hold all the digits of the tie point in question.
+ * 
+ * @param mantissa: Decimal mantissa; NUMBER_MAX_MANTISSA_DIGITS digits if 
+ * there is a tail.
+ * @param tail: Words of NUMBER_MAX_MANTISSA_DIGITS digits which follow the
+ * mantissa; the last word holds the remaining digits.
+ * @param tailDigits: Number of the tail digits.
+ * @param sticky: Whether non-zero digits are dropped after the tail.
+ * @param exponent: Decimal exponent of the mantissa.
+ * @param negative: Whether the value is negative.
+ * 
+ * @retval Floating point value.
+ */
+float Number_ComposeFloatEx(uint64_t mantissa, const uint64_t *tail, uint8_t tailDigits,
+                            Bool_t sticky, int32_t exponent, Bool_t negative)
+{
+    float value = Number_ComposeFloat(mantissa, exponent, negative);
+    char buffer[0x100];
+    uint16_t length = 0;
+    uint32_t magnitude;
+
+    if ((tailDigits == 0 && !sticky) ||
+        Number_ComposeFloat(mantissa + 1, exponent, negative) == value)
+    {
+        return value;
+    }
+
+    buffer[length++] = negative ? '-' : '+';
+    writeWideDigits(mantissa, NUMBER_MAX_MANTISSA_DIGITS, &buffer[length]);
+    length += NUMBER_MAX_MANTISSA_DIGITS;
+    for (uint8_t written = 0; written < tailDigits; tail++)
+    {
+        uint8_t count = tailDigits - written;
+
+        count = (count < NUMBER_MAX_MANTISSA_DIGITS) ? count : NUMBER_MAX_MANTISSA_DIGITS;
+        writeWideDigits(*tail, count, &buffer[length]);
+        length += count;
+        written += count;
+    }
+    if (sticky)
+    {
+        buffer[length++] = '1';
+    }
+
+    // Exponent of the last written digit.
+    exponent -= tailDigits + (sticky ? 1 : 0);
+    buffer[length++] = 'E';
+    if (exponent < 0)
+    {
+        buffer[length++] = '-';
+    }
+    magnitude = (exponent < 0) ? 0U - (uint32_t)exponent : (uint32_t)exponent;
+    writeDigits(magnitude, countDigits(magnitude), &buffer[length]);
+    length += countDigits(magnitude);
+    buffer[length] = '\0';
+
+    return strtof(buffer, NULL);
+}
+
+#endif
+
+/**
+ * @brief Parses a real number into a fixed point value with 
+ * CPARSER_CONFIG_FIXED_FRACTION_BITS fraction bits. Grammar is the same as 
+ * Number_ParseFloat's. Result is rounded to the nearest(ties to even) and 
+ * saturates at the limits of int32_t. Only integer operations are used.
+ * 
+ * @param input: Input char array.
+ * @param length: Length of the char array.
+ * @param value: Pointer to the return value.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t Number_ParseFixed(const char *input, uint8_t length, int32_t *value)
+{
+    uint64_t mantissa;
+    int32_t exponent;
+    Bool_t negative;
+    Bool_t truncated;
+    uint64_t tail = 0;
+    uint8_t tail_digits = 0;
+
+    if (!scanDecimal(input, length, &mantissa, &exponent, &negative, &truncated))
+    {
+        return FALSE;
+    }
+
+    // Digits beyond the mantissa capacity can decide a tie; they are 
+    //scanned again.
+    if (truncated)
+    {
+        scanTail(input, length, &tail, &tail_digits, &truncated);
+    }
+
+    *value = Number_ComposeFixedEx(mantissa, tail, tail_digits, truncated, exponent, negative);
+    return TRUE;
+}
+
+/**
+ * @brief Converts mantissa * 10^exponent to the nearest fixed point value.
+ * 
+ * @param mantissa: Decimal mantissa.
+ * @param exponent: Decimal exponent.
+ * @param negative: Whether the value is negative.
+ * 
+ * @retval Fixed point value.
+ */
+int32_t Number_ComposeFixed(uint64_t mantissa, int32_t exponent, Bool_t negative)
+{
+    return Number_ComposeFixedEx(mantissa, 0, 0, FALSE, exponent, negative);
+}
+
+/**
+ * @brief Converts a decimal with digits beyond the mantissa capacity to the
+ * nearest fixed point value; value is (mantissa + tail / 10^tailDigits + 
+ * dropped digits) * 10^exponent. A tie point of the fixed point values has 
+ * at most 33 significant digits, so the mantissa and the tail digits 
+ * decide the rounding exactly and the rest only breaks the ties.
+ * 
+ * @param mantissa: Decimal mantissa; NUMBER_MAX_MANTISSA_DIGITS digits if 
+ * there is a tail.
+ * @param tail: Digits which follow the mantissa.
+ * @param tailDigits: Number of the tail digits, at most 
+ * NUMBER_MAX_MANTISSA_DIGITS.
+ * @param sticky: Whether non-zero digits are dropped after the tail.
+ * @param exponent: Decimal exponent of the mantissa.
+ * @param negative: Whether the value is negative.
+ * 
+ * @retval Fixed point value.
+ */
+int32_t Number_ComposeFixedEx(uint64_t mantissa, uint64_t tail, uint8_t tailDigits,
+                              Bool_t sticky, int32_t exponent, Bool_t negative)
+{
+    Bool_t dropped = (tail != 0 || sticky) ? TRUE : FALSE;
+    uint64_t limit = negative ? MAX_NEGATIVE_MAGNITUDE : (uint64_t)INT32_MAX;
+    int32_t value = composeFixed(mantissa, exponent, negative, dropped);
+    uint32_t magnitude;
+    int8_t comparison;
+
+    // Mantissa digits are only dropped by composeFixed below the divisor 
+    //range; otherwise the result is exact.
+    if (!dropped && exponent >= -MAX_FIXED_DIVISOR_POWER)
+    {
+        return value;
+    }
+
+    // Dropped digits move the result by one at most; check it against the 
+    //tie points on both sides.
+    magnitude = negative ? 0U - (uint32_t)value : (uint32_t)value;
+    if (magnitude < limit &&
+        compareTie(mantissa, tail, tailDigits, exponent, 2 * (uint64_t)magnitude + 1,
+                   &comparison) &&
+        (comparison > 0 || (comparison == 0 && (sticky || (magnitude & 1)))))
+    {
+        magnitude++;
+    }
+    else if (magnitude > 0 &&
+             compareTie(mantissa, tail, tailDigits, exponent, 2 * (uint64_t)magnitude - 1,
+                        &comparison) &&
+             (comparison < 0 || (comparison == 0 && !sticky && (magnitude & 1))))
+    {
+        magnitude--;
+    }
+
+    return negative ? (int32_t)(0U - magnitude) : (int32_t)magnitude;
+}
+
+/**
+ * @brief Writes the decimal digits of an integer. Output isn't null 
+ * terminated.
+ * 
+ * @param value: Value to be written.
+ * @param output: Output buffer of at least NUMBER_MAX_INTEGER_LENGTH chars.
+ * 
+ * @retval Number of chars written.
+ */
+uint8_t Number_FormatInteger(int32_t value, char *output)
+{
+    uint32_t magnitude = (uint32_t)value;
+    uint8_t length = 0;
+    uint8_t count;
+
+    if (value < 0)
+    {
+        output[length++] = '-';
+        magnitude = 0U - magnitude;
+    }
+
+    count = countDigits(magnitude);
+    writeDigits(magnitude, count, &output[length]);
+
+    return length + count;
+}
+
+#if CPARSER_CONFIG_REAL
+/**
+ * @brief Writes the shortest decimal representation of a float which parses 
+ * back to the same value. Output isn't null terminated.
+ * 
+ * @param value: Value to be written.
+ * @param output: Output buffer of at least NUMBER_MAX_FLOAT_LENGTH chars.
+ * 
+ * @retval Number of chars written(zero for infinity and NaN).
+ */
+uint8_t Number_FormatFloat(float value, char *output)
+{
+    uint32_t bits;
+    uint32_t digits;
+    int32_t exponent;
+    int32_t point;
+    uint8_t count;
+    uint8_t length = 0;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    if (((bits >> MANTISSA_EXPLICIT_BITS) & INFINITE_POWER) == INFINITE_POWER)
+    {
+        return 0;
+    }
+
+    if (bits & 0x80000000U)
+    {
+        output[length++] = '-';
+    }
+
+    bits &= 0x7FFFFFFFU;
+    if (bits == 0)
+    {
+        output[length++] = '0';
+        return length;
+    }
+
+    shortestDecimal(bits, &digits, &exponent);
+    count = countDigits(digits);
+    point = (int32_t)count + exponent;
+
+    if ((exponent >= 0) && (point <= MAX_PLAIN_DIGITS))
+    {
+        // Integer; digits followed by the zeros.
+        writeDigits(digits, count, &output[length]);
+        length += count;
+        memset(&output[length], '0', (size_t)exponent);
+        length += (uint8_t)exponent;
+    }
+    else if ((exponent < 0) && (point > 0))
+    {
+        // Point is between the digits.
+        writeDigits(digits, count, &output[length + 1]);
+        memmove(&output[length], &output[length + 1], (size_t)point);
+        output[length + point] = '.';
+        length += count + 1;
+    }
+    else if ((point <= 0) && (point > MIN_PLAIN_POINT_POSITION))
+    {
+        // Leading zeros after the point.
+        output[length++] = '0';
+        output[length++] = '.';
+        memset(&output[length], '0', (size_t)-point);
+        length += (uint8_t)-point;
+        writeDigits(digits, count, &output[length]);
+        length += count;
+    }
+    else
+    {
+        // Scientific notation; single digit before the point.
+        writeDigits(digits, count, &output[length + 1]);
+        output[length] = output[length + 1];
+        length++;
+        if (count > 1)
+        {
+            output[length] = '.';
+            length += count;
+        }
+
+        output[length++] = 'E';
+        length += Number_FormatInteger(point - 1, &output[length]);
+    }
+
+    return length;
+}
+
+#endif
+
+/**
+ * @brief Writes the shortest decimal representation of a fixed point value 
+ * which parses back to the same value. Output isn't null terminated.
+ * 
+ * @param value: Fixed point value.
+ * @param output: Output buffer of at least NUMBER_MAX_FIXED_LENGTH chars.
+ * 
+ * @retval Number of chars written.
+ */
+uint8_t Number_FormatFixed(int32_t value, char *output)
+{
+    uint32_t magnitude = (uint32_t)value;
+    uint32_t integral;
+    uint64_t fraction;
+    uint64_t digits = 0;
+    uint64_t scale = 1;
+    uint8_t count = 0;
+    uint8_t length = 0;
+
+    if (value < 0)
+    {
+        output[length++] = '-';
+        magnitude = 0U - magnitude;
+    }
+
+    integral = (uint32_t)(magnitude >> FIXED_FRACTION_BITS);
+    fraction = magnitude & FIXED_FRACTION_MASK;
+
+    // Digits are added until the decimal is closer to the value than half 
+    //of the last bit, truncated or rounded up; then it parses back exactly.
+    while (fraction != 0)
+    {
+        if (2 * fraction < scale)
+        {
+            break;
+        }
+
+        if (2 * ((1ULL << FIXED_FRACTION_BITS) - fraction) < scale)
+        {
+            digits++;
+            break;
+        }
+
+        fraction *= 10;
+        digits = digits * 10 + (fraction >> FIXED_FRACTION_BITS);
+        fraction &= FIXED_FRACTION_MASK;
+        scale *= 10;
+        count++;
+    }
+
+    // Rounding up may carry into the integral part and leave trailing zeros.
+    if (count > 0 && digits == scale)
+    {
+        integral++;
+        digits = 0;
+    }
+
+    while (count > 0 && digits % 10 == 0)
+    {
+        digits /= 10;
+        count--;
+    }
+
+    writeDigits(integral, countDigits(integral), &output[length]);
+    length += countDigits(integral);
+
+    if (count > 0)
+    {
+        output[length] = '.';
+        length += count + 1;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            output[length - 1 - i] = (char)('0' + digits % 10);
+            digits /= 10;
+        }
+    }
+
+    return length;
+}
+
+/* Private functions -------------------------------------------------------*/
+#if CPARSER_CONFIG_REAL
+/**
+ * @brief Eisel-Lemire conversion of mantissa * 10^exponent to the bits of
+ * the nearest float.
+ * 
+ * @param mantissa: Decimal mantissa.
+ * @param exponent: Decimal exponent.
+ * @param bits: Pointer to return the IEEE 754 bits(without the sign).
+ * 
+ * @retval TRUE or FALSE(zero or infinity).
+ */
+Bool_t computeFloat(uint64_t mantissa, int32_t exponent, uint32_t *bits)
+{
+    const uint64_t precision_mask = 0xFFFFFFFFFFFFFFFFULL >> (MANTISSA_EXPLICIT_BITS + 3);
+    uint64_t high, low;
+    int32_t power2;
+
+    if (mantissa == 0 || exponent < SMALLEST_POWER_OF_TEN)
+    {
+        *bits = 0;
+        return FALSE;
+    }
+
+    if (exponent > LARGEST_POWER_OF_TEN)
+    {
+        *bits = (uint32_t)INFINITE_POWER << MANTISSA_EXPLICIT_BITS;
+        return FALSE;
+    }
+
+    // Normalize the mantissa and multiply by the power of five. Second word
+    //of the power is only needed when the first product is inconclusive.
+    uint8_t lz = countLeadingZeros(mantissa);
+    uint32_t idx = 2 * (uint32_t)(exponent - SMALLEST_POWER_OF_TEN);
+    mantissa <<= lz;
+
+    multiply(mantissa, PowersOfFive[idx], &high, &low);
+    if ((high & precision_mask) == precision_mask)
+    {
+        uint64_t second_high, second_low;
+
+        multiply(mantissa, PowersOfFive[idx + 1], &second_high, &second_low);
+        low += second_high;
+        if (second_high > low)
+        {
+            high++;
+        }
+    }
+
+    int32_t upperbit = (int32_t)(high >> 63);
+    int32_t shift = upperbit + 64 - MANTISSA_EXPLICIT_BITS - 3;
+    uint64_t m = high >> shift;
+
+    // Binary exponent is floor(log2(10^exponent)) + 63 plus the normalization.
+    power2 = ((((152170 + 65536) * exponent) >> 16) + 63) + upperbit - lz - MINIMUM_EXPONENT;
+
+    // Subnormal numbers.
+    if (power2 <= 0)
+    {
+        if (-power2 + 1 >= 64)
+        {
+            *bits = 0;
+            return FALSE;
+        }
+
+        m >>= -power2 + 1;
+        m += (m & 1);
+        m >>= 1;
+        power2 = (m < (1ULL << MANTISSA_EXPLICIT_BITS)) ? 0 : 1;
+        *bits = ((uint32_t)power2 << MANTISSA_EXPLICIT_BITS) |
+                (uint32_t)(m & ((1ULL << MANTISSA_EXPLICIT_BITS) - 1));
+        return TRUE;
+    }
+
+    // Exactly halfway between two floats; round down to the even one.
+    if (low <= 1 && exponent >= MIN_EXPONENT_ROUND_TO_EVEN &&
+        exponent <= MAX_EXPONENT_ROUND_TO_EVEN && (m & 3) == 1 && (m << shift) == high)
+    {
+        m &= ~1ULL;
+    }
+
+    m += (m & 1);
+    m >>= 1;
+    if (m >= (2ULL << MANTISSA_EXPLICIT_BITS))
+    {
+        m = (1ULL << MANTISSA_EXPLICIT_BITS);
+        power2++;
+    }
+
+    if (power2 >= INFINITE_POWER)
+    {
+        *bits = (uint32_t)INFINITE_POWER << MANTISSA_EXPLICIT_BITS;
+        return FALSE;
+    }
+
+    *bits = ((uint32_t)power2 << MANTISSA_EXPLICIT_BITS) |
+            (uint32_t)(m & ((1ULL << MANTISSA_EXPLICIT_BITS) - 1));
+    return TRUE;
+}
+
+/**
+ * @brief Full 64x64 bit multiplication.
+ * 
+ * @param a: First operand.
+ * @param b: Second operand.
+ * @param high: Pointer to return the high word of the product.
+ * @param low: Pointer to return the low word of the product.
+ */
+void multiply(uint64_t a, uint64_t b, uint64_t *high, uint64_t *low)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+
+    *high = (uint64_t)(product >> 64);
+    *low = (uint64_t)product;
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo;
+    uint64_t p1 = a_lo * b_hi;
+    uint64_t p2 = a_hi * b_lo;
+    uint64_t p3 = a_hi * b_hi;
+    uint64_t middle = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+
+    *low = (middle << 32) | (uint32_t)p0;
+    *high = p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32);
+#endif
+}
+
+/**
+ * @brief Counts leading zero bits of a non-zero value.
+ */
+uint8_t countLeadingZeros(uint64_t value)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_clzll(value);
+#else
+    uint8_t count = 0;
+    while ((value & 0x8000000000000000ULL) == 0)
+    {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+#endif
+
+/**
+ * @brief Scans a real number into a decimal mantissa and exponent.
+ * 
+ * @param input: Input char array.
+ * @param length: Length of the char array.
+ * @param mantissa: Pointer to return the significant digits.
+ * @param exponent: Pointer to return the decimal exponent.
+ * @param negative: Pointer to return whether the number is negative.
+ * @param truncated: Pointer to return whether non-zero digits are dropped 
+ * beyond the mantissa capacity.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t scanDecimal(const char *input, uint8_t length, uint64_t *mantissa, int32_t *exponent,
+                   Bool_t *negative, Bool_t *truncated)
+{
+    uint64_t __mantissa = 0;
+    int32_t __exponent = 0;
+    uint8_t digits = 0;
+    Bool_t fraction = FALSE;
+    Bool_t __truncated = FALSE;
+    uint8_t i = 0;
+
+    *negative = FALSE;
+    if (length > 0 && (input[0] == '-' || input[0] == '+'))
+    {
+        *negative = (input[0] == '-') ? TRUE : FALSE;
+        i++;
+    }
+
+    for (; i < length; i++)
+    {
+        uint8_t digit = input[i] - '0';
+
+        if (digit > 9)
+        {
+            // Single decimal point is allowed before the exponent.
+            if (input[i] == '.' && !fraction)
+            {
+                fraction = TRUE;
+                continue;
+            }
+
+            break;
+        }
+
+        // Leading zeros aren't significant. Digits beyond the mantissa
+        //capacity only shift the integral part.
+        if (digits < NUMBER_MAX_MANTISSA_DIGITS)
+        {
+            __mantissa = __mantissa * 10 + digit;
+            digits += (__mantissa != 0) ? 1 : 0;
+            __exponent -= fraction ? 1 : 0;
+        }
+        else
+        {
+            __truncated |= (digit != 0) ? TRUE : FALSE;
+            __exponent += fraction ? 0 : 1;
+        }
+    }
+
+    if (i < length && (input[i] == 'e' || input[i] == 'E'))
+    {
+        uint64_t digits_value;
+        int32_t power;
+        int8_t power_sign = 1;
+
+        // E sign at the end doesn't mean anything.
+        if (i == length - 1)
+        {
+            return FALSE;
+        }
+
+        if (i == 0)
+        {
+            __mantissa = 1;
+        }
+
+        i++;
+        if (input[i] == '-' || input[i] == '+')
+        {
+            power_sign = (input[i] == '-') ? -1 : 1;
+            i++;
+        }
+
+        if (!parseDigits(&input[i], length - i, &digits_value))
+        {
+            return FALSE;
+        }
+        i = length;
+
+        // Exponents far beyond the float range saturate instead of wrapping.
+        power = (digits_value < NUMBER_MAX_EXPONENT_VALUE) ? (int32_t)digits_value
+                                                          : NUMBER_MAX_EXPONENT_VALUE;
+        __exponent += power_sign * power;
+    }
+
+    // Tried to parse something which is not a number.
+    if (i != length)
+    {
+        return FALSE;
+    }
+
+    *mantissa = __mantissa;
+    *exponent = __exponent;
+    *truncated = __truncated;
+
+    return TRUE;
+}
+
+/**
+ * @brief Converts mantissa * 10^exponent * 2^FIXED_FRACTION_BITS to the 
+ * nearest integer(ties to even) with integer operations only. Values out of
+ * the int32_t range saturate.
+ * 
+ * @param mantissa: Decimal mantissa.
+ * @param exponent: Decimal exponent.
+ * @param negative: Whether the value is negative.
+ * @param sticky: Whether non-zero digits are dropped after the mantissa; 
+ * they only break the ties.
+ * 
+ * @retval Fixed point value.
+ */
+int32_t composeFixed(uint64_t mantissa, int32_t exponent, Bool_t negative, Bool_t sticky)
+{
+    uint64_t limit = negative ? MAX_NEGATIVE_MAGNITUDE : (uint64_t)INT32_MAX;
+    uint64_t magnitude;
+
+    if (exponent >= 0)
+    {
+        // Integral value; scaled up while it can be in the range.
+        magnitude = mantissa;
+        for (; (exponent > 0) && (magnitude <= (limit >> FIXED_FRACTION_BITS)); exponent--)
+        {
+            magnitude *= 10;
+        }
+
+        magnitude = (magnitude > (limit >> FIXED_FRACTION_BITS))
+                        ? limit
+                        : (magnitude << FIXED_FRACTION_BITS);
+    }
+    else
+    {
+        uint64_t divisor;
+        uint64_t remainder;
+
+        // Divisor should fit into 60 bits, so the remainder can be doubled. 
+        //Dropped digits may decide a tie with many fraction bits; 
+        //Number_ComposeFixedEx corrects such results.
+        while ((exponent < -MAX_FIXED_DIVISOR_POWER) && (mantissa != 0))
+        {
+            sticky |= (mantissa % 10 != 0) ? TRUE : FALSE;
+            mantissa /= 10;
+            exponent++;
+        }
+
+        if (mantissa == 0)
+        {
+            return 0;
+        }
+
+        divisor = DecimalPowers[-exponent];
+        if (mantissa <= (UINT64_MAX >> (FIXED_FRACTION_BITS + 1)))
+        {
+            // Scaled mantissa fits, which is the case for the usual digits; 
+            //a single division.
+            magnitude = (mantissa << FIXED_FRACTION_BITS) / divisor;
+            remainder = (mantissa << FIXED_FRACTION_BITS) % divisor;
+        }
+        else
+        {
+            magnitude = mantissa / divisor;
+            remainder = mantissa % divisor;
+            if (magnitude > (limit >> FIXED_FRACTION_BITS))
+            {
+                return negative ? INT32_MIN : INT32_MAX;
+            }
+
+            // Fraction bits by restoring division; shifts and subtractions
+            //only.
+            for (uint8_t i = 0; i < FIXED_FRACTION_BITS; i++)
+            {
+                remainder <<= 1;
+                magnitude <<= 1;
+                if (remainder >= divisor)
+                {
+                    remainder -= divisor;
+                    magnitude |= 1;
+                }
+            }
+        }
+
+        // Round to nearest; an exact half goes to the even value unless 
+        //dropped digits make it bigger.
+        remainder <<= 1;
+        if ((remainder > divisor) || ((remainder == divisor) && (sticky || (magnitude & 1))))
+        {
+            magnitude++;
+        }
+
+        magnitude = (magnitude > limit) ? limit : magnitude;
+    }
+
+    return negative ? (int32_t)(0U - (uint32_t)magnitude) : (int32_t)magnitude;
+}
+
+/**
+ * @brief Scans the digits which follow the NUMBER_MAX_MANTISSA_DIGITS 
+ * significant digits of a number scanned by scanDecimal.
+ * 
+ * @param input: Input char array.
+ * @param length: Length of the char array.
+ * @param tail: Pointer to return the next NUMBER_MAX_MANTISSA_DIGITS digits.
+ * @param tailDigits: Pointer to return the number of the tail digits.
+ * @param sticky: Pointer to return whether non-zero digits follow the tail.
+ */
+void scanTail(const char *input, uint8_t length, uint64_t *tail, uint8_t *tailDigits,
+              Bool_t *sticky)
+{
+    Bool_t significant = FALSE;
+    uint8_t digits = 0;
+    uint8_t i = (length > 0 && (input[0] == '-' || input[0] == '+')) ? 1 : 0;
+
+    *tail = 0;
+    *tailDigits = 0;
+    *sticky = FALSE;
+
+    for (; i < length; i++)
+    {
+        uint8_t digit = input[i] - '0';
+
+        if (digit > 9)
+        {
+            if (input[i] == '.')
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        // Same significant digits as scanDecimal's.
+        significant |= (digit != 0) ? TRUE : FALSE;
+        if (digits < NUMBER_MAX_MANTISSA_DIGITS)
+        {
+            digits += significant ? 1 : 0;
+        }
+        else if (*tailDigits < NUMBER_MAX_MANTISSA_DIGITS)
+        {
+            *tail = *tail * 10 + digit;
+            (*tailDigits)++;
+        }
+        else
+        {
+            *sticky |= (digit != 0) ? TRUE : FALSE;
+        }
+    }
+}
+
+/**
+ * @brief Compares the digits of a decimal with a tie point of the fixed 
+ * point values, tie / 2^(FIXED_FRACTION_BITS + 1), from the most 
+ * significant one. Tie digits are generated by multiplying the fraction 
+ * by ten, so only integer operations are used.
+ * 
+ * @param mantissa: Decimal mantissa.
+ * @param tail: Digits which follow the mantissa.
+ * @param tailDigits: Number of the tail digits.
+ * @param exponent: Decimal exponent of the mantissa.
+ * @param tie: Odd numerator of the tie point.
+ * @param comparison: Pointer to return -1, 0 or 1 as the decimal is below,
+ * equal to or above the tie point.
+ * 
+ * @retval FALSE if the decimal is far from the tie point, which doesn't 
+ * happen when it rounds to both sides of it.
+ */
+Bool_t compareTie(uint64_t mantissa, uint64_t tail, uint8_t tailDigits, int32_t exponent,
+                  uint64_t tie, int8_t *comparison)
+{
+    uint64_t integral = tie >> (FIXED_FRACTION_BITS + 1);
+    uint64_t fraction = tie & ((2ULL << FIXED_FRACTION_BITS) - 1);
+    uint8_t mantissa_digits = 1;
+    int32_t top;
+    int32_t bottom;
+
+    while (mantissa_digits < 20 && mantissa >= DecimalPowers[mantissa_digits])
+    {
+        mantissa_digits++;
+    }
+
+    // Weights of the most significant digit of the decimal and the least 
+    //significant digits of both.
+    top = exponent + mantissa_digits - 1;
+    bottom = exponent - tailDigits;
+    bottom = (bottom < -(FIXED_FRACTION_BITS + 1)) ? bottom : -(FIXED_FRACTION_BITS + 1);
+    if (top > 19 || top < -(FIXED_FRACTION_BITS + 2) || top - bottom > 0x7F)
+    {
+        return FALSE;
+    }
+
+    for (int32_t weight = (top > 10) ? top : 10; weight >= bottom; weight--)
+    {
+        int32_t index = top - weight;
+        uint8_t digit = 0;
+        uint8_t tie_digit;
+
+        if (index >= 0 && index < mantissa_digits)
+        {
+            digit = (uint8_t)(mantissa / DecimalPowers[mantissa_digits - 1 - index] % 10);
+        }
+        else if (index >= mantissa_digits && index < mantissa_digits + tailDigits)
+        {
+            digit = (uint8_t)(tail / DecimalPowers[mantissa_digits + tailDigits - 1 - index] %
+                              10);
+        }
+
+        if (weight >= 0)
+        {
+            tie_digit = (weight < 20) ? (uint8_t)(integral / DecimalPowers[weight] % 10) : 0;
+        }
+        else
+        {
+            fraction *= 10;
+            tie_digit = (uint8_t)(fraction >> (FIXED_FRACTION_BITS + 1));
+            fraction &= (2ULL << FIXED_FRACTION_BITS) - 1;
+        }
+
+        if (digit != tie_digit)
+        {
+            *comparison = (digit > tie_digit) ? 1 : -1;
+            return TRUE;
+        }
+    }
+
+    *comparison = 0;
+    return TRUE;
+}
+
+/**
+ * @brief Parses the signed integer value.
+ * 
+ * @param input: Input char array.
+ * @param start_idx: Start index of the number.
+ * @param length: Length of the char array.
+ * @param value: Pointer to the return value.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t parseSignedInteger(const char *input, uint8_t start_idx, uint8_t length, int32_t *value)
+{
+    if (length > start_idx)
+    {
+        uint32_t __value = 0;
+        int8_t sign = 1;
+        uint8_t parse_idx = 0;
+
+        getSign(input, start_idx, length, &sign, &parse_idx);
+
+        if (!parseUnsignedInteger(input, parse_idx, length, &__value))
+        {
+            return FALSE;
+        }
+
+        // Magnitude of the most negative value is one more than the most 
+        //positive one.
+        if (__value > ((sign < 0) ? MAX_NEGATIVE_MAGNITUDE : (uint32_t)INT32_MAX))
+        {
+            return FALSE;
+        }
+
+        *value = (sign < 0) ? (int32_t)(0U - __value) : (int32_t)__value;
+    }
+    else
+    {
+        *value = 0;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Parses the unsigned integer value.
+ * 
+ * @param input: Input char array.
+ * @param start_idx: Start index of the number.
+ * @param length: Length of the char array.
+ * @param value: Pointer to the return value.
+ * 
+ * @retval TRUE or FALSE(not a number or bigger than UINT32_MAX).
+ */
+Bool_t parseUnsignedInteger(const char *input, uint8_t start_idx, uint8_t length,
+                            uint32_t *value)
+{
+    if (length > start_idx)
+    {
+        uint64_t __value;
+
+        if (!parseDigits(&input[start_idx], length - start_idx, &__value) ||
+            __value > UINT32_MAX)
+        {
+            return FALSE;
+        }
+
+        *value = (uint32_t)__value;
+    }
+    else
+    {
+        *value = 0;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Validates and converts a run of decimal digits; eight at a time 
+ * while at least eight are left, then one at a time.
+ * 
+ * @param input: Pointer to the first digit.
+ * @param count: Number of the digits.
+ * @param value: Pointer to return the value. Values bigger than UINT32_MAX 
+ * aren't exact; they only stay bigger than UINT32_MAX.
+ * 
+ * @retval TRUE or FALSE(a character isn't a digit).
+ */
+Bool_t parseDigits(const char *input, uint8_t count, uint64_t *value)
+{
+    uint64_t __value = 0;
+    uint8_t i = 0;
+
+#if DIGITS_SWAR
+    for (; (uint8_t)(count - i) >= SWAR_DIGIT_COUNT; i += SWAR_DIGIT_COUNT)
+    {
+        uint64_t chunk;
+
+        memcpy(&chunk, &input[i], sizeof(chunk));
+        if (!areEightDigits(chunk))
+        {
+            return FALSE;
+        }
+
+        // Once out of range only the digits are validated, so the value
+        //can't wrap.
+        __value = (__value > UINT32_MAX) ? __value
+                                         : __value * 100000000ULL + convertEightDigits(chunk);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        uint8_t digit = input[i] - '0';
+
+        if (digit > 9)
+        {
+            return FALSE;
+        }
+
+        __value = (__value > UINT32_MAX) ? __value : __value * 10 + digit;
+    }
+
+    *value = __value;
+    return TRUE;
+}
+
+#if DIGITS_SWAR
+/**
+ * @brief Checks whether all eight characters of a word are digits; high 
+ * nibbles should be 3, and adding 6 shouldn't carry into them.
+ */
+Bool_t areEightDigits(uint64_t chunk)
+{
+    return (((chunk & SWAR_HIGH_NIBBLES) == SWAR_ZEROS) &&
+            (((chunk + SWAR_SIXES) & SWAR_HIGH_NIBBLES) == SWAR_ZEROS))
+               ? TRUE
+               : FALSE;
+}
+
+/**
+ * @brief Converts eight digit characters of a word(first digit in the low 
+ * byte) by combining the neighbours; pairs, then quads, then the halves.
+ */
+uint32_t convertEightDigits(uint64_t chunk)
+{
+    chunk -= SWAR_ZEROS;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+            32;
+
+    return (uint32_t)chunk;
+}
+#endif
+
+/**
+ * @brief Gets the sign of a given value in the given char array.
+ * 
+ * @param input: Char array to be processed.
+ * @param start_idx: Start index of the processing.
+ * @param length: Window of the process.
+ * @param sign: Pointer to return 1 or -1(positive or negative respectively).
+ * @param stop_idx: Pointer to return index next to the sign element index.
+ */
+void getSign(const char *input, uint8_t start_idx, uint8_t length, int8_t *sign, uint8_t *stop_idx)
+{
+    uint8_t parse_idx = start_idx;
+    int8_t __sign = 1;
+
+    if (length > start_idx)
+    {
+        if (input[parse_idx] == '-')
+        {
+            parse_idx++;
+            __sign = -1;
+        }
+        else if (input[parse_idx] == '+')
+        {
+            parse_idx++;
+            __sign = 1;
+        }
+
+        cropJerk(input, parse_idx, length, stop_idx);
+
+        *sign = __sign;
+    }
+    else
+    {
+        *sign = 1;
+    }
+}
+
+/**
+ * @brief Crops the meaningless data out of the char array.
+ * 
+ * @param input: Pointer to the input char array.
+ * @param start_idx: Start index of the process.
+ * @param length: Window of the process.
+ * @param stop_idx: Pointer to the meaningfull data.
+ */
+void cropJerk(const char *input, uint8_t start_idx, uint8_t length, uint8_t *stop_idx)
+{
+    uint8_t __stop_idx = start_idx;
+
+    // Get rid of leading spaces or zeros, without reading past the window.
+    while ((__stop_idx < length) && ((input[__stop_idx] == '0') || input[__stop_idx] == ' '))
+    {
+        __stop_idx++;
+    }
+
+    *stop_idx = __stop_idx;
+}
+
+#if CPARSER_CONFIG_REAL
+/**
+ * @brief Ryu algorithm; finds the shortest decimal digits * 10^exponent in 
+ * the rounding interval of a positive finite float.
+ * 
+ * @param bits: IEEE 754 bits of the float(without the sign).
+ * @param digits: Pointer to return the decimal digits.
+ * @param exponent: Pointer to return the decimal exponent.
+ */
+void shortestDecimal(uint32_t bits, uint32_t *digits, int32_t *exponent)
+{
+    uint32_t ieee_mantissa = bits & ((1U << MANTISSA_EXPLICIT_BITS) - 1);
+    uint32_t ieee_exponent = bits >> MANTISSA_EXPLICIT_BITS;
+    int32_t e2;
+    uint32_t m2;
+    uint32_t mv, mp, mm;
+    uint32_t mm_shift;
+    uint32_t vr, vp, vm;
+    int32_t e10;
+    int32_t removed = 0;
+    uint8_t last_removed_digit = 0;
+    Bool_t accept_bounds;
+    Bool_t vm_is_trailing_zeros = FALSE;
+    Bool_t vr_is_trailing_zeros = FALSE;
+    uint32_t output;
+
+    if (ieee_exponent == 0)
+    {
+        e2 = 1 - FLOAT_EXPONENT_BIAS - MANTISSA_EXPLICIT_BITS - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = (int32_t)ieee_exponent - FLOAT_EXPONENT_BIAS - MANTISSA_EXPLICIT_BITS - 2;
+        m2 = (1U << MANTISSA_EXPLICIT_BITS) | ieee_mantissa;
+    }
+
+    // Halfway points to the neighbours; they are in the interval when the
+    //mantissa is even(ties to even).
+    accept_bounds = ((m2 & 1) == 0);
+    mm_shift = ((ieee_mantissa != 0) || (ieee_exponent <= 1)) ? 1 : 0;
+    mv = 4 * m2;
+    mp = 4 * m2 + 2;
+    mm = 4 * m2 - 1 - mm_shift;
+
+    if (e2 >= 0)
+    {
+        int32_t q = log10Pow2(e2);
+        int32_t k = FLOAT_POW5_INV_BITCOUNT + pow5Bits(q) - 1;
+        int32_t i = -e2 + q + k;
+
+        e10 = q;
+        vr = mulShift(mv, Pow5InvSplit[q], i);
+        vp = mulShift(mp, Pow5InvSplit[q], i);
+        vm = mulShift(mm, Pow5InvSplit[q], i);
+
+        if ((q != 0) && ((vp - 1) / 10 <= vm / 10))
+        {
+            // No digit will be removed below, so the digit which is cut by
+            //the division is needed for rounding.
+            int32_t l = FLOAT_POW5_INV_BITCOUNT + pow5Bits(q - 1) - 1;
+            last_removed_digit = (uint8_t)(mulShift(mv, Pow5InvSplit[q - 1], -e2 + q - 1 + l) % 10);
+        }
+
+        if (q <= 9)
+        {
+            if (mv % 5 == 0)
+            {
+                vr_is_trailing_zeros = (pow5Factor(mv) >= (uint32_t)q);
+            }
+            else if (accept_bounds)
+            {
+                vm_is_trailing_zeros = (pow5Factor(mm) >= (uint32_t)q);
+            }
+            else
+            {
+                vp -= (pow5Factor(mp) >= (uint32_t)q) ? 1 : 0;
+            }
+        }
+    }
+    else
+    {
+        int32_t q = log10Pow5(-e2);
+        int32_t i = -e2 - q;
+        int32_t k = pow5Bits(i) - FLOAT_POW5_BITCOUNT;
+        int32_t j = q - k;
+
+        e10 = q + e2;
+        vr = mulShift(mv, Pow5Split[i], j);
+        vp = mulShift(mp, Pow5Split[i], j);
+        vm = mulShift(mm, Pow5Split[i], j);
+
+        if ((q != 0) && ((vp - 1) / 10 <= vm / 10))
+        {
+            j = q - 1 - (pow5Bits(i + 1) - FLOAT_POW5_BITCOUNT);
+            last_removed_digit = (uint8_t)(mulShift(mv, Pow5Split[i + 1], j) % 10);
+        }
+
+        if (q <= 1)
+        {
+            vr_is_trailing_zeros = TRUE;
+            if (accept_bounds)
+            {
+                vm_is_trailing_zeros = (mm_shift == 1);
+            }
+            else
+            {
+                vp--;
+            }
+        }
+        else if (q < 31)
+        {
+            vr_is_trailing_zeros = ((mv & ((1U << (q - 1)) - 1)) == 0);
+        }
+    }
+
+    if (vm_is_trailing_zeros || vr_is_trailing_zeros)
+    {
+        while (vp / 10 > vm / 10)
+        {
+            vm_is_trailing_zeros &= (vm % 10 == 0);
+            vr_is_trailing_zeros &= (last_removed_digit == 0);
+            last_removed_digit = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+
+        if (vm_is_trailing_zeros)
+        {
+            while (vm % 10 == 0)
+            {
+                vr_is_trailing_zeros &= (last_removed_digit == 0);
+                last_removed_digit = (uint8_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+
+        if (vr_is_trailing_zeros && (last_removed_digit == 5) && (vr % 2 == 0))
+        {
+            // Exactly halfway; round to even.
+            last_removed_digit = 4;
+        }
+
+        output = vr + ((((vr == vm) && (!accept_bounds || !vm_is_trailing_zeros)) ||
+                        (last_removed_digit >= 5))
+                           ? 1
+                           : 0);
+    }
+    else
+    {
+        while (vp / 10 > vm / 10)
+        {
+            last_removed_digit = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+
+        output = vr + (((vr == vm) || (last_removed_digit >= 5)) ? 1 : 0);
+    }
+
+    *digits = output;
+    *exponent = e10 + removed;
+}
+
+/**
+ * @brief Returns the high bits of m * factor shifted right by shift(> 32).
+ */
+uint32_t mulShift(uint32_t m, uint64_t factor, int32_t shift)
+{
+    uint64_t low = (uint64_t)m * (uint32_t)factor;
+    uint64_t high = (uint64_t)m * (uint32_t)(factor >> 32);
+
+    return (uint32_t)(((low >> 32) + high) >> (shift - 32));
+}
+
+/**
+ * @brief Returns the number of times the value is divisible by five.
+ */
+uint32_t pow5Factor(uint32_t value)
+{
+    uint32_t count = 0;
+
+    while (value % 5 == 0)
+    {
+        value /= 5;
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns the bit length of 5^e(for e in [0, 3528]).
+ */
+int32_t pow5Bits(int32_t e)
+{
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+/**
+ * @brief Returns floor(log10(2^e))(for e in [0, 1650]).
+ */
+int32_t log10Pow2(int32_t e)
+{
+    return (int32_t)(((uint32_t)e * 78913) >> 18);
+}
+
+/**
+ * @brief Returns floor(log10(5^e))(for e in [0, 2620]).
+ */
+int32_t log10Pow5(int32_t e)
+{
+    return (int32_t)(((uint32_t)e * 732923) >> 20);
+}
+
+#endif
+
+#if CPARSER_CONFIG_REAL
+
+/**
+ * @brief Writes the low decimal digits of a value, zero padded to the given
+ * count. Output isn't null terminated.
+ * 
+ * @param value: Value to be written.
+ * @param count: Number of digits to be written.
+ * @param output: Output buffer.
+ */
+void writeWideDigits(uint64_t value, uint8_t count, char *output)
+{
+    while (count > 0)
+    {
+        output[--count] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+#endif
+
+/**
+ * @brief Returns the number of decimal digits of a value(at least one).
+ */
+uint8_t countDigits(uint32_t value)
+{
+    uint8_t count = 1;
+
+    while (value >= 10000)
+    {
+        value /= 10000;
+        count += 4;
+    }
+
+    if (value >= 100)
+    {
+        count += (value >= 1000) ? 3 : 2;
+    }
+    else if (value >= 10)
+    {
+        count += 1;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Writes the digits of a value right to left, two at a time.
+ * 
+ * @param value: Value to be written.
+ * @param count: Number of digits of the value.
+ * @param output: Output buffer.
+ */
+void writeDigits(uint32_t value, uint8_t count, char *output)
+{
+    char *cursor = output + count;
+
+    while (value >= 100)
+    {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        cursor -= 2;
+        cursor[0] = DigitPairs[pair];
+        cursor[1] = DigitPairs[pair + 1];
+    }
+
+    if (value >= 10)
+    {
+        cursor -= 2;
+        cursor[0] = DigitPairs[value * 2];
+        cursor[1] = DigitPairs[value * 2 + 1];
+    }
+    else
+    {
+        *--cursor = (char)('0' + value);
+    }
+}
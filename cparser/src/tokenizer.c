@@ -0,0 +1,739 @@
+/**
+ * @file tokenizer.c
+ * 
+ * Field tokenizer module. Vector implementations classify a block of
+ * characters at once into a bit mask(one bit per character, set for the
+ * field characters) and turn the mask edges into fields. Characters left
+ * after the last complete block go through the same mask routine, so every
+ * implementation produces exactly the same fields.
+ */
+#include "../inc/tokenizer.h"
+#include <string.h>
+
+#if CPARSER_CONFIG_TOKENIZER_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TOKENIZER_X86 1
+#include <immintrin.h>
+#else
+#define TOKENIZER_X86 0
+#endif
+
+/* Cached selections are written by whichever thread gets there first; the
+accesses are atomic so the concurrent parsers don't race on them. */
+#if defined(__GNUC__)
+#define LOAD_CACHED(variable) __atomic_load_n(&(variable), __ATOMIC_RELAXED)
+#define STORE_CACHED(variable, value) __atomic_store_n(&(variable), (value), __ATOMIC_RELAXED)
+#else
+#define LOAD_CACHED(variable) (variable)
+#define STORE_CACHED(variable, value) ((variable) = (value))
+#endif
+
+/* Bodies of the tokenizers are inlined with a constant framed flag, so the 
+checksum code is left out of the plain lines. */
+#if defined(__GNUC__)
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define ALWAYS_INLINE inline
+#endif
+
+/* Private typedefs --------------------------------------------------------*/
+typedef struct
+{
+    Field_t *fields;
+    uint8_t maxFields;
+    uint16_t fieldCount;
+    uint16_t fieldStart;
+    uint32_t inField;
+    char terminator; /* Ends the line besides the new line character. */
+    uint8_t checksum; /* XOR of the characters before the stop. */
+} State_t;
+
+/* Private constants -------------------------------------------------------*/
+#if TOKENIZER_X86
+/* Loaded at 32 - n, gives a mask of the first n characters of a block. */
+static const uint8_t PrefixMask[64] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+#endif
+
+/* Private function prototypes ---------------------------------------------*/
+static ALWAYS_INLINE uint16_t parseFields(Tokenizer_Impl_t impl, const char *input,
+                                          uint16_t inputLength, State_t *state, Bool_t framed);
+static ALWAYS_INLINE uint16_t parseFieldsScalar(const char *input, uint16_t inputLength,
+                                                State_t *state, Bool_t framed);
+static uint16_t parseLineScalar(const char *input, uint16_t inputLength, State_t *state);
+static uint16_t parseFramedScalar(const char *input, uint16_t inputLength, State_t *state);
+static void addFields(State_t *state, uint32_t mask, uint8_t count, uint16_t base);
+static uint16_t finish(State_t *state, uint16_t stop, uint8_t *numOfFields);
+static uint32_t countTrailingZeros(uint32_t value);
+static Tokenizer_Impl_t getCachedImpl(void);
+#if TOKENIZER_X86
+static uint16_t parseLineSse2(const char *input, uint16_t start, uint16_t inputLength,
+                              State_t *state);
+static uint16_t parseFramedSse2(const char *input, uint16_t start, uint16_t inputLength,
+                                State_t *state);
+static uint16_t parseLineAvx2(const char *input, uint16_t inputLength, State_t *state);
+static uint16_t parseFramedAvx2(const char *input, uint16_t inputLength, State_t *state);
+#endif
+
+/* Exported functions ------------------------------------------------------*/
+/**
+ * @brief Parses fields of a line with the fastest supported implementation.
+ * Fields are separated by spaces or carriage returns, parsing stops at the
+ * first new line character so the same pass finds the end of the line. If
+ * the line is longer than TOKENIZER_MAX_LINE_LENGTH characters or has more
+ * than maxFields fields, number of fields is returned as
+ * TOKENIZER_FIELD_COUNT_INVALID.
+ * 
+ * @param input: Line char array.
+ * @param inputLength: Length of the char array.
+ * @param fields: Pointer to return fields of the line.
+ * @param maxFields: Capacity of the fields array.
+ * @param numOfFields: Pointer to return number of fields.
+ * 
+ * @retval Length of the line except the terminator.
+ */
+uint16_t Tokenizer_ParseFields(const char *input, uint16_t inputLength, Field_t *fields,
+                               uint8_t maxFields, uint8_t *numOfFields)
+{
+    return Tokenizer_ParseFieldsWith(getCachedImpl(), input, inputLength, fields, maxFields,
+                                     numOfFields);
+}
+
+/**
+ * @brief Parses fields of a line with the given implementation. Falls back to
+ * the scalar implementation if the given one isn't supported.
+ * 
+ * @param impl: Tokenizer implementation.
+ * @param input: Line char array.
+ * @param inputLength: Length of the char array.
+ * @param fields: Pointer to return fields of the line.
+ * @param maxFields: Capacity of the fields array.
+ * @param numOfFields: Pointer to return number of fields.
+ * 
+ * @retval Length of the line except the terminator.
+ */
+uint16_t Tokenizer_ParseFieldsWith(Tokenizer_Impl_t impl, const char *input,
+                                   uint16_t inputLength, Field_t *fields, uint8_t maxFields,
+                                   uint8_t *numOfFields)
+{
+    State_t state = {fields, maxFields, 0, 0, 0, '\n', 0};
+    uint16_t stop = parseFields(impl, input, inputLength, &state, FALSE);
+
+    return finish(&state, stop, numOfFields);
+}
+
+/**
+ * @brief Parses fields of the first line of a buffer of new line separated 
+ * lines with the fastest supported implementation. Line is split and 
+ * tokenized in the same pass. A line which doesn't fit into the tokenizer 
+ * window is skipped up to its terminator and its number of fields is 
+ * returned as TOKENIZER_FIELD_COUNT_INVALID.
+ * 
+ * @param buffer: Pointer to the buffer.
+ * @param length: Length of the buffer; should be bigger than zero.
+ * @param fields: Pointer to return fields of the line.
+ * @param maxFields: Capacity of the fields array.
+ * @param numOfFields: Pointer to return number of fields.
+ * @param lineLength: Pointer to return length of the line except the 
+ * terminator, can be NULL.
+ * 
+ * @retval Number of bytes consumed, including the line terminator.
+ */
+size_t Tokenizer_ParseNextLine(const char *buffer, size_t length, Field_t *fields,
+                               uint8_t maxFields, uint8_t *numOfFields, size_t *lineLength)
+{
+    uint16_t window = (length > 0xFFFF) ? 0xFFFF : (uint16_t)length;
+    size_t line_length = Tokenizer_ParseFields(buffer, window, fields, maxFields, numOfFields);
+
+    if (line_length == window && window < length)
+    {
+        const char *end = memchr(&buffer[window], '\n', length - window);
+        line_length = end ? (size_t)(end - buffer) : length;
+        *numOfFields = TOKENIZER_FIELD_COUNT_INVALID;
+    }
+
+    if (lineLength)
+    {
+        *lineLength = line_length;
+    }
+
+    // Jump over the line and its terminator.
+    return (line_length < length) ? line_length + 1 : length;
+}
+
+/**
+ * @brief Parses fields of a framed line("N<line> ... *<checksum>") with the
+ * fastest supported implementation. Parsing stops at the checksum marker
+ * '*' as well as the new line character, and the same pass computes the 
+ * checksum; XOR of the characters before the stop.
+ * 
+ * @param input: Line char array.
+ * @param inputLength: Length of the char array.
+ * @param fields: Pointer to return fields of the line.
+ * @param maxFields: Capacity of the fields array.
+ * @param numOfFields: Pointer to return number of fields.
+ * @param checksum: Pointer to return the checksum.
+ * 
+ * @retval Index where the parsing stopped; index of the '*' if there is one.
+ */
+uint16_t Tokenizer_ParseFramedFields(const char *input, uint16_t inputLength, Field_t *fields,
+                                     uint8_t maxFields, uint8_t *numOfFields, uint8_t *checksum)
+{
+    return Tokenizer_ParseFramedFieldsWith(getCachedImpl(), input, inputLength, fields,
+                                           maxFields, numOfFields, checksum);
+}
+
+/**
+ * @brief Parses fields of a framed line with the given implementation. Falls
+ * back to the scalar implementation if the given one isn't supported.
+ * 
+ * @param impl: Tokenizer implementation.
+ * @param input: Line char array.
+ * @param inputLength: Length of the char array.
+ * @param fields: Pointer to return fields of the line.
+ * @param maxFields: Capacity of the fields array.
+ * @param numOfFields: Pointer to return number of fields.
+ * @param checksum: Pointer to return the checksum.
+ * 
+ * @retval Index where the parsing stopped; index of the '*' if there is one.
+ */
+uint16_t Tokenizer_ParseFramedFieldsWith(Tokenizer_Impl_t impl, const char *input,
+                                         uint16_t inputLength, Field_t *fields,
+                                         uint8_t maxFields, uint8_t *numOfFields,
+                                         uint8_t *checksum)
+{
+    State_t state = {fields, maxFields, 0, 0, 0, '*', 0};
+    uint16_t stop = parseFields(impl, input, inputLength, &state, TRUE);
+
+    *checksum = state.checksum;
+    return finish(&state, stop, numOfFields);
+}
+
+/**
+ * @brief Parses fields of a sub-command with the fastest supported 
+ * implementation. Parsing stops at the command separator ';' as well as the
+ * new line character, so the sub-commands of a line(e.g. 
+ * "move D1 S5; pump MD V1.25") are tokenized one after the other in a single
+ * scan of the line.
+ * 
+ * @param input: Sub-command char array.
+ * @param inputLength: Length of the char array.
+ * @param fields: Pointer to return fields of the sub-command.
+ * @param maxFields: Capacity of the fields array.
+ * @param numOfFields: Pointer to return number of fields.
+ * 
+ * @retval Index where the parsing stopped; index of the ';' if there is one.
+ */
+uint16_t Tokenizer_ParseCommandFields(const char *input, uint16_t inputLength, Field_t *fields,
+                                      uint8_t maxFields, uint8_t *numOfFields)
+{
+    return Tokenizer_ParseCommandFieldsWith(getCachedImpl(), input, inputLength, fields,
+                                            maxFields, numOfFields);
+}
+
+/**
+ * @brief Parses fields of a sub-command with the given implementation. Falls
+ * back to the scalar implementation if the given one isn't supported.
+ * 
+ * @param impl: Tokenizer implementation.
+ * @param input: Sub-command char array.
+ * @param inputLength: Length of the char array.
+ * @param fields: Pointer to return fields of the sub-command.
+ * @param maxFields: Capacity of the fields array.
+ * @param numOfFields: Pointer to return number of fields.
+ * 
+ * @retval Index where the parsing stopped; index of the ';' if there is one.
+ */
+uint16_t Tokenizer_ParseCommandFieldsWith(Tokenizer_Impl_t impl, const char *input,
+                                          uint16_t inputLength, Field_t *fields,
+                                          uint8_t maxFields, uint8_t *numOfFields)
+{
+    State_t state = {fields, maxFields, 0, 0, 0, ';', 0};
+    uint16_t stop = parseFields(impl, input, inputLength, &state, FALSE);
+
+    return finish(&state, stop, numOfFields);
+}
+
+/**
+ * @brief Checks if the implementation can run on this processor.
+ * 
+ * @param impl: Tokenizer implementation.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t Tokenizer_IsSupported(Tokenizer_Impl_t impl)
+{
+    static uint8_t cached = 0;
+    uint8_t supported = LOAD_CACHED(cached);
+
+    // Processor features are queried once; bit zero marks the query as done.
+    if (supported == 0)
+    {
+        uint8_t features = 1U | (1U << (TOKENIZER_IMPL_SCALAR + 1));
+#if TOKENIZER_X86
+        features |= __builtin_cpu_supports("sse2") ? (1U << (TOKENIZER_IMPL_SSE2 + 1)) : 0;
+        features |= __builtin_cpu_supports("avx2") ? (1U << (TOKENIZER_IMPL_AVX2 + 1)) : 0;
+#endif
+        supported = features;
+        STORE_CACHED(cached, supported);
+    }
+
+    return (impl <= TOKENIZER_IMPL_AVX2 && (supported & (1U << (impl + 1)))) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Gets the fastest implementation supported by this processor.
+ * 
+ * @retval Tokenizer implementation.
+ */
+Tokenizer_Impl_t Tokenizer_GetImpl(void)
+{
+    if (Tokenizer_IsSupported(TOKENIZER_IMPL_AVX2))
+    {
+        return TOKENIZER_IMPL_AVX2;
+    }
+
+    if (Tokenizer_IsSupported(TOKENIZER_IMPL_SSE2))
+    {
+        return TOKENIZER_IMPL_SSE2;
+    }
+
+    return TOKENIZER_IMPL_SCALAR;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Gets the implementation which is selected for this processor.
+ * 
+ * @retval Tokenizer implementation.
+ */
+Tokenizer_Impl_t getCachedImpl(void)
+{
+    static Tokenizer_Impl_t cached = 0xFF;
+    Tokenizer_Impl_t impl = LOAD_CACHED(cached);
+
+    // Selection is idempotent, so racing first calls are harmless.
+    if (impl == 0xFF)
+    {
+        impl = Tokenizer_GetImpl();
+        STORE_CACHED(cached, impl);
+    }
+
+    return impl;
+}
+
+/**
+ * @brief Runs the given implementation, or the scalar one if it isn't 
+ * supported.
+ * 
+ * @param impl: Tokenizer implementation.
+ * @param input: Line char array.
+ * @param inputLength: Length of the char array.
+ * @param state: Pointer to the tokenizer state.
+ * @param framed: Whether the checksum is computed, should be a constant.
+ * 
+ * @retval Index where the parsing stopped.
+ */
+ALWAYS_INLINE uint16_t parseFields(Tokenizer_Impl_t impl, const char *input,
+                                   uint16_t inputLength, State_t *state, Bool_t framed)
+{
+    switch (Tokenizer_IsSupported(impl) ? impl : TOKENIZER_IMPL_SCALAR)
+    {
+#if TOKENIZER_X86
+    case TOKENIZER_IMPL_SSE2:
+        return framed ? parseFramedSse2(input, 0, inputLength, state)
+                      : parseLineSse2(input, 0, inputLength, state);
+
+    case TOKENIZER_IMPL_AVX2:
+        return framed ? parseFramedAvx2(input, inputLength, state)
+                      : parseLineAvx2(input, inputLength, state);
+#endif
+
+    default:
+        return framed ? parseFramedScalar(input, inputLength, state)
+                      : parseLineScalar(input, inputLength, state);
+    }
+}
+
+/**
+ * @brief Scalar tokenizer, checks one character at a time.
+ * 
+ * @param input: Line char array.
+ * @param inputLength: Length of the char array.
+ * @param state: Pointer to the tokenizer state.
+ * @param framed: Whether the checksum is computed, should be a constant.
+ * 
+ * @retval Index where the parsing stopped.
+ */
+ALWAYS_INLINE uint16_t parseFieldsScalar(const char *input, uint16_t inputLength,
+                                         State_t *state, Bool_t framed)
+{
+    uint8_t checksum = 0;
+    uint16_t i;
+
+    for (i = 0; i < inputLength; i++)
+    {
+        char c = input[i];
+
+        if (c == '\n' || c == state->terminator)
+        {
+            break;
+        }
+
+        if (framed)
+        {
+            checksum ^= (uint8_t)c;
+        }
+
+        // If seperator found, this is the end of the current field. Otherwise
+        //a non-separator character after a separator starts the next field.
+        if (c == ' ' || c == '\r')
+        {
+            addFields(state, 0, 1, i);
+        }
+        else if (!state->inField)
+        {
+            state->fieldStart = i;
+            state->inField = 1;
+        }
+    }
+
+    state->checksum ^= checksum;
+    return i;
+}
+
+/**
+ * @brief Scalar tokenizer of the plain lines.
+ */
+uint16_t parseLineScalar(const char *input, uint16_t inputLength, State_t *state)
+{
+    return parseFieldsScalar(input, inputLength, state, FALSE);
+}
+
+/**
+ * @brief Scalar tokenizer of the framed lines, also computes the checksum.
+ */
+uint16_t parseFramedScalar(const char *input, uint16_t inputLength, State_t *state)
+{
+    return parseFieldsScalar(input, inputLength, state, TRUE);
+}
+
+/**
+ * @brief Adds the fields of a classified block of characters.
+ * 
+ * @param state: Pointer to the tokenizer state.
+ * @param mask: Bit mask of the field characters in the block.
+ * @param count: Number of characters in the block(1 to 32).
+ * @param base: Index of the first character of the block.
+ */
+void addFields(State_t *state, uint32_t mask, uint8_t count, uint16_t base)
+{
+    uint32_t valid = (count == 32) ? 0xFFFFFFFFU : ((1U << count) - 1);
+    uint32_t previous = (mask << 1) | state->inField;
+    uint32_t edges = (mask ^ previous) & valid;
+
+    // Rising edges start fields, falling edges end them.
+    while (edges)
+    {
+        uint32_t bit = countTrailingZeros(edges);
+        uint16_t idx = base + bit;
+
+        if (mask & (1U << bit))
+        {
+            state->fieldStart = idx;
+        }
+        else
+        {
+            if (state->fieldCount < state->maxFields)
+            {
+                state->fields[state->fieldCount].start = (uint8_t)state->fieldStart;
+                state->fields[state->fieldCount].length = (uint8_t)(idx - state->fieldStart);
+            }
+
+            state->fieldCount++;
+        }
+
+        edges &= edges - 1;
+    }
+
+    state->inField = (mask >> (count - 1)) & 1;
+}
+
+/**
+ * @brief Closes the last field and validates the result.
+ * 
+ * @param state: Pointer to the tokenizer state.
+ * @param stop: Index where the parsing stopped.
+ * @param numOfFields: Pointer to return number of fields.
+ * 
+ * @retval Length of the line.
+ */
+uint16_t finish(State_t *state, uint16_t stop, uint8_t *numOfFields)
+{
+    if (state->inField)
+    {
+        addFields(state, 0, 1, stop);
+    }
+
+    if (state->fieldCount > state->maxFields || stop > TOKENIZER_MAX_LINE_LENGTH)
+    {
+        *numOfFields = TOKENIZER_FIELD_COUNT_INVALID;
+    }
+    else
+    {
+        *numOfFields = (uint8_t)state->fieldCount;
+    }
+
+    return stop;
+}
+
+/**
+ * @brief Counts trailing zero bits of a non-zero value.
+ */
+uint32_t countTrailingZeros(uint32_t value)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(value);
+#else
+    uint32_t count = 0;
+    while ((value & 1U) == 0)
+    {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+#if TOKENIZER_X86
+/**
+ * @brief Folds the XOR of the 16 characters of a block into a character.
+ * 
+ * @param sum: Block of character sums.
+ * 
+ * @retval XOR of the characters.
+ */
+__attribute__((target("sse2"))) static uint8_t reduceXor(__m128i sum)
+{
+    sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 8));
+    sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 4));
+    sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 2));
+    sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 1));
+    return (uint8_t)_mm_cvtsi128_si32(sum);
+}
+
+/**
+ * @brief Folds the upper half of a 32 character block onto its lower half 
+ * with XOR.
+ * 
+ * @param block: Block of characters.
+ * 
+ * @retval Block of 16 character sums.
+ */
+__attribute__((target("avx2"))) static __m128i foldHalves(__m256i block)
+{
+    return _mm_xor_si128(_mm256_castsi256_si128(block), _mm256_extracti128_si256(block, 1));
+}
+
+/**
+ * @brief Classifies the characters of the tail which is shorter than a block.
+ * 
+ * @param input: Line char array.
+ * @param start: Index of the first character of the tail.
+ * @param inputLength: Length of the char array.
+ * @param state: Pointer to the tokenizer state.
+ * @param framed: Whether the checksum is computed, should be a constant.
+ * 
+ * @retval Index where the parsing stopped.
+ */
+static ALWAYS_INLINE uint16_t parseTail(const char *input, uint16_t start, uint16_t inputLength,
+                                        State_t *state, Bool_t framed)
+{
+    uint32_t mask = 0;
+    uint8_t checksum = 0;
+    uint16_t i;
+
+    for (i = start; i < inputLength && input[i] != '\n' && input[i] != state->terminator; i++)
+    {
+        if (framed)
+        {
+            checksum ^= (uint8_t)input[i];
+        }
+        if (input[i] != ' ' && input[i] != '\r')
+        {
+            mask |= 1U << (i - start);
+        }
+    }
+
+    if (i > start)
+    {
+        addFields(state, mask, (uint8_t)(i - start), start);
+    }
+
+    state->checksum ^= checksum;
+    return i;
+}
+
+/**
+ * @brief SSE2 tokenizer, classifies 16 characters at a time.
+ * 
+ * @param input: Line char array.
+ * @param start: Index of the first character to be parsed.
+ * @param inputLength: Length of the char array.
+ * @param state: Pointer to the tokenizer state.
+ * @param framed: Whether the checksum is computed, should be a constant.
+ * 
+ * @retval Index where the parsing stopped.
+ */
+__attribute__((target("sse2"))) static ALWAYS_INLINE uint16_t parseFieldsSse2(
+    const char *input, uint16_t start, uint16_t inputLength, State_t *state, Bool_t framed)
+{
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i carriage = _mm_set1_epi8('\r');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i terminator = _mm_set1_epi8(state->terminator);
+    __m128i checksum = _mm_setzero_si128();
+    uint16_t i = start;
+
+    for (; (uint32_t)i + 16 <= inputLength; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)&input[i]);
+        uint32_t separators = (uint32_t)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, carriage)));
+        uint32_t newlines = (uint32_t)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, terminator)));
+
+        if (newlines)
+        {
+            uint32_t count = countTrailingZeros(newlines);
+            if (count)
+            {
+                addFields(state, ~separators & ((1U << count) - 1), (uint8_t)count, i);
+            }
+
+            // Only the characters before the stop are summed.
+            if (framed)
+            {
+                block = _mm_and_si128(block,
+                                      _mm_loadu_si128((const __m128i *)&PrefixMask[32 - count]));
+                state->checksum ^= reduceXor(_mm_xor_si128(checksum, block));
+            }
+            return i + count;
+        }
+
+        if (framed)
+        {
+            checksum = _mm_xor_si128(checksum, block);
+        }
+        addFields(state, ~separators & 0xFFFFU, 16, i);
+    }
+
+    if (framed)
+    {
+        state->checksum ^= reduceXor(checksum);
+    }
+    return parseTail(input, i, inputLength, state, framed);
+}
+
+/**
+ * @brief SSE2 tokenizer of the plain lines.
+ */
+__attribute__((target("sse2"))) uint16_t parseLineSse2(const char *input, uint16_t start,
+                                                       uint16_t inputLength, State_t *state)
+{
+    return parseFieldsSse2(input, start, inputLength, state, FALSE);
+}
+
+/**
+ * @brief SSE2 tokenizer of the framed lines, also computes the checksum.
+ */
+__attribute__((target("sse2"))) uint16_t parseFramedSse2(const char *input, uint16_t start,
+                                                         uint16_t inputLength, State_t *state)
+{
+    return parseFieldsSse2(input, start, inputLength, state, TRUE);
+}
+
+/**
+ * @brief AVX2 tokenizer, classifies 32 characters at a time.
+ * 
+ * @param input: Line char array.
+ * @param inputLength: Length of the char array.
+ * @param state: Pointer to the tokenizer state.
+ * @param framed: Whether the checksum is computed, should be a constant.
+ * 
+ * @retval Index where the parsing stopped.
+ */
+__attribute__((target("avx2"))) static ALWAYS_INLINE uint16_t parseFieldsAvx2(
+    const char *input, uint16_t inputLength, State_t *state, Bool_t framed)
+{
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i carriage = _mm256_set1_epi8('\r');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i terminator = _mm256_set1_epi8(state->terminator);
+    __m128i checksum = _mm_setzero_si128();
+    uint16_t i = 0;
+
+    for (; (uint32_t)i + 32 <= inputLength; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)&input[i]);
+        uint32_t separators = (uint32_t)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, carriage)));
+        uint32_t newlines = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_cmpeq_epi8(block, newline), _mm256_cmpeq_epi8(block, terminator)));
+
+        if (newlines)
+        {
+            uint32_t count = countTrailingZeros(newlines);
+            if (count)
+            {
+                addFields(state, ~separators & ((1U << count) - 1), (uint8_t)count, i);
+            }
+
+            if (framed)
+            {
+                block = _mm256_and_si256(
+                    block, _mm256_loadu_si256((const __m256i *)&PrefixMask[32 - count]));
+                state->checksum ^= reduceXor(_mm_xor_si128(checksum, foldHalves(block)));
+            }
+            return i + count;
+        }
+
+        // Sum is kept in 128 bits; a live 256 bit register across the calls
+        //would keep the upper halves dirty for the SSE code.
+        if (framed)
+        {
+            checksum = _mm_xor_si128(checksum, foldHalves(block));
+        }
+        addFields(state, ~separators, 32, i);
+    }
+
+    if (framed)
+    {
+        state->checksum ^= reduceXor(checksum);
+    }
+
+    // Remaining characters are less than a 32 character block. Upper halves
+    //are cleared first, the SSE2 code would stall on them.
+    _mm256_zeroupper();
+    return framed ? parseFramedSse2(input, i, inputLength, state)
+                  : parseLineSse2(input, i, inputLength, state);
+}
+
+/**
+ * @brief AVX2 tokenizer of the plain lines.
+ */
+__attribute__((target("avx2"))) uint16_t parseLineAvx2(const char *input, uint16_t inputLength,
+                                                       State_t *state)
+{
+    return parseFieldsAvx2(input, inputLength, state, FALSE);
+}
+
+/**
+ * @brief AVX2 tokenizer of the framed lines, also computes the checksum.
+ */
+__attribute__((target("avx2"))) uint16_t parseFramedAvx2(const char *input, uint16_t inputLength,
+                                                         State_t *state)
+{
+    return parseFieldsAvx2(input, inputLength, state, TRUE);
+}
+#endif
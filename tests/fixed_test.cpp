@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "../cparser/inc/cparser.h"
+#include "../cparser/inc/cparser_format.h"
+#include <cstring>
+
+/* Private function prototypes ---------------------------------------------*/
+static void moveTrgCallback(Dictionary_t *params);
+
+/* Private variables -------------------------------------------------------*/
+Cp_Trigger_t FixedTriggerTable[] =
+    {
+        {"move",
+         {{'X', CP_PARAM_TYPE_FIXED, TRUE}, {'N', CP_PARAM_TYPE_INTEGER}},
+         moveTrgCallback,
+         2},
+        {"pump", {{'V', CP_PARAM_TYPE_REAL}}, moveTrgCallback, 1},
+};
+
+static int32_t MoveX;
+static size_t MoveCount;
+
+/* Tests -------------------------------------------------------------------*/
+TEST(FixedTest, NoRealTest)
+{
+    static Cp_Parser_t parser;
+    char line[] = "move X-2.5E1 N3";
+    const char stream[] = "move X0.125\npump V1.5\nmove X1E9\n";
+    char output[32];
+    Dictionary_t params = {};
+
+    // Library of this test is built without the float code.
+    ASSERT_EQ(CPARSER_CONFIG_REAL, 0);
+
+    Cp_RegisterEx(&parser, FixedTriggerTable, 2);
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    EXPECT_EQ(MoveX, -25 * 65536);
+
+    // Real parameters are rejected when they are compiled out.
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, stream, strlen(stream)), 2U);
+    EXPECT_EQ(MoveCount, 3U);
+    EXPECT_EQ(MoveX, INT32_MAX);
+
+    Dictionary_Add(&params, 'X', CP_PARAM_TYPE_FIXED, &MoveX);
+    EXPECT_EQ(Cp_Format("move", &params, output, sizeof(output)), 17U);
+    EXPECT_STREQ(output, "move X32767.99998");
+}
+
+/* Private functions -------------------------------------------------------*/
+void moveTrgCallback(Dictionary_t *params)
+{
+    uint8_t type;
+    void *x = Dictionary_Get(params, 'X', &type);
+
+    MoveCount++;
+    MoveX = x ? *((int32_t *)x) : 0;
+}
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "test_parser.h"
+#include "../cparser/inc/cparser.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Private function prototypes ---------------------------------------------*/
+static void record(const char *name, const Dictionary_t *params);
+
+/* Private variables -------------------------------------------------------*/
+// Same triggers as triggers.spec, for comparing with the generic parser.
+Cp_Trigger_t GeneratedTriggerTable[] =
+    {
+        {"delay", {{'T', CP_PARAM_TYPE_REAL}}, delayTrgCallback, 1},
+        {"versi", {{'V', CP_PARAM_TYPE_INTEGER}}, versionTrgCallback, 1},
+        {"move", {{'D', CP_PARAM_TYPE_REAL}, {'S', CP_PARAM_TYPE_REAL}}, moveTrgCallback, 2},
+        {"pump", {{'M', CP_PARAM_TYPE_LETTER}, {'V', CP_PARAM_TYPE_REAL}}, pumpTrgCallback, 2},
+        {"mode", {{'M', CP_PARAM_TYPE_LETTER, TRUE}}, modeTrgCallback, 1},
+        {"home",
+         {{'X', CP_PARAM_TYPE_INTEGER, TRUE},
+          {'Y', CP_PARAM_TYPE_FIXED},
+          {'#', CP_PARAM_TYPE_LETTER}},
+         homeTrgCallback,
+         3},
+        {"m", {{'Z', CP_PARAM_TYPE_LETTER}}, mTrgCallback, 1},
+};
+
+static std::vector<std::string> Records;
+
+struct GeneratedTest : public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        Records.clear();
+        Cp_Init(&parser);
+        Cp_RegisterEx(&parser, GeneratedTriggerTable,
+                      sizeof(GeneratedTriggerTable) / sizeof(GeneratedTriggerTable[0]));
+    }
+
+    Cp_Parser_t parser;
+};
+
+/* Tests -------------------------------------------------------------------*/
+TEST_F(GeneratedTest, RequiredParamTest)
+{
+    EXPECT_EQ(Test_FeedLine("mode", 4), FALSE);
+    EXPECT_EQ(Test_FeedLine("home Y1.5 #a", 12), FALSE);
+    EXPECT_EQ(Test_FeedLine("home X1 X2", 10), TRUE);
+    EXPECT_EQ(Test_FeedLine("m", 1), TRUE);
+    ASSERT_EQ(Records.size(), 2U);
+    EXPECT_EQ(Records[0], "home X:1:1");
+    EXPECT_EQ(Records[1], "m");
+}
+
+// Generated parser should accept and reject the same lines with the same
+//values as the generic one.
+TEST_F(GeneratedTest, MatchesGenericTest)
+{
+    static const char *const names[] = {"delay", "versi", "move", "pump", "mode", "home",
+                                         "m", "mov", "moves", "mo", "bogus", "hom", "M"};
+    static const char *const params[] = {"D", "S", "M", "V", "T", "X", "Y", "#", "Z", "x"};
+    static const char *const values[] = {"1", "-2.5", "1E2", "0.125", "x", "D", "", "7e-1",
+                                         "12345678901", "3", "-0", "1.5.2"};
+    srand(4321);
+
+    for (int n = 0; n < 20000; n++)
+    {
+        std::string line(rand() % 3, ' ');
+        line += names[rand() % (sizeof(names) / sizeof(names[0]))];
+        for (int i = rand() % 8; i > 0; i--)
+        {
+            line += std::string(1 + rand() % 2, ' ');
+            line += params[rand() % (sizeof(params) / sizeof(params[0]))];
+            line += values[rand() % (sizeof(values) / sizeof(values[0]))];
+        }
+
+        Records.clear();
+        uint8_t expected = Cp_FeedLineEx(&parser, line.data(), line.size());
+        std::vector<std::string> expected_records = Records;
+
+        Records.clear();
+        ASSERT_EQ(Test_FeedLine(line.data(), line.size()), expected) << line;
+        ASSERT_EQ(Records, expected_records) << line;
+    }
+}
+
+/* Private functions -------------------------------------------------------*/
+void delayTrgCallback(Dictionary_t *params)
+{
+    record("delay", params);
+}
+
+void versionTrgCallback(Dictionary_t *params)
+{
+    record("versi", params);
+}
+
+void moveTrgCallback(Dictionary_t *params)
+{
+    record("move", params);
+}
+
+void pumpTrgCallback(Dictionary_t *params)
+{
+    record("pump", params);
+}
+
+void modeTrgCallback(Dictionary_t *params)
+{
+    record("mode", params);
+}
+
+void homeTrgCallback(Dictionary_t *params)
+{
+    record("home", params);
+}
+
+void mTrgCallback(Dictionary_t *params)
+{
+    record("m", params);
+}
+
+/**
+ * @brief Records the trigger name and the parameters in the order they are
+ * given, e.g. "move D:2:1 S:2:5"(letter, type and value).
+ * 
+ * @param name: Trigger name.
+ * @param params: Pointer to the dictionary of parameters.
+ */
+void record(const char *name, const Dictionary_t *params)
+{
+    std::string text = name;
+
+    for (uint8_t i = 0; i < params->numberOfElements; i++)
+    {
+        const void *value = params->values[i];
+        char number[32];
+
+        switch (params->types[i])
+        {
+        case CP_PARAM_TYPE_LETTER:
+            snprintf(number, sizeof(number), "%c", *(const char *)value);
+            break;
+
+        case CP_PARAM_TYPE_REAL:
+            snprintf(number, sizeof(number), "%.9g", *(const float *)value);
+            break;
+
+        default:
+            snprintf(number, sizeof(number), "%d", (int)*(const int32_t *)value);
+            break;
+        }
+
+        text += " ";
+        text += params->keys[i];
+        text += ":" + std::to_string(params->types[i]) + ":" + number;
+    }
+
+    Records.push_back(text);
+}
@@ -0,0 +1,50 @@
+#include "../cparser/inc/cparser_static.hpp"
+#include <utility>
+
+/* Trigger tables which StaticParser should refuse. Each case is compiled by a
+test of its own, which expects the static assertion of its check. */
+
+/* Private function prototypes ---------------------------------------------*/
+static void moveTrgCallback(Dictionary_t *params);
+
+/* Private functions -------------------------------------------------------*/
+template <size_t... I>
+constexpr cparser::Trigger makeTrigger(std::index_sequence<I...>)
+{
+    return cparser::trigger("move", moveTrgCallback,
+                            cparser::param((char)('A' + I), CP_PARAM_TYPE_INTEGER)...);
+}
+
+/* Private variables -------------------------------------------------------*/
+#if defined(STATIC_FAIL_DUPLICATE_NAMES)
+constexpr cparser::Trigger Triggers[] = {
+    cparser::trigger("move", moveTrgCallback, cparser::param('D', CP_PARAM_TYPE_INTEGER)),
+    cparser::trigger("move", moveTrgCallback, cparser::param('S', CP_PARAM_TYPE_INTEGER)),
+};
+#elif defined(STATIC_FAIL_DUPLICATE_LETTERS)
+constexpr cparser::Trigger Triggers[] = {
+    cparser::trigger("move", moveTrgCallback, cparser::param('D', CP_PARAM_TYPE_INTEGER),
+                     cparser::param('D', CP_PARAM_TYPE_REAL)),
+};
+#elif defined(STATIC_FAIL_TOO_MANY_PARAMS)
+constexpr cparser::Trigger Triggers[] = {
+    makeTrigger(std::make_index_sequence<CPARSER_CONFIG_MAX_NUM_OF_PARAMS + 1>()),
+};
+#else
+// Valid table, for checking the cases themselves.
+constexpr cparser::Trigger Triggers[] = {
+    makeTrigger(std::make_index_sequence<CPARSER_CONFIG_MAX_NUM_OF_PARAMS>()),
+};
+#endif
+
+int main()
+{
+    cparser::StaticParser<Triggers> parser;
+
+    return parser.feedLine("move A1") ? 0 : 1;
+}
+
+void moveTrgCallback(Dictionary_t *params)
+{
+    (void)params;
+}
@@ -0,0 +1,181 @@
+#include "gtest/gtest.h"
+#include "../cparser/inc/cparser.h"
+#include "../cparser/inc/cparser_binary.h"
+#include "../cparser/inc/cparser_parallel.h"
+#include "../cparser/inc/cparser_queue.h"
+#include <cstring>
+#include <numeric>
+#include <string>
+
+/* Private function prototypes ---------------------------------------------*/
+static void moveTrgCallback(Dictionary_t *params);
+
+/* Private variables -------------------------------------------------------*/
+Cp_Trigger_t StatsTriggerTable[] =
+    {
+        {"stop", {}, moveTrgCallback, 0},
+        {"move",
+         {{'X', CP_PARAM_TYPE_INTEGER, TRUE}, {'F', CP_PARAM_TYPE_REAL}},
+         moveTrgCallback,
+         2},
+};
+
+static size_t MoveCount;
+
+/* Tests -------------------------------------------------------------------*/
+TEST(StatsTest, RejectReasonsTest)
+{
+    static Cp_Parser_t parser;
+    Cp_Stats_t stats;
+    char line[] = "move X1";
+    const char buffer[] = "move X2 F1.5\n"
+                          "jump X3\n"
+                          "move Xa\n"
+                          "move F2\n"
+                          "\n"
+                          "move X1 X2 X3 X4 X5 X6 X7\n"
+                          "stop\n";
+
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, StatsTriggerTable, 2);
+    MoveCount = 0;
+
+    EXPECT_EQ(Cp_FeedLineEx(&parser, line, (uint16_t)strlen(line)), TRUE);
+    Cp_FeedBufferEx(&parser, buffer, sizeof(buffer) - 1);
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, "move X5\nmove X5 F?\nhalt\n", 24), 1U);
+
+    EXPECT_EQ(Cp_GetStatsEx(&parser, &stats), TRUE);
+    EXPECT_EQ(stats.accepted, 4U);
+    EXPECT_EQ(stats.hits[0], 1U);
+    EXPECT_EQ(stats.hits[1], 3U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_NONE], 0U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_UNKNOWN_TRIGGER], 2U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_MALFORMED_VALUE], 2U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_MISSING_PARAM], 1U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_OVERSIZED], 1U);
+
+    // Stream lines aren't decoded in one go, so only the line and buffer
+    //decodes are timed; every callback is timed.
+    EXPECT_EQ(std::accumulate(stats.parseTime, stats.parseTime + CP_STATS_HISTOGRAM_SIZE,
+                              (size_t)0),
+              7U);
+    EXPECT_EQ(std::accumulate(stats.callbackTime, stats.callbackTime + CP_STATS_HISTOGRAM_SIZE,
+                              (size_t)0),
+              MoveCount);
+
+    Cp_ResetEx(&parser);
+    Cp_GetStatsEx(&parser, &stats);
+    EXPECT_EQ(stats.accepted, 0U);
+    EXPECT_EQ(stats.hits[1], 0U);
+}
+
+TEST(StatsTest, FrameTest)
+{
+    static Cp_Parser_t parser;
+    Cp_Stats_t stats;
+    uint8_t buffer[4 * CP_BINARY_MAX_FRAME_SIZE];
+    size_t length = 0;
+    size_t size;
+
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, StatsTriggerTable, 2);
+    MoveCount = 0;
+
+    // Frames are counted like the lines; an accepted one, one with an unknown
+    //trigger and one cut at the end of the buffer.
+    length += Cp_TranscodeLineEx(&parser, "move X2 F1.5", 12, &buffer[length],
+                                 sizeof(buffer) - length);
+    size = Cp_TranscodeLineEx(&parser, "stop", 4, &buffer[length], sizeof(buffer) - length);
+    buffer[length + 1] = 7;
+    length += size;
+    length += Cp_TranscodeLineEx(&parser, "move X3", 7, &buffer[length], sizeof(buffer) - length);
+
+    // Transcoding decodes the lines, so it starts over to count the frames only.
+    Cp_ResetEx(&parser);
+    Cp_RegisterEx(&parser, StatsTriggerTable, 2);
+
+    Cp_FeedResult_t result = Cp_FeedFramesEx(&parser, buffer, length - 1);
+    EXPECT_EQ(result.accepted, 1U);
+    EXPECT_EQ(result.rejected, 2U);
+
+    EXPECT_EQ(Cp_GetStatsEx(&parser, &stats), TRUE);
+    EXPECT_EQ(stats.accepted, 1U);
+    EXPECT_EQ(stats.hits[1], 1U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_UNKNOWN_TRIGGER], 1U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_MALFORMED_VALUE], 1U);
+    EXPECT_EQ(std::accumulate(stats.parseTime, stats.parseTime + CP_STATS_HISTOGRAM_SIZE,
+                              (size_t)0),
+              2U);
+    EXPECT_EQ(std::accumulate(stats.callbackTime, stats.callbackTime + CP_STATS_HISTOGRAM_SIZE,
+                              (size_t)0),
+              MoveCount);
+}
+
+TEST(StatsTest, QueueTest)
+{
+    static Cp_Parser_t parser;
+    static Cp_Command_t storage[2];
+    static Cp_Queue_t queue;
+    Cp_Stats_t stats;
+
+    ASSERT_TRUE(Cp_QueueInit(&queue, storage, 2));
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, StatsTriggerTable, 2);
+    Cp_SetQueueEx(&parser, &queue);
+    MoveCount = 0;
+
+    // Line which doesn't fit into the full queue isn't counted as accepted.
+    Cp_FeedResult_t result = Cp_FeedBufferEx(&parser, "move X1\nstop\nmove X2\n", 21);
+    EXPECT_EQ(result.accepted, 2U);
+    EXPECT_EQ(result.rejected, 1U);
+
+    EXPECT_EQ(Cp_GetStatsEx(&parser, &stats), TRUE);
+    EXPECT_EQ(stats.accepted, 2U);
+    EXPECT_EQ(stats.hits[0], 1U);
+    EXPECT_EQ(stats.hits[1], 1U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_DROPPED], 1U);
+
+    // Callbacks of the queued commands are timed when they are dispatched.
+    EXPECT_EQ(std::accumulate(stats.callbackTime, stats.callbackTime + CP_STATS_HISTOGRAM_SIZE,
+                              (size_t)0),
+              0U);
+    EXPECT_EQ(Cp_QueueDispatch(&queue, 0), 2U);
+    Cp_GetStatsEx(&parser, &stats);
+    EXPECT_EQ(std::accumulate(stats.callbackTime, stats.callbackTime + CP_STATS_HISTOGRAM_SIZE,
+                              (size_t)0),
+              2U);
+    EXPECT_EQ(MoveCount, 2U);
+}
+
+TEST(StatsTest, ParallelFeedTest)
+{
+    static Cp_Parser_t parser;
+    Cp_ParallelConfig_t config = {4, 64, FALSE};
+    Cp_Stats_t stats;
+    std::string buffer;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        buffer += (i % 10) ? "move X1 F2\n" : "move F2\n";
+    }
+
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, StatsTriggerTable, 2);
+
+    Cp_FeedBufferParallel(&parser, buffer.data(), buffer.size(), &config);
+    Cp_GetStatsEx(&parser, &stats);
+
+    EXPECT_EQ(stats.accepted, 900U);
+    EXPECT_EQ(stats.hits[1], 900U);
+    EXPECT_EQ(stats.rejected[CP_REJECT_REASON_MISSING_PARAM], 100U);
+    EXPECT_EQ(std::accumulate(stats.callbackTime, stats.callbackTime + CP_STATS_HISTOGRAM_SIZE,
+                              (size_t)0),
+              900U);
+}
+
+/* Private functions -------------------------------------------------------*/
+void moveTrgCallback(Dictionary_t *params)
+{
+    (void)params;
+    MoveCount++;
+}
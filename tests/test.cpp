@@ -1,12 +1,38 @@
 #include "gtest/gtest.h"
 #include "stdlib.h"
 #include "../cparser/inc/cparser.h"
+#include "../cparser/inc/tokenizer.h"
+#include "../cparser/inc/number.h"
+#include "../cparser/inc/cparser_parallel.h"
+#include "../cparser/inc/cparser_queue.h"
+#include "../cparser/inc/cparser_registry.h"
+#include "../cparser/inc/cparser_binary.h"
+#include "../cparser/inc/cparser_format.h"
+#include "../cparser/inc/cparser_cache.h"
+#include "../cparser/inc/cparser.hpp"
+#include "../cparser/inc/cparser_static.hpp"
+#include "test_parser.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 /* Private function prototypes ---------------------------------------------*/
-static void versionTrgCallback(Dictionary_t *params);
-static void pumpTrgCallback(Dictionary_t *params);
-static void moveTrgCallback(Dictionary_t *params);
-static void delayTrgCallback(Dictionary_t *params);
+static void countTrgCallback(Dictionary_t *params);
+static void sequenceTrgCallback(Dictionary_t *params);
+static void bindTrgCallback(Dictionary_t *params);
+static void typedTrgCallback(void *output, uint32_t present);
+static void fixedTrgCallback(void *output, uint32_t present);
 
 /* Private variables -------------------------------------------------------*/
 Cp_Trigger_t TriggerTable[] =
@@ -57,7 +83,45 @@ static char pumpTrgMode;
 static Cp_ParamType_t pumpTrgVolumeType;
 static Cp_ParamType_t pumpTrgModeType;
 
-struct CparserTest : public ::testing::Test
+static thread_local int32_t countTrgSum;
+static thread_local uint32_t countTrgCalls;
+
+static std::vector<int32_t> sequenceTrgValues;
+static std::mutex sequenceTrgMutex;
+
+static uint32_t bindTrgCalls;
+static int32_t bindTrgX;
+static int32_t bindTrgY;
+static char bindTrgHash;
+
+struct TypedTrgOutput
+{
+    char mode;
+    int32_t count;
+    float speed;
+};
+static TypedTrgOutput typedTrgOutput;
+static uint32_t typedTrgPresent;
+static uint32_t typedTrgCalls;
+
+struct FixedTrgOutput
+{
+    int32_t a;
+    int32_t b;
+};
+static FixedTrgOutput fixedTrgOutput;
+
+/* Entry points which the CparserTest cases run against; the generic parser
+and the one generated from triggers.spec, which has no byte stream feed. */
+struct FeedFunctions
+{
+    const char *name;
+    uint8_t (*feedLine)(const char *input, uint16_t length);
+    Cp_FeedResult_t (*feedBuffer)(const char *buffer, size_t length);
+    size_t (*feedBytes)(const char *data, size_t n);
+};
+
+struct CparserTest : public ::testing::TestWithParam<FeedFunctions>
 {
 public:
     virtual void SetUp() override
@@ -86,33 +150,33 @@ public:
     }
 };
 
-TEST_F(CparserTest, DelayTest)
+TEST_P(CparserTest, DelayTest)
 {
     // Feed commands.
     char line[] = "delay T1E2";
-    Cp_FeedLine(line, sizeof(line) - 1);
+    GetParam().feedLine(line, sizeof(line) - 1);
 
     EXPECT_EQ(delayTrgTriggered, TRUE);
     EXPECT_FLOAT_EQ(delayTrgTime, 100.0f);
     EXPECT_EQ(delayTrgTimeType, CP_PARAM_TYPE_REAL);
 }
 
-TEST_F(CparserTest, VersionTest)
+TEST_P(CparserTest, VersionTest)
 {
     // Feed command.
     char line[] = "versi V10";
-    Cp_FeedLine(line, sizeof(line) - 1);
+    GetParam().feedLine(line, sizeof(line) - 1);
 
     EXPECT_EQ(versionTrgTriggered, TRUE);
     EXPECT_EQ(versionTrgVersion, 10);
     EXPECT_EQ(versionTrgVersionType, CP_PARAM_TYPE_INTEGER);
 }
 
-TEST_F(CparserTest, MoveTest)
+TEST_P(CparserTest, MoveTest)
 {
     // Feed commands.
     char line[] = "move D1.0 S5.0";
-    Cp_FeedLine(line, sizeof(line) - 1);
+    GetParam().feedLine(line, sizeof(line) - 1);
 
     EXPECT_EQ(moveTrgTriggered, TRUE);
     EXPECT_FLOAT_EQ(moveTrgDisplacement, 1.0f);
@@ -121,11 +185,11 @@ TEST_F(CparserTest, MoveTest)
     EXPECT_EQ(moveTrgSpeedType, CP_PARAM_TYPE_REAL);
 }
 
-TEST_F(CparserTest, PumpTest)
+TEST_P(CparserTest, PumpTest)
 {
     // Feed commands.
     char line[] = "pump V1.25 MD";
-    Cp_FeedLine(line, sizeof(line) - 1);
+    GetParam().feedLine(line, sizeof(line) - 1);
 
     EXPECT_EQ(pumpTrgTriggered, TRUE);
     EXPECT_FLOAT_EQ(pumpTrgVolume, 1.25);
@@ -134,6 +198,1748 @@ TEST_F(CparserTest, PumpTest)
     EXPECT_EQ(pumpTrgModeType, CP_PARAM_TYPE_LETTER);
 }
 
+TEST_P(CparserTest, UnknownTriggerTest)
+{
+    // Prefixes and extensions of the registered names shouldn't match.
+    char prefix[] = "mov D1.0";
+    char extension[] = "moves D1.0";
+
+    EXPECT_EQ(GetParam().feedLine(prefix, sizeof(prefix) - 1), FALSE);
+    EXPECT_EQ(GetParam().feedLine(extension, sizeof(extension) - 1), FALSE);
+    EXPECT_EQ(moveTrgTriggered, FALSE);
+}
+
+TEST_P(CparserTest, StreamTest)
+{
+    // Feed a line in arbitrary pieces.
+    const char piece1[] = "mo";
+    const char piece2[] = "ve D1.5 S";
+    const char piece3[] = "-2.5E1\r\n";
+
+    if (!GetParam().feedBytes)
+    {
+        GTEST_SKIP();
+    }
+
+    EXPECT_EQ(GetParam().feedBytes(piece1, sizeof(piece1) - 1), 0U);
+    EXPECT_EQ(GetParam().feedBytes(piece2, sizeof(piece2) - 1), 0U);
+    EXPECT_EQ(moveTrgTriggered, FALSE);
+    EXPECT_EQ(GetParam().feedBytes(piece3, sizeof(piece3) - 1), 1U);
+
+    EXPECT_EQ(moveTrgTriggered, TRUE);
+    EXPECT_FLOAT_EQ(moveTrgDisplacement, 1.5f);
+    EXPECT_FLOAT_EQ(moveTrgSpeed, -25.0f);
+}
+
+TEST_P(CparserTest, StreamMultipleLinesTest)
+{
+    // Rejected lines shouldn't affect the following ones.
+    const char data[] = "versi V1x\nbogus V2\n\npump MD  V0.5\nversi V-42\n";
+
+    if (!GetParam().feedBytes)
+    {
+        GTEST_SKIP();
+    }
+
+    EXPECT_EQ(GetParam().feedBytes(data, sizeof(data) - 1), 2U);
+
+    EXPECT_EQ(versionTrgTriggered, TRUE);
+    EXPECT_EQ(versionTrgVersion, -42);
+    EXPECT_EQ(pumpTrgTriggered, TRUE);
+    EXPECT_EQ(pumpTrgMode, 'D');
+    EXPECT_FLOAT_EQ(pumpTrgVolume, 0.5f);
+}
+
+TEST_P(CparserTest, BufferTest)
+{
+    // Last line has no terminator; empty lines aren't counted.
+    const char buffer[] = "move D1.0 S5.0\r\n\nbogus\nversi V1x\n  delay T2.5  \npump MD V3";
+    Cp_FeedResult_t result = GetParam().feedBuffer(buffer, sizeof(buffer) - 1);
+
+    EXPECT_EQ(result.accepted, 3U);
+    EXPECT_EQ(result.rejected, 2U);
+    EXPECT_EQ(moveTrgTriggered, TRUE);
+    EXPECT_FLOAT_EQ(moveTrgSpeed, 5.0f);
+    EXPECT_EQ(versionTrgTriggered, FALSE);
+    EXPECT_EQ(delayTrgTriggered, TRUE);
+    EXPECT_FLOAT_EQ(delayTrgTime, 2.5f);
+    EXPECT_EQ(pumpTrgTriggered, TRUE);
+    EXPECT_FLOAT_EQ(pumpTrgVolume, 3.0f);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Feed, CparserTest,
+    ::testing::Values(FeedFunctions{"Generic", Cp_FeedLine, Cp_FeedBuffer, Cp_FeedBytes},
+                      FeedFunctions{"Generated", Test_FeedLine, Test_FeedBuffer, nullptr}),
+    [](const ::testing::TestParamInfo<FeedFunctions> &info) { return info.param.name; });
+
+TEST(TokenizerTest, VectorMatchesScalarTest)
+{
+    // Random lines biased toward separators, terminators and block edges.
+    static const char alphabet[] = "  \r\nDS1.-E";
+    const uint8_t max_fields = 6;
+    srand(1234);
+
+    for (int n = 0; n < 20000; n++)
+    {
+        char line[300];
+        uint16_t length = rand() % sizeof(line);
+        for (uint16_t i = 0; i < length; i++)
+        {
+            line[i] = alphabet[rand() % (sizeof(alphabet) - 1)];
+            if (rand() % 4)
+            {
+                line[i] = (line[i] == '\n') ? 'x' : line[i];
+            }
+        }
+
+        Field_t expected[max_fields];
+        uint8_t expected_count;
+        uint16_t expected_stop = Tokenizer_ParseFieldsWith(TOKENIZER_IMPL_SCALAR, line, length,
+                                                           expected, max_fields, &expected_count);
+
+        for (uint8_t impl = TOKENIZER_IMPL_SSE2; impl <= TOKENIZER_IMPL_AVX2; impl++)
+        {
+            if (!Tokenizer_IsSupported(impl))
+            {
+                continue;
+            }
+
+            Field_t fields[max_fields];
+            uint8_t count;
+            uint16_t stop = Tokenizer_ParseFieldsWith(impl, line, length, fields, max_fields,
+                                                      &count);
+
+            ASSERT_EQ(stop, expected_stop);
+            ASSERT_EQ(count, expected_count);
+            for (uint8_t i = 0; i < count && count != TOKENIZER_FIELD_COUNT_INVALID; i++)
+            {
+                ASSERT_EQ(fields[i].start, expected[i].start);
+                ASSERT_EQ(fields[i].length, expected[i].length);
+            }
+        }
+    }
+}
+
+TEST(TokenizerTest, FramedChecksumTest)
+{
+    // Random lines with checksum markers at all positions of the blocks.
+    static const char alphabet[] = "  \r\nN1*GX.\x7F\xA5";
+    const uint8_t max_fields = 6;
+    srand(4321);
+
+    for (int n = 0; n < 20000; n++)
+    {
+        char line[300];
+        uint16_t length = rand() % sizeof(line);
+        for (uint16_t i = 0; i < length; i++)
+        {
+            line[i] = alphabet[rand() % (sizeof(alphabet) - 1)];
+            if (rand() % 8)
+            {
+                line[i] = (line[i] == '\n' || line[i] == '*') ? 'x' : line[i];
+            }
+        }
+
+        // Reference; stops at the first terminator or marker.
+        uint16_t expected_stop = 0;
+        uint8_t expected_checksum = 0;
+        while (expected_stop < length && line[expected_stop] != '\n' && line[expected_stop] != '*')
+        {
+            expected_checksum ^= (uint8_t)line[expected_stop++];
+        }
+
+        Field_t expected[max_fields];
+        uint8_t expected_count;
+        Tokenizer_ParseFieldsWith(TOKENIZER_IMPL_SCALAR, line, expected_stop, expected, max_fields,
+                                  &expected_count);
+
+        for (uint8_t impl = TOKENIZER_IMPL_SCALAR; impl <= TOKENIZER_IMPL_AVX2; impl++)
+        {
+            if (!Tokenizer_IsSupported(impl))
+            {
+                continue;
+            }
+
+            Field_t fields[max_fields];
+            uint8_t count;
+            uint8_t checksum;
+            uint16_t stop = Tokenizer_ParseFramedFieldsWith(impl, line, length, fields, max_fields,
+                                                            &count, &checksum);
+
+            ASSERT_EQ(stop, expected_stop);
+            ASSERT_EQ(checksum, expected_checksum);
+            ASSERT_EQ(count, expected_count);
+            for (uint8_t i = 0; i < count && count != TOKENIZER_FIELD_COUNT_INVALID; i++)
+            {
+                ASSERT_EQ(fields[i].start, expected[i].start);
+                ASSERT_EQ(fields[i].length, expected[i].length);
+            }
+        }
+    }
+}
+
+TEST(TokenizerTest, CommandSeparatorTest)
+{
+    const char line[] = "move D1 S5; pump MD V1.25 ;;versi V3\nversi V4";
+    const char *expected[] = {"move D1 S5", " pump MD V1.25 ", "", "versi V3"};
+
+    for (uint8_t impl = TOKENIZER_IMPL_SCALAR; impl <= TOKENIZER_IMPL_AVX2; impl++)
+    {
+        if (!Tokenizer_IsSupported(impl))
+        {
+            continue;
+        }
+
+        // Each call stops at the next separator; the line ends at the new line.
+        uint16_t offset = 0;
+        for (const char *command : expected)
+        {
+            Field_t fields[6];
+            uint8_t count;
+            uint16_t stop = Tokenizer_ParseCommandFieldsWith(impl, &line[offset],
+                                                             strlen(line) - offset, fields, 6,
+                                                             &count);
+
+            ASSERT_EQ(std::string(&line[offset], stop), command);
+            offset += stop + 1;
+        }
+        EXPECT_EQ(line[offset - 1], '\n');
+    }
+}
+
+TEST_P(CparserTest, RealRoundingTest)
+{
+    // Ties to even, long mantissas, subnormals and the range limits.
+    static const char *values[] = {"16777217", "16777219", "0.1", "3.4028235E38", "3.4028236E38",
+                                   "1E39", "1.401298464E-45", "7E-46", "1E-46",
+                                   "1.00000005960464477539062500000001",
+                                   "1.00000005960464477550", "1.0000000596046447753906251",
+                                   "123456789012345678901234567890E-20", "-0.0", "4E-38"};
+    std::vector<std::string> texts(values, values + sizeof(values) / sizeof(values[0]));
+
+    // Long decimals around the midpoints of random floats, where the digits
+    //beyond the mantissa capacity decide the rounding.
+    srand(2468);
+    for (int n = 0; n < 2000; n++)
+    {
+        char text[64];
+        uint32_t bits = (((uint32_t)rand() << 16) ^ (uint32_t)rand()) % 0x7F000000U;
+        float low;
+        memcpy(&low, &bits, sizeof(low));
+        double midpoint = ((double)low + (double)nextafterf(low, INFINITY)) / 2.0;
+
+        snprintf(text, sizeof(text), "%.*E", 18 + rand() % 22, midpoint);
+        texts.push_back(text);
+    }
+
+    for (const std::string &value : texts)
+    {
+        char line[80];
+        int length = snprintf(line, sizeof(line), "delay T%s", value.c_str());
+        float expected = strtof(value.c_str(), NULL);
+
+        delayTrgTime = 0.0f;
+        EXPECT_EQ(GetParam().feedLine(line, length), TRUE);
+        EXPECT_EQ(memcmp(&delayTrgTime, &expected, sizeof(float)), 0) << value;
+
+        // Byte stream decodes the value digit by digit.
+        if (GetParam().feedBytes)
+        {
+            line[length++] = '\n';
+            delayTrgTime = 0.0f;
+            EXPECT_EQ(GetParam().feedBytes(line, length), 1U);
+            EXPECT_EQ(memcmp(&delayTrgTime, &expected, sizeof(float)), 0) << value;
+        }
+    }
+}
+
+TEST(NumberTest, IntegerTest)
+{
+    int32_t value;
+
+    EXPECT_TRUE(Number_ParseInteger("1234", 4, &value));
+    EXPECT_EQ(value, 1234);
+    EXPECT_TRUE(Number_ParseInteger("-0042", 5, &value));
+    EXPECT_EQ(value, -42);
+    EXPECT_TRUE(Number_ParseInteger("+7", 2, &value));
+    EXPECT_EQ(value, 7);
+    EXPECT_TRUE(Number_ParseInteger("", 0, &value));
+    EXPECT_EQ(value, 0);
+    EXPECT_FALSE(Number_ParseInteger("12a", 3, &value));
+}
+
+TEST(NumberTest, FloatMatchesStrtofTest)
+{
+    srand(4321);
+
+    for (int n = 0; n < 200000; n++)
+    {
+        // Random finite floats printed with random precision, and random 
+        //digit strings with random exponents.
+        char text[64];
+        uint32_t bits = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        float source;
+        memcpy(&source, &bits, sizeof(source));
+
+        if (n % 2 && source == source && source - source == 0.0f)
+        {
+            snprintf(text, sizeof(text), "%.*e", 1 + rand() % 10, source);
+        }
+        else
+        {
+            int length = 0;
+            for (int i = 1 + rand() % 25; i > 0; i--)
+            {
+                text[length++] = '0' + rand() % 10;
+            }
+            text[length++] = '.';
+            text[length++] = '0' + rand() % 10;
+            snprintf(&text[length], sizeof(text) - length, "E%d", rand() % 110 - 70);
+        }
+
+        float value;
+        float expected = strtof(text, NULL);
+        ASSERT_EQ(Number_ParseFloat(text, strlen(text), &value), TRUE) << text;
+        ASSERT_EQ(memcmp(&value, &expected, sizeof(float)), 0) << text;
+    }
+}
+
+TEST(ParserTest, IndependentInstancesTest)
+{
+    static Cp_Trigger_t countTrigger[] = {
+        {"count", {{'N', CP_PARAM_TYPE_INTEGER}}, countTrgCallback, 1}};
+    const uint32_t numOfThreads = 4;
+    const uint32_t numOfLines = 2000;
+    std::vector<uint32_t> calls(numOfThreads);
+    std::vector<int32_t> sums(numOfThreads);
+    std::vector<std::thread> threads;
+
+    for (uint32_t t = 0; t < numOfThreads; t++)
+    {
+        threads.emplace_back([&, t]() {
+            // Zero initialized instance needs no Cp_Init.
+            Cp_Parser_t *parser = new Cp_Parser_t();
+            Cp_RegisterEx(parser, countTrigger, 1);
+
+            std::string line = "count N" + std::to_string(t + 1);
+            std::string stream = line + "\n";
+
+            for (uint32_t i = 0; i < numOfLines; i++)
+            {
+                Cp_FeedLineEx(parser, &line[0], (uint16_t)line.size());
+                Cp_FeedBytesEx(parser, stream.data(), stream.size());
+            }
+
+            calls[t] = countTrgCalls;
+            sums[t] = countTrgSum;
+            delete parser;
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (uint32_t t = 0; t < numOfThreads; t++)
+    {
+        EXPECT_EQ(calls[t], 2 * numOfLines);
+        EXPECT_EQ(sums[t], (int32_t)(2 * numOfLines * (t + 1)));
+    }
+
+    // Default parser isn't affected by the instances.
+    char input[] = "count N1";
+    EXPECT_FALSE(Cp_FeedLine(input, strlen(input)));
+}
+
+TEST(ParserTest, ParallelFeedTest)
+{
+    static Cp_Trigger_t sequenceTrigger[] = {
+        {"seq", {{'N', CP_PARAM_TYPE_INTEGER}}, sequenceTrgCallback, 1}};
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    std::vector<int32_t> expected;
+    std::string buffer;
+
+    int64_t expected_sum = 0;
+
+    Cp_RegisterEx(parser, sequenceTrigger, 1);
+
+    // Mix of valid, rejected, empty and too long lines.
+    for (int32_t i = 0; i < 5000; i++)
+    {
+        switch (i % 7)
+        {
+        case 3:
+            buffer += "seq Nx\n";
+            break;
+        case 5:
+            buffer += "\n";
+            break;
+        case 6:
+            buffer += "seq N1 " + std::string(300, 'Z') + "\n";
+            break;
+        default:
+            buffer += "seq N" + std::to_string(i) + "\n";
+            break;
+        }
+    }
+    buffer += "seq N-1";
+
+    sequenceTrgValues.clear();
+    Cp_FeedResult_t serial = Cp_FeedBufferEx(parser, buffer.data(), buffer.size());
+    expected = sequenceTrgValues;
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        expected_sum += expected[i];
+    }
+
+    // Small chunks, so lines cross the chunk boundaries.
+    static const size_t chunkSizes[] = {1, 64, 1000, 1 << 20};
+    for (size_t c = 0; c < sizeof(chunkSizes) / sizeof(chunkSizes[0]); c++)
+    {
+        Cp_ParallelConfig_t config = {4, chunkSizes[c], FALSE};
+
+        sequenceTrgValues.clear();
+        Cp_FeedResult_t ordered = Cp_FeedBufferParallel(parser, buffer.data(), buffer.size(),
+                                                        &config);
+        EXPECT_EQ(ordered.accepted, serial.accepted);
+        EXPECT_EQ(ordered.rejected, serial.rejected);
+        EXPECT_TRUE(sequenceTrgValues == expected);
+
+        config.unordered = TRUE;
+        sequenceTrgValues.clear();
+        Cp_FeedResult_t unordered = Cp_FeedBufferParallel(parser, buffer.data(), buffer.size(),
+                                                          &config);
+        EXPECT_EQ(unordered.accepted, serial.accepted);
+        EXPECT_EQ(unordered.rejected, serial.rejected);
+
+        int64_t sum = 0;
+        for (size_t i = 0; i < sequenceTrgValues.size(); i++)
+        {
+            sum += sequenceTrgValues[i];
+        }
+        EXPECT_EQ(sum, expected_sum);
+    }
+
+    // Attached queue and line cache are bypassed; callbacks still run.
+    static Cp_Command_t storage[4];
+    static Cp_Queue_t queue;
+    static Cp_LineCache_t cache;
+    Cp_Command_t command;
+    Cp_ParallelConfig_t config = {4, 1000, FALSE};
+
+    ASSERT_TRUE(Cp_QueueInit(&queue, storage, 4));
+    Cp_LineCacheInit(&cache);
+    Cp_SetQueueEx(parser, &queue);
+    Cp_SetLineCacheEx(parser, &cache);
+    sequenceTrgValues.clear();
+    Cp_FeedResult_t bypassed = Cp_FeedBufferParallel(parser, buffer.data(), buffer.size(), &config);
+    EXPECT_EQ(bypassed.accepted, serial.accepted);
+    EXPECT_TRUE(sequenceTrgValues == expected);
+    EXPECT_FALSE(Cp_QueuePop(&queue, &command));
+    EXPECT_EQ(Cp_QueueGetDropped(&queue), 0U);
+    EXPECT_EQ(Cp_LineCacheGetHits(&cache) + Cp_LineCacheGetMisses(&cache), 0U);
+
+    delete parser;
+}
+
+TEST(ParserTest, ParamBindingTest)
+{
+    static Cp_Trigger_t bindTrigger[] = {
+        {"bind",
+         {{'X', CP_PARAM_TYPE_INTEGER, TRUE},
+          {'y', CP_PARAM_TYPE_INTEGER},
+          {'#', CP_PARAM_TYPE_LETTER}},
+         bindTrgCallback,
+         3}};
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    char lines[][32] = {"bind y2 X1 #q", "bind X3 X4 y5 y6", "bind y7", "bind X8 Xa",
+                        "bind Xb X9"};
+    const char stream[] = "bind y7\nbind #z y6 X5\n";
+
+    EXPECT_EQ(Cp_RegisterEx(parser, bindTrigger, 1), 1);
+
+    // Fields bind in any order, letters out of the direct range too.
+    bindTrgCalls = 0;
+    EXPECT_TRUE(Cp_FeedLineEx(parser, lines[0], strlen(lines[0])));
+    EXPECT_EQ(bindTrgX, 1);
+    EXPECT_EQ(bindTrgY, 2);
+    EXPECT_EQ(bindTrgHash, 'q');
+
+    // First of the repeated parameters wins, the others aren't even parsed.
+    EXPECT_TRUE(Cp_FeedLineEx(parser, lines[1], strlen(lines[1])));
+    EXPECT_EQ(bindTrgX, 3);
+    EXPECT_EQ(bindTrgY, 5);
+    EXPECT_TRUE(Cp_FeedLineEx(parser, lines[3], strlen(lines[3])));
+    EXPECT_EQ(bindTrgX, 8);
+
+    // Missing required parameter and malformed first value reject the line.
+    EXPECT_FALSE(Cp_FeedLineEx(parser, lines[2], strlen(lines[2])));
+    EXPECT_FALSE(Cp_FeedLineEx(parser, lines[4], strlen(lines[4])));
+    EXPECT_EQ(bindTrgCalls, 3U);
+
+    EXPECT_EQ(Cp_FeedBytesEx(parser, stream, strlen(stream)), 1U);
+    EXPECT_EQ(bindTrgX, 5);
+    EXPECT_EQ(bindTrgY, 6);
+    EXPECT_EQ(bindTrgHash, 'z');
+
+    // Triggers which repeat a letter aren't registered.
+    static Cp_Trigger_t repeatedTrigger[] = {
+        {"rept", {{'X', CP_PARAM_TYPE_INTEGER}, {'X', CP_PARAM_TYPE_REAL}}, bindTrgCallback, 2},
+        {"repu", {{'#', CP_PARAM_TYPE_LETTER}, {'#', CP_PARAM_TYPE_LETTER}}, bindTrgCallback, 2}};
+    char repeated[][16] = {"rept X1", "repu #a"};
+
+    EXPECT_EQ(Cp_RegisterEx(parser, repeatedTrigger, 2), 0);
+    EXPECT_EQ(parser->registry.numOfTriggers, 1);
+    EXPECT_FALSE(Cp_FeedLineEx(parser, repeated[0], strlen(repeated[0])));
+    EXPECT_FALSE(Cp_FeedLineEx(parser, repeated[1], strlen(repeated[1])));
+    EXPECT_EQ(bindTrgCalls, 4U);
+
+    delete parser;
+}
+
+TEST(ParserTest, RegisterCountTest)
+{
+    static Cp_Trigger_t many[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS + 2] = {};
+    static Cp_Trigger_t mixed[] = {
+        {"one", {{'A', CP_PARAM_TYPE_INTEGER}}, countTrgCallback, 1},
+        {"two", {{'A', CP_PARAM_TYPE_INTEGER}, {'A', CP_PARAM_TYPE_REAL}}, countTrgCallback, 2},
+        {"three", {{'A', CP_PARAM_TYPE_INTEGER}, {'B', CP_PARAM_TYPE_REAL}}, countTrgCallback, 2}};
+    Cp_Parser_t *parser = new Cp_Parser_t();
+
+    // Triggers which repeat a letter aren't counted.
+    EXPECT_EQ(Cp_RegisterEx(parser, mixed, 3), 2);
+
+    // Registry takes as many as it can hold.
+    Cp_ResetEx(parser);
+    EXPECT_EQ(Cp_RegisterEx(parser, many, CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS - 1),
+              CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS - 1);
+    EXPECT_EQ(Cp_RegisterEx(parser, many, 3), 1);
+    EXPECT_EQ(Cp_RegisterEx(parser, many, 1), 0);
+
+    delete parser;
+}
+
+TEST(DictionaryTest, DirectIndexTest)
+{
+    Dictionary_t dictionary;
+    int32_t values[4] = {10, 20, 30, 40};
+    uint8_t type;
+
+    Dictionary_Clear(&dictionary);
+    Dictionary_Add(&dictionary, 'A', CP_PARAM_TYPE_INTEGER, &values[0]);
+    Dictionary_Add(&dictionary, 'z', CP_PARAM_TYPE_REAL, &values[1]);
+    Dictionary_Add(&dictionary, '1', CP_PARAM_TYPE_LETTER, &values[2]);
+    Dictionary_Add(&dictionary, 'A', CP_PARAM_TYPE_INTEGER, &values[3]);
+
+    EXPECT_EQ(Dictionary_Get(&dictionary, 'A', &type), &values[0]);
+    EXPECT_EQ(Dictionary_Get(&dictionary, 'z', &type), &values[1]);
+    EXPECT_EQ(type, CP_PARAM_TYPE_REAL);
+    EXPECT_EQ(Dictionary_Get(&dictionary, '1', &type), &values[2]);
+    EXPECT_FALSE(Dictionary_DoesExist(&dictionary, 'B'));
+
+    // Removing keeps the index consistent, also for the moved last element.
+    Dictionary_Remove(&dictionary, 'A');
+    EXPECT_EQ(Dictionary_Get(&dictionary, 'A', NULL), &values[3]);
+    EXPECT_EQ(Dictionary_Get(&dictionary, 'z', NULL), &values[1]);
+    Dictionary_Remove(&dictionary, 'A');
+    EXPECT_FALSE(Dictionary_DoesExist(&dictionary, 'A'));
+    EXPECT_EQ(dictionary.numberOfElements, 2);
+}
+
+TEST(ParserTest, TypedTriggerTest)
+{
+    static Cp_Trigger_t typedTriggers[] = {
+        {"typed",
+         {{'M', CP_PARAM_TYPE_LETTER, FALSE, offsetof(TypedTrgOutput, mode)},
+          {'C', CP_PARAM_TYPE_INTEGER, FALSE, offsetof(TypedTrgOutput, count)},
+          {'S', CP_PARAM_TYPE_REAL, FALSE, offsetof(TypedTrgOutput, speed)}},
+         NULL,
+         3,
+         sizeof(TypedTrgOutput),
+         typedTrgCallback},
+        // Output struct is too small for the parameter; not registered.
+        {"broken", {{'S', CP_PARAM_TYPE_REAL, FALSE, 2}}, NULL, 1, 4, typedTrgCallback}};
+    Cp_Parser_t *parser = new Cp_Parser_t();
+    char line[] = "typed S1.5 MQ C-7";
+    char partial[] = "typed C12";
+    char broken[] = "broken S1";
+    const char stream[] = "typed S2.5\n";
+
+    Cp_RegisterEx(parser, typedTriggers, 2);
+    typedTrgCalls = 0;
+
+    EXPECT_TRUE(Cp_FeedLineEx(parser, line, strlen(line)));
+    EXPECT_EQ(typedTrgOutput.mode, 'Q');
+    EXPECT_EQ(typedTrgOutput.count, -7);
+    EXPECT_EQ(typedTrgOutput.speed, 1.5f);
+    EXPECT_EQ(typedTrgPresent, 0x7U);
+
+    // Fields of the parameters which aren't given are zero.
+    EXPECT_TRUE(Cp_FeedLineEx(parser, partial, strlen(partial)));
+    EXPECT_EQ(typedTrgOutput.mode, 0);
+    EXPECT_EQ(typedTrgOutput.count, 12);
+    EXPECT_EQ(typedTrgOutput.speed, 0.0f);
+    EXPECT_EQ(typedTrgPresent, 0x2U);
+
+    EXPECT_EQ(Cp_FeedBytesEx(parser, stream, strlen(stream)), 1U);
+    EXPECT_EQ(typedTrgOutput.speed, 2.5f);
+    EXPECT_EQ(typedTrgPresent, 0x4U);
+
+    EXPECT_FALSE(Cp_FeedLineEx(parser, broken, strlen(broken)));
+    EXPECT_EQ(typedTrgCalls, 3U);
+
+    delete parser;
+}
+
+TEST(ParserTest, QueuedModeTest)
+{
+    static Cp_Trigger_t countTrigger[] = {
+        {"count", {{'N', CP_PARAM_TYPE_INTEGER}}, countTrgCallback, 1}};
+    static Cp_Parser_t parser;
+    static Cp_Command_t storage[4];
+    static Cp_Queue_t queue;
+    char line[] = "count N2";
+
+    EXPECT_FALSE(Cp_QueueInit(&queue, storage, 3));
+    ASSERT_TRUE(Cp_QueueInit(&queue, storage, 4));
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, countTrigger, 1);
+    Cp_SetQueueEx(&parser, &queue);
+    countTrgCalls = 0;
+    countTrgSum = 0;
+
+    // Lines are only queued; the ones which don't fit are dropped.
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, "count N3\n", 9), 1U);
+    Cp_FeedResult_t result = Cp_FeedBufferEx(&parser, "count N4\ncount N5\ncount N6", 26);
+    EXPECT_EQ(result.accepted, 2U);
+    EXPECT_EQ(result.rejected, 1U);
+    EXPECT_EQ(Cp_QueueGetDropped(&queue), 1U);
+    EXPECT_EQ(countTrgCalls, 0U);
+
+    EXPECT_EQ(Cp_QueueDispatch(&queue, 3), 3U);
+    EXPECT_EQ(countTrgSum, 9);
+    EXPECT_EQ(Cp_QueueDispatch(&queue, 0), 1U);
+    EXPECT_EQ(countTrgSum, 14);
+    EXPECT_EQ(Cp_QueueDispatch(&queue, 0), 0U);
+
+    // Without the queue lines are dispatched right away.
+    Cp_SetQueueEx(&parser, NULL);
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    EXPECT_EQ(countTrgCalls, 5U);
+}
+
+TEST(ParserTest, QueueStressTest)
+{
+    static Cp_Trigger_t sequenceTrigger[] = {
+        {"seq", {{'N', CP_PARAM_TYPE_INTEGER}}, sequenceTrgCallback, 1}};
+    static Cp_Parser_t parser;
+    static Cp_Command_t storage[64];
+    static Cp_Queue_t queue;
+    const int32_t numOfLines = 200000;
+    std::atomic<bool> done(false);
+
+    ASSERT_TRUE(Cp_QueueInit(&queue, storage, 64));
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, sequenceTrigger, 1);
+    Cp_SetQueueEx(&parser, &queue);
+    sequenceTrgValues.clear();
+
+    std::thread consumer([&]() {
+        while (!done.load() || Cp_QueueDispatch(&queue, 0) != 0)
+        {
+            if (Cp_QueueDispatch(&queue, 16) == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread producer([&]() {
+        for (int32_t i = 0; i < numOfLines; i++)
+        {
+            std::string line = "seq N" + std::to_string(i);
+
+            // Full queue drops the line; feed it again until it fits.
+            if (i % 2)
+            {
+                while (!Cp_FeedLineEx(&parser, &line[0], (uint16_t)line.size()))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            else
+            {
+                line += "\n";
+                while (Cp_FeedBytesEx(&parser, line.data(), line.size()) == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        done.store(true);
+    });
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(sequenceTrgValues.size(), (size_t)numOfLines);
+    for (int32_t i = 0; i < numOfLines; i++)
+    {
+        ASSERT_EQ(sequenceTrgValues[i], i);
+    }
+}
+
+TEST(ParserTest, SharedRegistryTest)
+{
+    static Cp_Trigger_t headA[] = {
+        {"count", {{'N', CP_PARAM_TYPE_INTEGER}}, countTrgCallback, 1}};
+    static Cp_Trigger_t headB[] = {
+        {"cnt", {{'N', CP_PARAM_TYPE_INTEGER}}, countTrgCallback, 1}};
+    static Cp_Registry_t registryA;
+    static Cp_Registry_t registryB;
+    static Cp_SharedRegistry_t shared;
+    static Cp_Parser_t parser;
+    static Cp_Parser_t pinned;
+    Cp_Command_t command;
+    char lineA[] = "count N2";
+    char lineB[] = "cnt N3";
+
+    Cp_RegistryAdd(&registryA, headA, 1);
+    Cp_RegistryAdd(&registryB, headB, 1);
+    Cp_SharedRegistryInit(&shared, &registryA);
+    ASSERT_TRUE(Cp_AttachRegistryEx(&parser, &shared));
+    ASSERT_TRUE(Cp_AttachRegistryEx(&pinned, &shared));
+    countTrgCalls = 0;
+    countTrgSum = 0;
+
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, lineA, strlen(lineA)));
+    EXPECT_FALSE(Cp_FeedLineEx(&parser, lineB, strlen(lineB)));
+
+    // A line which has started with the old registry is completed with it.
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, "count ", 6), 0U);
+    Cp_ReadLockEx(&pinned);
+    EXPECT_TRUE(Cp_SharedRegistryPublish(&shared, &registryB));
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, "N4\ncnt N5\n", 11), 2U);
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, lineB, strlen(lineB)));
+    EXPECT_FALSE(Cp_FeedLineEx(&parser, lineA, strlen(lineA)));
+    EXPECT_EQ(countTrgSum, 14);
+
+    // Old registry can't be reclaimed while a reader has it pinned.
+    EXPECT_TRUE(Cp_DecodeLineEx(&pinned, lineA, strlen(lineA), &command));
+    EXPECT_EQ(Cp_SharedRegistryReclaim(&shared), nullptr);
+    Cp_ReadUnlockEx(&pinned);
+    EXPECT_EQ(Cp_SharedRegistryReclaim(&shared), &registryA);
+    EXPECT_EQ(Cp_SharedRegistryReclaim(&shared), nullptr);
+
+    for (uint8_t i = 0; i < CPARSER_CONFIG_MAX_NUM_OF_RETIRED; i++)
+    {
+        EXPECT_TRUE(Cp_SharedRegistryPublish(&shared, (i % 2) ? &registryB : &registryA));
+    }
+    EXPECT_FALSE(Cp_SharedRegistryPublish(&shared, &registryB));
+
+    // Detached parser decodes with its own, empty registry.
+    Cp_DetachRegistryEx(&parser);
+    Cp_DetachRegistryEx(&pinned);
+    EXPECT_FALSE(Cp_FeedLineEx(&parser, lineB, strlen(lineB)));
+}
+
+TEST(ParserTest, SharedRegistryStressTest)
+{
+    static Cp_Trigger_t heads[][1] = {
+        {{"count", {{'N', CP_PARAM_TYPE_INTEGER}}, countTrgCallback, 1}},
+        {{"count", {{'N', CP_PARAM_TYPE_INTEGER}, {'M'}}, countTrgCallback, 2}}};
+    static Cp_Registry_t registries[3];
+    static Cp_SharedRegistry_t shared;
+    const uint32_t numOfThreads = 3;
+    const uint32_t numOfLines = 20000;
+    std::vector<uint32_t> calls(numOfThreads);
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> running(numOfThreads);
+    uint32_t swaps = 0;
+
+    for (Cp_Registry_t &registry : registries)
+    {
+        Cp_RegistryInit(&registry);
+        Cp_RegistryAdd(&registry, heads[0], 1);
+    }
+    Cp_SharedRegistryInit(&shared, &registries[0]);
+
+    for (uint32_t t = 0; t < numOfThreads; t++)
+    {
+        threads.emplace_back([&, t]() {
+            Cp_Parser_t *parser = new Cp_Parser_t();
+            std::string line = "count N1";
+
+            EXPECT_TRUE(Cp_AttachRegistryEx(parser, &shared));
+            for (uint32_t i = 0; i < numOfLines; i++)
+            {
+                Cp_FeedLineEx(parser, &line[0], (uint16_t)line.size());
+            }
+
+            calls[t] = countTrgCalls;
+            Cp_DetachRegistryEx(parser);
+            delete parser;
+            running--;
+        });
+    }
+
+    // Reclaimed registries are rebuilt while the readers are parsing.
+    std::vector<Cp_Registry_t *> free = {&registries[1], &registries[2]};
+    while (running.load() != 0)
+    {
+        const Cp_Registry_t *reclaimed;
+
+        while ((reclaimed = Cp_SharedRegistryReclaim(&shared)) != nullptr)
+        {
+            free.push_back(const_cast<Cp_Registry_t *>(reclaimed));
+        }
+
+        if (!free.empty())
+        {
+            Cp_Registry_t *registry = free.back();
+
+            free.pop_back();
+            Cp_RegistryInit(registry);
+            Cp_RegistryAdd(registry, heads[swaps % 2], 1);
+            EXPECT_TRUE(Cp_SharedRegistryPublish(&shared, registry));
+            swaps++;
+        }
+
+        std::this_thread::yield();
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_GT(swaps, 0U);
+    for (uint32_t t = 0; t < numOfThreads; t++)
+    {
+        EXPECT_EQ(calls[t], numOfLines);
+    }
+}
+
+TEST(ParserTest, BinaryFrameTest)
+{
+    static Cp_Parser_t parser;
+    uint8_t frames[4 * CP_BINARY_MAX_FRAME_SIZE];
+    size_t length = 0;
+    const char *lines[] = {"pump MD V1.25", "versi V-7", "move S2.5 D-1"};
+
+    Cp_RegisterEx(&parser, TriggerTable, 4);
+    for (const char *line : lines)
+    {
+        size_t size = Cp_TranscodeLineEx(&parser, line, strlen(line), &frames[length],
+                                         sizeof(frames) - length);
+        ASSERT_GT(size, 0U) << line;
+        length += size;
+    }
+
+    // Trigger id, presence and the little endian values.
+    const uint8_t pump[] = {8, 3, 0, 0x03, 'D', 0x00, 0x00, 0xA0, 0x3F};
+    ASSERT_EQ(CP_BINARY_PRESENCE_SIZE, 1);
+    EXPECT_EQ(memcmp(frames, pump, sizeof(pump)), 0);
+    EXPECT_EQ(Cp_TranscodeLineEx(&parser, "pump MD", 7, frames, 4), 0U);
+    EXPECT_EQ(Cp_TranscodeLineEx(&parser, "jump", 4, frames, sizeof(frames)), 0U);
+
+    pumpTrgTriggered = FALSE;
+    versionTrgTriggered = FALSE;
+    moveTrgTriggered = FALSE;
+    frames[length++] = 0;
+    Cp_FeedResult_t result = Cp_FeedFramesEx(&parser, frames, length);
+    EXPECT_EQ(result.accepted, 3U);
+    EXPECT_EQ(result.rejected, 0U);
+    EXPECT_TRUE(pumpTrgTriggered);
+    EXPECT_EQ(pumpTrgMode, 'D');
+    EXPECT_FLOAT_EQ(pumpTrgVolume, 1.25f);
+    EXPECT_EQ(versionTrgVersion, -7);
+    EXPECT_FLOAT_EQ(moveTrgDisplacement, -1.0f);
+    EXPECT_FLOAT_EQ(moveTrgSpeed, 2.5f);
+
+    // Unknown trigger, unknown parameter, wrong length and a cut frame.
+    const uint8_t bad[] = {3, 9, 0, 0x00,
+                           3, 0, 0, 0x02,
+                           4, 0, 0, 0x01, 0x00,
+                           7, 0, 0, 0x01, 0x00, 0x00};
+    result = Cp_FeedFramesEx(&parser, bad, sizeof(bad));
+    EXPECT_EQ(result.accepted, 0U);
+    EXPECT_EQ(result.rejected, 4U);
+}
+
+TEST(NumberTest, FormatTest)
+{
+    char text[NUMBER_MAX_FLOAT_LENGTH + 1];
+    const int32_t integers[] = {0, 7, -42, 99, 100, 123456789, INT32_MAX, INT32_MIN};
+
+    for (int32_t integer : integers)
+    {
+        text[Number_FormatInteger(integer, text)] = '\0';
+        EXPECT_EQ(std::string(text), std::to_string(integer));
+    }
+
+    const std::pair<float, const char *> reals[] = {
+        {0.0f, "0"}, {-0.0f, "-0"}, {1.0f, "1"}, {-2.5f, "-2.5"}, {0.1f, "0.1"},
+        {123.45f, "123.45"}, {0.00125f, "0.00125"}, {16777216.0f, "16777216"},
+        {1e10f, "1E10"}, {1.2345e-7f, "1.2345E-7"},
+        {std::numeric_limits<float>::max(), "3.4028235E38"},
+        {std::numeric_limits<float>::denorm_min(), "1E-45"}};
+
+    for (const auto &real : reals)
+    {
+        text[Number_FormatFloat(real.first, text)] = '\0';
+        EXPECT_STREQ(text, real.second);
+    }
+    EXPECT_EQ(Number_FormatFloat(INFINITY, text), 0);
+    EXPECT_EQ(Number_FormatFloat(NAN, text), 0);
+
+    srand(1234);
+    for (int n = 0; n < 200000; n++)
+    {
+        // Random finite floats parse back exactly, and no shorter precision
+        //does.
+        uint32_t bits = (((uint32_t)rand() << 16) ^ (uint32_t)rand()) % 0xFF000000U;
+        float source;
+        float value;
+        memcpy(&source, &bits, sizeof(source));
+        if ((bits & 0x7F800000U) == 0x7F800000U)
+        {
+            continue;
+        }
+
+        uint8_t length = Number_FormatFloat(source, text);
+        ASSERT_EQ(Number_ParseFloat(text, length, &value), TRUE);
+        ASSERT_EQ(memcmp(&value, &source, sizeof(float)), 0) << std::string(text, length);
+
+        int digits = 0;
+        int trailing = 0;
+        for (uint8_t i = 0; i < length && text[i] != 'E'; i++)
+        {
+            if (text[i] >= '1' && text[i] <= '9')
+            {
+                digits += trailing + 1;
+                trailing = 0;
+            }
+            else if (text[i] == '0' && digits > 0)
+            {
+                trailing++;
+            }
+        }
+
+        if (digits > 1)
+        {
+            char shorter[32];
+            int shorter_length = snprintf(shorter, sizeof(shorter), "%.*g", digits - 1, source);
+            ASSERT_GT(shorter_length, 0);
+            ASSERT_LT((size_t)shorter_length, sizeof(shorter));
+            value = strtof(shorter, NULL);
+            ASSERT_NE(memcmp(&value, &source, sizeof(float)), 0) << std::string(text, length);
+        }
+    }
+}
+
+TEST(ParserTest, FormatTest)
+{
+    static Cp_Trigger_t typedTrigger[] = {
+        {"typed",
+         {{'M', CP_PARAM_TYPE_LETTER, FALSE, offsetof(TypedTrgOutput, mode)},
+          {'C', CP_PARAM_TYPE_INTEGER, FALSE, offsetof(TypedTrgOutput, count)},
+          {'S', CP_PARAM_TYPE_REAL, FALSE, offsetof(TypedTrgOutput, speed)}},
+         NULL,
+         3,
+         sizeof(TypedTrgOutput),
+         typedTrgCallback}};
+    static Cp_Parser_t parser;
+    Dictionary_t dictionary = {};
+    char mode = 'K';
+    float volume = 0.3f;
+    char line[64];
+
+    Dictionary_Add(&dictionary, 'M', CP_PARAM_TYPE_LETTER, &mode);
+    Dictionary_Add(&dictionary, 'V', CP_PARAM_TYPE_REAL, &volume);
+    EXPECT_EQ(Cp_Format("pump", &dictionary, line, sizeof(line)), 12U);
+    EXPECT_STREQ(line, "pump MK V0.3");
+
+    // Formatted line parses back to the same values.
+    Cp_RegisterEx(&parser, TriggerTable, 4);
+    pumpTrgTriggered = FALSE;
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    EXPECT_TRUE(pumpTrgTriggered);
+    EXPECT_EQ(pumpTrgMode, 'K');
+    EXPECT_EQ(pumpTrgVolume, volume);
+
+    Cp_Command_t command;
+    const char move[] = "move S-1.5E-9 D+00012.50";
+    ASSERT_TRUE(Cp_DecodeLineEx(&parser, move, strlen(move), &command));
+    EXPECT_EQ(Cp_FormatCommand(&command, line, sizeof(line)), 19U);
+    EXPECT_STREQ(line, "move S-1.5E-9 D12.5");
+
+    // Line and the null termination should fit exactly.
+    EXPECT_EQ(Cp_Format("pump", &dictionary, line, 12), 0U);
+    EXPECT_EQ(Cp_Format("pump", &dictionary, line, 13), 12U);
+    EXPECT_EQ(Cp_FormatCommand(&command, line, 19), 0U);
+    volume = NAN;
+    EXPECT_EQ(Cp_Format("pump", &dictionary, line, sizeof(line)), 0U);
+
+    TypedTrgOutput output = {'Z', -40000, 2.75f};
+    Cp_RegisterEx(&parser, typedTrigger, 1);
+    EXPECT_EQ(Cp_FormatTyped(typedTrigger, &output, 0x6, line, sizeof(line)), 19U);
+    EXPECT_STREQ(line, "typed C-40000 S2.75");
+    typedTrgOutput = TypedTrgOutput();
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    EXPECT_EQ(typedTrgPresent, 0x6U);
+    EXPECT_EQ(typedTrgOutput.count, -40000);
+    EXPECT_EQ(typedTrgOutput.speed, 2.75f);
+}
+
+TEST(ParserTest, LineCacheTest)
+{
+    static Cp_Parser_t parser;
+    static Cp_LineCache_t cache;
+    char line[] = "versi V10";
+    char other[] = "versi V-3";
+    char unknown[] = "jump";
+    const char buffer[] = "versi V10\nversi V10\njump\nversi V-3";
+
+    Cp_RegisterEx(&parser, TriggerTable, 4);
+    Cp_SetLineCacheEx(&parser, &cache);
+
+    // First one is parsed, the repeats are dispatched from the cache.
+    for (int i = 0; i < 3; i++)
+    {
+        versionTrgVersion = 0;
+        EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+        EXPECT_EQ(versionTrgVersion, 10);
+    }
+    EXPECT_EQ(Cp_LineCacheGetHits(&cache), 2U);
+    EXPECT_EQ(Cp_LineCacheGetMisses(&cache), 1U);
+
+    // Lines differing in a byte don't hit; rejected lines aren't cached.
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, other, strlen(other)));
+    EXPECT_EQ(versionTrgVersion, -3);
+    EXPECT_FALSE(Cp_FeedLineEx(&parser, unknown, strlen(unknown)));
+    EXPECT_FALSE(Cp_FeedLineEx(&parser, unknown, strlen(unknown)));
+    EXPECT_EQ(Cp_LineCacheGetHits(&cache), 2U);
+    EXPECT_EQ(Cp_LineCacheGetMisses(&cache), 4U);
+
+    Cp_FeedResult_t result = Cp_FeedBufferEx(&parser, buffer, strlen(buffer));
+    EXPECT_EQ(result.accepted, 3U);
+    EXPECT_EQ(result.rejected, 1U);
+    EXPECT_EQ(versionTrgVersion, -3);
+    EXPECT_EQ(Cp_LineCacheGetHits(&cache), 5U);
+
+    // Changing the registry invalidates the cached lines.
+    static Cp_Trigger_t realTrigger[] = {
+        {"versi",
+         {{'V', CP_PARAM_TYPE_REAL}},
+         [](Dictionary_t *params) {
+             uint8_t type;
+             delayTrgTime = *((float *)Dictionary_Get(params, 'V', &type));
+         },
+         1}};
+    Cp_ResetEx(&parser);
+    EXPECT_FALSE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    Cp_RegisterEx(&parser, realTrigger, 1);
+    versionTrgVersion = 0;
+    delayTrgTime = 0.0f;
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    EXPECT_EQ(delayTrgTime, 10.0f);
+    delayTrgTime = 0.0f;
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    EXPECT_EQ(delayTrgTime, 10.0f);
+    EXPECT_EQ(versionTrgVersion, 0);
+    EXPECT_EQ(Cp_LineCacheGetHits(&cache), 6U);
+
+    Cp_SetLineCacheEx(&parser, NULL);
+
+    // Registry which is rebuilt from zeroed memory at the address of an old
+    //one doesn't match the lines cached from the old one.
+    Cp_Registry_t *registry = (Cp_Registry_t *)calloc(1, sizeof(Cp_Registry_t));
+    Cp_Command_t command;
+
+    Cp_LineCacheInit(&cache);
+    Cp_RegistryAdd(registry, TriggerTable, 4);
+    ASSERT_TRUE(Cp_DecodeLineEx(&parser, line, strlen(line), &command));
+    Cp_LineCacheStore(&cache, registry, line, strlen(line), &command);
+    EXPECT_TRUE(Cp_LineCacheFind(&cache, registry, line, strlen(line), &command));
+
+    memset(registry, 0, sizeof(Cp_Registry_t));
+    Cp_RegistryAdd(registry, realTrigger, 1);
+    EXPECT_FALSE(Cp_LineCacheFind(&cache, registry, line, strlen(line), &command));
+    free(registry);
+}
+
+TEST(NumberTest, IntegerRangeTest)
+{
+    int32_t value;
+
+    // Range boundaries, with and without the leading zeros.
+    const std::pair<const char *, int64_t> valid[] = {
+        {"2147483647", INT32_MAX}, {"-2147483648", INT32_MIN}, {"+2147483647", INT32_MAX},
+        {"0000000002147483647", INT32_MAX}, {"-00000000000000000002147483648", INT32_MIN},
+        {"12345678", 12345678}, {"-99999999", -99999999}, {"1234567890", 1234567890},
+        {"00000000", 0}, {"-0", 0}, {"0000000000000000000000000", 0}};
+    for (const auto &entry : valid)
+    {
+        ASSERT_TRUE(Number_ParseInteger(entry.first, strlen(entry.first), &value)) << entry.first;
+        EXPECT_EQ(value, entry.second) << entry.first;
+    }
+
+    const char *invalid[] = {"2147483648", "-2147483649", "4294967295", "4294967296",
+                             "4294967306", "99999999999", "18446744073709551616",
+                             "-99999999999999999999999", "1234567a", "1234567812345678:",
+                             "/2345678", "12345678 "};
+    for (const char *text : invalid)
+    {
+        EXPECT_FALSE(Number_ParseInteger(text, strlen(text), &value)) << text;
+    }
+
+    // Every non-digit byte at every position of the eight digit blocks.
+    for (int position = 0; position < 16; position++)
+    {
+        for (int c = 0; c < 256; c++)
+        {
+            char text[] = "1234567890123456";
+            if (c >= '0' && c <= '9')
+            {
+                continue;
+            }
+            text[position] = (char)c;
+            ASSERT_FALSE(Number_ParseInteger(text, 16, &value)) << position << " " << c;
+        }
+    }
+
+    // Random digit runs of every length against a reference conversion.
+    srand(2468);
+    for (int n = 0; n < 100000; n++)
+    {
+        char text[32];
+        int length = 0;
+        int digits = 1 + rand() % 24;
+        Bool_t negative = (rand() % 2) ? TRUE : FALSE;
+        uint64_t magnitude = 0;
+
+        if (negative)
+        {
+            text[length++] = '-';
+        }
+        for (int i = 0; i < digits; i++)
+        {
+            // Mostly short significant parts, so the values are near the range.
+            char digit = (i < digits - 11 && rand() % 4) ? '0' : (char)('0' + rand() % 10);
+            text[length++] = digit;
+            magnitude = (magnitude > UINT32_MAX) ? magnitude : magnitude * 10 + (digit - '0');
+        }
+
+        Bool_t expected = (magnitude <= (negative ? 0x80000000ULL : (uint64_t)INT32_MAX)) ? TRUE : FALSE;
+        ASSERT_EQ(Number_ParseInteger(text, length, &value), expected) << std::string(text, length);
+        if (expected)
+        {
+            ASSERT_EQ((int64_t)value, negative ? -(int64_t)magnitude : (int64_t)magnitude);
+        }
+    }
+
+    // Exponents saturate instead of wrapping.
+    float real;
+    ASSERT_TRUE(Number_ParseFloat("1E4294967296", 12, &real));
+    EXPECT_TRUE(std::isinf(real));
+    ASSERT_TRUE(Number_ParseFloat("1E-4294967297", 13, &real));
+    EXPECT_EQ(real, 0.0f);
+    ASSERT_TRUE(Number_ParseFloat("1E00000000000000000001", 22, &real));
+    EXPECT_EQ(real, 10.0f);
+    EXPECT_FALSE(Number_ParseFloat("1E0000000a", 10, &real));
+}
+
+TEST(ParserTest, IntegerRangeTest)
+{
+    static Cp_Parser_t parser;
+    char overflow[] = "versi V4294967297";
+    char minimum[] = "versi V-2147483648";
+    const char stream[] = "versi V2147483648\nversi V-2147483648\nversi V000000000000000000000123\n"
+                          "versi V100000000000000000000\n";
+
+    Cp_RegisterEx(&parser, TriggerTable, 4);
+    EXPECT_FALSE(Cp_FeedLineEx(&parser, overflow, strlen(overflow)));
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, minimum, strlen(minimum)));
+    EXPECT_EQ(versionTrgVersion, INT32_MIN);
+
+    // Byte stream applies the same range.
+    versionTrgVersion = 0;
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, stream, strlen(stream)), 2U);
+    EXPECT_EQ(versionTrgVersion, 123);
+}
+
+#if defined(__SIZEOF_INT128__)
+/**
+ * @brief Reference conversion of mantissa * 10^exponent to Q16.16 with 128 
+ * bit integers; nearest, ties to even, saturated.
+ */
+static int32_t referenceFixed(uint64_t mantissa, int exponent, bool negative)
+{
+    unsigned __int128 scaled = (unsigned __int128)mantissa << 16;
+    unsigned __int128 limit = negative ? 0x80000000U : 0x7FFFFFFFU;
+    unsigned __int128 magnitude;
+
+    if (exponent >= 0)
+    {
+        for (int i = 0; i < exponent; i++)
+        {
+            scaled *= 10;
+        }
+        magnitude = scaled;
+    }
+    else
+    {
+        unsigned __int128 divisor = 1;
+        for (int i = 0; i < -exponent; i++)
+        {
+            divisor *= 10;
+        }
+        magnitude = scaled / divisor;
+        unsigned __int128 remainder = (scaled % divisor) * 2;
+        if (remainder > divisor || (remainder == divisor && (magnitude & 1)))
+        {
+            magnitude++;
+        }
+    }
+
+    magnitude = (magnitude > limit) ? limit : magnitude;
+    return negative ? (int32_t)(0U - (uint32_t)magnitude) : (int32_t)(uint32_t)magnitude;
+}
+#endif
+
+TEST(NumberTest, FixedTest)
+{
+    int32_t value;
+    ASSERT_EQ(CPARSER_CONFIG_FIXED_FRACTION_BITS, 16);
+
+    const std::pair<const char *, int32_t> cases[] = {
+        {"1", 0x10000}, {"-1.5", -0x18000}, {"0.25E1", 0x28000}, {"", 0},
+        {"1.52587890625E-5", 1}, {"0.00000762939453125", 0}, {"0.00002288818359375", 2},
+        {"-0.00000762939453125", 0}, {"0.0000076293945312500001", 1},
+        {"32767.99998474121", 0x7FFFFFFF}, {"32768", INT32_MAX}, {"1E30", INT32_MAX},
+        {"-32768", INT32_MIN}, {"-1E30", INT32_MIN}, {"-32768.00001", INT32_MIN},
+        {"1E-30", 0}, {"1E-9999", 0}, {"3.14159265358979323846", 205887},
+        {"12345.00002288818359375", 809041922}, {"12345.00000762939453125", 809041920},
+        {"-12345.00002288818359375", -809041922},
+        {"12345.000007629394531250000000001", 809041921},
+        {"12345.000007629394531249999999999", 809041920}};
+    for (const auto &entry : cases)
+    {
+        ASSERT_TRUE(Number_ParseFixed(entry.first, strlen(entry.first), &value)) << entry.first;
+        EXPECT_EQ(value, entry.second) << entry.first;
+    }
+    EXPECT_FALSE(Number_ParseFixed("1.2.3", 5, &value));
+    EXPECT_FALSE(Number_ParseFixed("1E", 2, &value));
+
+#if defined(__SIZEOF_INT128__)
+    // Random mantissas and exponents against the 128 bit reference.
+    srand(1357);
+    for (int n = 0; n < 200000; n++)
+    {
+        char text[48];
+        uint64_t limit = 1;
+        for (int digits = 1 + rand() % 18; digits > 0; digits--)
+        {
+            limit *= 10;
+        }
+        uint64_t mantissa = (((uint64_t)rand() << 31) ^ (uint64_t)rand()) % limit;
+        int exponent = rand() % 26 - 22;
+        bool negative = rand() % 2;
+
+        snprintf(text, sizeof(text), "%s%lluE%d", negative ? "-" : "", (unsigned long long)mantissa,
+                 exponent);
+        ASSERT_TRUE(Number_ParseFixed(text, strlen(text), &value)) << text;
+        ASSERT_EQ(value, referenceFixed(mantissa, exponent, negative)) << text;
+    }
+
+    // Exact ties of more than 19 significant digits, ones slightly above and
+    //ones slightly below them.
+    for (int n = 0; n < 20000; n++)
+    {
+        uint32_t magnitude = (((uint32_t)rand() << 16) ^ (uint32_t)rand()) & 0x7FFFFFFE;
+        unsigned __int128 tie = (unsigned __int128)(2 * (uint64_t)magnitude + 1);
+        char digits[48];
+        int count = 0;
+
+        // Tie is (2 * magnitude + 1) * 5^17 / 10^17.
+        for (int i = 0; i < 17; i++)
+        {
+            tie *= 5;
+        }
+        for (; tie != 0 || count < 18; tie /= 10)
+        {
+            digits[count++] = (char)('0' + (int)(tie % 10));
+        }
+
+        std::string text;
+        for (int i = count - 1; i >= 0; i--)
+        {
+            text += digits[i];
+            text += (i == 17) ? "." : "";
+        }
+
+        ASSERT_TRUE(Number_ParseFixed(text.data(), text.size(), &value)) << text;
+        EXPECT_EQ(value, (int32_t)(magnitude + (magnitude & 1))) << text;
+
+        std::string above = text + "000000000000001";
+        ASSERT_TRUE(Number_ParseFixed(above.data(), above.size(), &value)) << above;
+        EXPECT_EQ(value, (int32_t)(magnitude + 1)) << above;
+
+        std::string below = text.substr(0, text.size() - 1) + "4999999999999999";
+        ASSERT_TRUE(Number_ParseFixed(below.data(), below.size(), &value)) << below;
+        EXPECT_EQ(value, (int32_t)magnitude) << below;
+    }
+#endif
+
+    // Formatted values are the shortest ones which parse back exactly.
+    char text[NUMBER_MAX_FIXED_LENGTH + 1];
+    for (int64_t raw = INT32_MIN; raw <= INT32_MAX; raw += 9973)
+    {
+        for (int32_t offset : {0, 1, -1})
+        {
+            int64_t shifted = std::max<int64_t>(INT32_MIN, std::min<int64_t>(INT32_MAX, raw + offset));
+            int32_t fixed = (int32_t)shifted;
+            uint8_t length = Number_FormatFixed(fixed, text);
+
+            ASSERT_TRUE(Number_ParseFixed(text, length, &value));
+            ASSERT_EQ(value, fixed) << std::string(text, length);
+
+            const char *point = (const char *)memchr(text, '.', length);
+            if (point && &text[length - 1] > point + 1)
+            {
+                ASSERT_FALSE(Number_ParseFixed(text, length - 1, &value) && value == fixed)
+                    << std::string(text, length);
+            }
+        }
+    }
+
+    const std::pair<int32_t, const char *> formats[] = {
+        {0, "0"}, {0x10000, "1"}, {-0x18000, "-1.5"}, {1, "0.00001"}, {-1, "-0.00001"},
+        {INT32_MAX, "32767.99998"}, {INT32_MIN, "-32768"}, {0x1999A, "1.6"}};
+    for (const auto &entry : formats)
+    {
+        text[Number_FormatFixed(entry.first, text)] = '\0';
+        EXPECT_STREQ(text, entry.second);
+    }
+}
+
+TEST(ParserTest, FixedParamTest)
+{
+    static Cp_Trigger_t fixedTriggers[] = {
+        {"fix",
+         {{'A', CP_PARAM_TYPE_FIXED, FALSE, offsetof(FixedTrgOutput, a)},
+          {'B', CP_PARAM_TYPE_FIXED, FALSE, offsetof(FixedTrgOutput, b)}},
+         NULL,
+         2,
+         sizeof(FixedTrgOutput),
+         fixedTrgCallback}};
+    static Cp_Parser_t parser;
+    char line[] = "fix A1.25 B-2E-1";
+    const char stream[] = "fix B1E5 A0.00002288818359375\nfix A1E\n";
+
+    Cp_RegisterEx(&parser, fixedTriggers, 1);
+    EXPECT_TRUE(Cp_FeedLineEx(&parser, line, strlen(line)));
+    EXPECT_EQ(fixedTrgOutput.a, 0x14000);
+    EXPECT_EQ(fixedTrgOutput.b, -13107);
+
+    // Byte stream decodes the same grammar; saturated and rounded.
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, stream, strlen(stream)), 1U);
+    EXPECT_EQ(fixedTrgOutput.a, 2);
+    EXPECT_EQ(fixedTrgOutput.b, INT32_MAX);
+
+    char output[32];
+    EXPECT_GT(Cp_FormatTyped(fixedTriggers, &fixedTrgOutput, 0x3, output, sizeof(output)), 0U);
+    EXPECT_STREQ(output, "fix A0.00003 B32767.99998");
+
+    // Digits beyond the mantissa capacity round the same way in both.
+    for (const char *value : {"12345.00002288818359375", "12345.00000762939453125",
+                              "12345.000007629394531250000000001",
+                              "-12345.000007629394531249999999999",
+                              "0.0000228881835937500000000000000000000000000000001"})
+    {
+        std::string text = std::string("fix A") + value;
+        int32_t expected;
+
+        ASSERT_TRUE(Number_ParseFixed(value, strlen(value), &expected));
+        EXPECT_TRUE(Cp_FeedLineEx(&parser, text.data(), text.size()));
+        EXPECT_EQ(fixedTrgOutput.a, expected) << value;
+        text += "\n";
+        fixedTrgOutput.a = 0;
+        EXPECT_EQ(Cp_FeedBytesEx(&parser, text.data(), text.size()), 1U);
+        EXPECT_EQ(fixedTrgOutput.a, expected) << value;
+    }
+}
+
+TEST(ParserTest, StringViewTest)
+{
+    static cparser::Parser parser;
+    const std::string text = "versi V42 trailing bytes";
+    std::vector<std::string_view> lines = {"versi V1", "", "jump", "versi V2"};
+
+    parser.add(TriggerTable, 4);
+
+    // Views of a part of a string are parsed without being terminated.
+    EXPECT_TRUE(parser.feedLine(std::string_view(text).substr(0, 9)));
+    EXPECT_EQ(versionTrgVersion, 42);
+
+    Cp_FeedResult_t result = parser.feedLines(lines);
+    EXPECT_EQ(result.accepted, 2U);
+    EXPECT_EQ(result.rejected, 1U);
+    EXPECT_EQ(versionTrgVersion, 2);
+
+    std::array<const char *, 2> array = {"versi V3", "versi Vx"};
+    result = parser.feedLines(array);
+    EXPECT_EQ(result.accepted, 1U);
+    EXPECT_EQ(versionTrgVersion, 3);
+
+    // Lines without fields are skipped like in a buffer.
+    std::array<std::string_view, 4> blank = {" ", "\r", "versi V4", "  \r"};
+    result = parser.feedLines(blank);
+    EXPECT_EQ(result.accepted, 1U);
+    EXPECT_EQ(result.rejected, 0U);
+    result = parser.feedBuffer(" \n\r\nversi V4\n  \r\n");
+    EXPECT_EQ(result.accepted, 1U);
+    EXPECT_EQ(result.rejected, 0U);
+    EXPECT_EQ(versionTrgVersion, 4);
+
+    Cp_Command_t command;
+    EXPECT_TRUE(parser.decodeLine("versi V7", command));
+    EXPECT_FALSE(parser.decodeLine(std::string(70000, 'v'), command));
+
+    // Input on a read only page is parsed in place; a write would fault. It 
+    //is followed by a guard page, so a read past its end would fault too.
+    long pageSize = sysconf(_SC_PAGESIZE);
+    char *page = (char *)mmap(NULL, 2 * pageSize, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(page, MAP_FAILED);
+    const char content[] = "versi V5\nversi V6";
+    char *end = page + pageSize - (sizeof(content) - 1);
+    memcpy(end, content, sizeof(content) - 1);
+    ASSERT_EQ(mprotect(page, pageSize, PROT_READ), 0);
+    ASSERT_EQ(mprotect(page + pageSize, pageSize, PROT_NONE), 0);
+
+    std::string_view mapped(end, sizeof(content) - 1);
+    result = parser.feedBuffer(mapped);
+    EXPECT_EQ(result.accepted, 2U);
+    EXPECT_EQ(versionTrgVersion, 6);
+    EXPECT_TRUE(cparser::feedLine(parser.get(), mapped.substr(0, 8)));
+    EXPECT_EQ(versionTrgVersion, 5);
+    EXPECT_EQ(parser.feedBytes(mapped), 1U);
+    EXPECT_EQ(versionTrgVersion, 5);
+
+    // Letter field without a value at the very end of the input.
+    const char letter[] = "pump M";
+    ASSERT_EQ(mprotect(page, pageSize, PROT_READ | PROT_WRITE), 0);
+    end = page + pageSize - (sizeof(letter) - 1);
+    memcpy(end, letter, sizeof(letter) - 1);
+    ASSERT_EQ(mprotect(page, pageSize, PROT_READ), 0);
+
+    mapped = std::string_view(end, sizeof(letter) - 1);
+    EXPECT_FALSE(parser.feedLine(mapped));
+    EXPECT_EQ(parser.feedBuffer(mapped).rejected, 1U);
+    munmap(page, 2 * pageSize);
+}
+
+/**
+ * @brief Frames a line as "N<number> <line>*<checksum>".
+ */
+static std::string frameLine(uint32_t number, const std::string &line)
+{
+    std::string framed = "N" + std::to_string(number) + " " + line;
+    uint8_t checksum = 0;
+
+    for (char c : framed)
+    {
+        checksum ^= (uint8_t)c;
+    }
+
+    return framed + "*" + std::to_string(checksum);
+}
+
+TEST(ParserTest, FramedLineTest)
+{
+    static Cp_Parser_t parser;
+    std::string line;
+
+    Cp_RegisterEx(&parser, TriggerTable, 4);
+    EXPECT_EQ(Cp_GetLineNumberEx(&parser), 0U);
+
+    line = frameLine(0, "versi V11") + "\r";
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()), CP_FRAME_STATUS_ACCEPTED);
+    EXPECT_EQ(versionTrgVersion, 11);
+    EXPECT_EQ(Cp_GetLineNumberEx(&parser), 1U);
+
+    // A flipped bit is detected and the line isn't consumed.
+    line = frameLine(1, "versi V12");
+    line[9] ^= 0x04;
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()),
+              CP_FRAME_STATUS_CHECKSUM_MISMATCH);
+    EXPECT_EQ(versionTrgVersion, 11);
+    EXPECT_EQ(Cp_GetLineNumberEx(&parser), 1U);
+
+    // Gaps and repeats are reported with the expected line number kept.
+    line = frameLine(2, "versi V13");
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()),
+              CP_FRAME_STATUS_LINE_NUMBER_MISMATCH);
+    line = frameLine(0, "versi V13");
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()),
+              CP_FRAME_STATUS_LINE_NUMBER_MISMATCH);
+    EXPECT_EQ(Cp_GetLineNumberEx(&parser), 1U);
+
+    line = frameLine(1, "versi V12");
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()), CP_FRAME_STATUS_ACCEPTED);
+    EXPECT_EQ(versionTrgVersion, 12);
+
+    // Intact frames of rejected commands consume their line numbers.
+    line = frameLine(2, "jump");
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()), CP_FRAME_STATUS_REJECTED);
+    EXPECT_EQ(Cp_GetLineNumberEx(&parser), 3U);
+
+    const char *malformed[] = {"N3 versi V1", "N3 versi V1*", "N3 versi V1*1000", "N3 versi V1*x"};
+    for (const char *text : malformed)
+    {
+        EXPECT_EQ(Cp_FeedFramedLineEx(&parser, text, strlen(text)),
+                  CP_FRAME_STATUS_MISSING_CHECKSUM)
+            << text;
+    }
+
+    const std::string unnumbered[] = {frameLine(3, "versi V1").substr(3), "N-3 versi V1*35"};
+    for (const std::string &text : unnumbered)
+    {
+        line = text.substr(0, text.find('*'));
+        uint8_t checksum = 0;
+        for (char c : line)
+        {
+            checksum ^= (uint8_t)c;
+        }
+        line += "*" + std::to_string(checksum);
+        EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()),
+                  CP_FRAME_STATUS_MISSING_LINE_NUMBER)
+            << line;
+    }
+
+    // Oversized lines and commands dropped by the full queue can be resent.
+    std::string oversized = "versi";
+    for (int i = 0; i < 40; i++)
+    {
+        oversized += " V1";
+    }
+    line = frameLine(3, oversized);
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()), CP_FRAME_STATUS_OVERSIZED);
+    EXPECT_EQ(Cp_GetLineNumberEx(&parser), 3U);
+
+    static Cp_Command_t storage[1];
+    static Cp_Queue_t queue;
+    ASSERT_TRUE(Cp_QueueInit(&queue, storage, 1));
+    Cp_SetQueueEx(&parser, &queue);
+    line = frameLine(3, "versi V3");
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()), CP_FRAME_STATUS_ACCEPTED);
+    line = frameLine(4, "versi V4");
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()), CP_FRAME_STATUS_QUEUE_FULL);
+    EXPECT_EQ(Cp_GetLineNumberEx(&parser), 4U);
+    EXPECT_EQ(Cp_QueueDispatch(&queue, 0), 1U);
+    EXPECT_EQ(versionTrgVersion, 3);
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()), CP_FRAME_STATUS_ACCEPTED);
+    EXPECT_EQ(Cp_QueueDispatch(&queue, 0), 1U);
+    EXPECT_EQ(versionTrgVersion, 4);
+    Cp_SetQueueEx(&parser, NULL);
+
+    Cp_SetLineNumberEx(&parser, 100);
+    line = frameLine(100, "versi V-1");
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, line.data(), line.size()), CP_FRAME_STATUS_ACCEPTED);
+    EXPECT_EQ(versionTrgVersion, -1);
+    EXPECT_EQ(Cp_GetLineNumberEx(&parser), 101U);
+}
+
+TEST(ParserTest, MultiCommandTest)
+{
+    static std::vector<std::string> calls;
+    static Cp_Trigger_t commandTriggers[] = {
+        {"move",
+         {{'D', CP_PARAM_TYPE_INTEGER, TRUE}},
+         [](Dictionary_t *params) {
+             uint8_t type;
+             int32_t distance = *(int32_t *)Dictionary_Get(params, 'D', &type);
+             calls.push_back("move" + std::to_string(distance));
+         },
+         1},
+        {"pump",
+         {{'M', CP_PARAM_TYPE_LETTER, TRUE}},
+         [](Dictionary_t *params) {
+             uint8_t type;
+             calls.push_back(std::string("pump") + *(char *)Dictionary_Get(params, 'M', &type));
+         },
+         1},
+    };
+    static Cp_Parser_t parser;
+    const char line[] = "move D1; pump MA ;move Dx;; jump;move D2;pump\nmove D3";
+    Cp_LineStatus_t statuses[8];
+
+    Cp_RegisterEx(&parser, commandTriggers, 2);
+
+    // Sub-commands are dispatched in order, each with its own status.
+    Cp_FeedResult_t result = Cp_FeedCommandsEx(&parser, line, strlen(line), statuses, 8);
+    EXPECT_EQ(result.accepted, 3U);
+    EXPECT_EQ(result.rejected, 3U);
+    EXPECT_EQ(calls, std::vector<std::string>({"move1", "pumpA", "move2"}));
+
+    const Cp_LineStatus_t expected[] = {CP_LINE_STATUS_ACCEPTED, CP_LINE_STATUS_ACCEPTED,
+                                        CP_LINE_STATUS_REJECTED, CP_LINE_STATUS_REJECTED,
+                                        CP_LINE_STATUS_ACCEPTED, CP_LINE_STATUS_REJECTED};
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        EXPECT_EQ(statuses[i], expected[i]) << i;
+    }
+
+    // Statuses which don't fit are dropped; the commands still run.
+    calls.clear();
+    statuses[1] = 0xFF;
+    result = Cp_FeedCommandsEx(&parser, line, strlen(line), statuses, 1);
+    EXPECT_EQ(result.accepted, 3U);
+    EXPECT_EQ(statuses[0], CP_LINE_STATUS_ACCEPTED);
+    EXPECT_EQ(statuses[1], 0xFF);
+
+    // A single command is a line of one sub-command.
+    calls.clear();
+    result = Cp_FeedCommandsEx(&parser, "move D9", 7, NULL, 0);
+    EXPECT_EQ(result.accepted, 1U);
+    EXPECT_EQ(calls, std::vector<std::string>({"move9"}));
+
+    result = Cp_FeedCommandsEx(&parser, " ; ;", 4, NULL, 0);
+    EXPECT_EQ(result.accepted + result.rejected, 0U);
+}
+
+// Same triggers as TriggerTable. Callbacks read every parameter, so they 
+//are required.
+constexpr cparser::Trigger StaticTriggerTable[] = {
+    cparser::trigger("delay", delayTrgCallback, cparser::param('T', CP_PARAM_TYPE_REAL, true)),
+    cparser::trigger("versi", versionTrgCallback,
+                     cparser::param('V', CP_PARAM_TYPE_INTEGER, true)),
+    cparser::trigger("move", moveTrgCallback, cparser::param('D', CP_PARAM_TYPE_REAL, true),
+                     cparser::param('S', CP_PARAM_TYPE_REAL, true)),
+    cparser::trigger("pump", pumpTrgCallback, cparser::param('M', CP_PARAM_TYPE_LETTER, true),
+                     cparser::param('V', CP_PARAM_TYPE_REAL, true)),
+};
+
+TEST(ParserTest, StaticTableTest)
+{
+    static cparser::Parser fallback;
+    cparser::StaticParser<StaticTriggerTable> parser;
+    static Cp_Trigger_t count_trigger = {
+        "count", {{'N', CP_PARAM_TYPE_INTEGER}}, countTrgCallback, 1};
+
+    EXPECT_TRUE(parser.feedLine("delay T1E2"));
+    EXPECT_FLOAT_EQ(delayTrgTime, 100.0f);
+    EXPECT_EQ(delayTrgTimeType, CP_PARAM_TYPE_REAL);
+    EXPECT_TRUE(parser.feedLine("versi V10 V11"));
+    EXPECT_EQ(versionTrgVersion, 10);
+    EXPECT_EQ(versionTrgVersionType, CP_PARAM_TYPE_INTEGER);
+    EXPECT_TRUE(parser.feedLine("  move S5.0 X1 D1.0"));
+    EXPECT_FLOAT_EQ(moveTrgDisplacement, 1.0f);
+    EXPECT_FLOAT_EQ(moveTrgSpeed, 5.0f);
+    EXPECT_TRUE(parser.feedLine("pump V1.25 MD"));
+    EXPECT_EQ(pumpTrgMode, 'D');
+    EXPECT_EQ(pumpTrgModeType, CP_PARAM_TYPE_LETTER);
+    EXPECT_FLOAT_EQ(pumpTrgVolume, 1.25f);
+
+    EXPECT_FALSE(parser.feedLine("pump V1.25"));
+    EXPECT_FALSE(parser.feedLine("pump MDD V1"));
+    EXPECT_FALSE(parser.feedLine("versi Vx"));
+    EXPECT_FALSE(parser.feedLine("mov D1.0"));
+    EXPECT_FALSE(parser.feedLine("moves D1.0"));
+    EXPECT_FALSE(parser.feedLine(""));
+
+    Cp_FeedResult_t result = parser.feedBuffer("move D1.0 S5.0\r\n\nbogus\nversi V1x\n"
+                                               "  delay T2.5  \npump MA V3");
+    EXPECT_EQ(result.accepted, 3U);
+    EXPECT_EQ(result.rejected, 2U);
+    EXPECT_FLOAT_EQ(delayTrgTime, 2.5f);
+    EXPECT_EQ(pumpTrgMode, 'A');
+
+    // Triggers which aren't in the table are given to the fallback parser.
+    countTrgSum = 0;
+    fallback.add(&count_trigger, 1);
+    EXPECT_FALSE(parser.feedLine("count N3"));
+    parser.setFallback(&fallback.get());
+    EXPECT_TRUE(parser.feedLine("count N3"));
+    result = parser.feedBuffer("count N4\ncount Nx\nversi V12\n");
+    EXPECT_EQ(result.accepted, 2U);
+    EXPECT_EQ(result.rejected, 1U);
+    EXPECT_EQ(countTrgSum, 7);
+    EXPECT_EQ(versionTrgVersion, 12);
+
+    // Letter field without a value at the very end of a page which is
+    //followed by a guard page; a read past the input would fault.
+    long pageSize = sysconf(_SC_PAGESIZE);
+    char *page = (char *)mmap(NULL, 2 * pageSize, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(page, MAP_FAILED);
+    const char letter[] = "pump M";
+    char *end = page + pageSize - (sizeof(letter) - 1);
+    memcpy(end, letter, sizeof(letter) - 1);
+    ASSERT_EQ(mprotect(page + pageSize, pageSize, PROT_NONE), 0);
+
+    EXPECT_FALSE(parser.feedLine(std::string_view(end, sizeof(letter) - 1)));
+    munmap(page, 2 * pageSize);
+}
+
+TEST(ParserTest, StaticTableMatchesRuntimeTest)
+{
+    static Cp_Parser_t runtime;
+    static Cp_Trigger_t triggers[] = {
+        {"delay", {{'T', CP_PARAM_TYPE_REAL, TRUE}}, delayTrgCallback, 1},
+        {"versi", {{'V', CP_PARAM_TYPE_INTEGER, TRUE}}, versionTrgCallback, 1},
+        {"move",
+         {{'D', CP_PARAM_TYPE_REAL, TRUE}, {'S', CP_PARAM_TYPE_REAL, TRUE}},
+         moveTrgCallback,
+         2},
+        {"pump",
+         {{'M', CP_PARAM_TYPE_LETTER, TRUE}, {'V', CP_PARAM_TYPE_REAL, TRUE}},
+         pumpTrgCallback,
+         2},
+    };
+    static const char *const names[] = {"delay", "versi", "move", "pump", "mov", "pumps", "x"};
+    static const char *const fields[] = {"T1", "V-2", "D1.5", "S3", "MX", "Mxy", "V1E2", "Q1",
+                                         "D", "Sx", "T-0.5"};
+    cparser::StaticParser<StaticTriggerTable> parser;
+    srand(2024);
+
+
+    Cp_Init(&runtime);
+    Cp_RegisterEx(&runtime, triggers, 4);
+
+    for (int n = 0; n < 20000; n++)
+    {
+        std::string line = names[rand() % (sizeof(names) / sizeof(names[0]))];
+        for (int i = rand() % 7; i > 0; i--)
+        {
+            line += " ";
+            line += fields[rand() % (sizeof(fields) / sizeof(fields[0]))];
+        }
+
+        delayTrgTime = moveTrgDisplacement = moveTrgSpeed = pumpTrgVolume = 0.0f;
+        versionTrgVersion = 0;
+        pumpTrgMode = ' ';
+        uint8_t expected = Cp_FeedLineEx(&runtime, line.data(), (uint16_t)line.size());
+        auto state = std::make_tuple(delayTrgTime, moveTrgDisplacement, moveTrgSpeed,
+                                     pumpTrgVolume, versionTrgVersion, pumpTrgMode);
+
+        delayTrgTime = moveTrgDisplacement = moveTrgSpeed = pumpTrgVolume = 0.0f;
+        versionTrgVersion = 0;
+        pumpTrgMode = ' ';
+        ASSERT_EQ(parser.feedLine(line), expected == TRUE) << line;
+        ASSERT_EQ(std::make_tuple(delayTrgTime, moveTrgDisplacement, moveTrgSpeed,
+                                  pumpTrgVolume, versionTrgVersion, pumpTrgMode),
+                  state)
+            << line;
+    }
+}
+
 void versionTrgCallback(Dictionary_t *params)
 {
     versionTrgTriggered = TRUE;
@@ -164,4 +1970,62 @@ void delayTrgCallback(Dictionary_t *params)
     delayTrgTriggered = TRUE;
     delayTrgTime = *((float *)Dictionary_Get(params, 'T',
                                              &delayTrgTimeType));
-}
\ No newline at end of file
+}
+
+void countTrgCallback(Dictionary_t *params)
+{
+    uint8_t type;
+
+    countTrgSum += *((int32_t *)Dictionary_Get(params, 'N', &type));
+    countTrgCalls++;
+}
+
+void sequenceTrgCallback(Dictionary_t *params)
+{
+    uint8_t type;
+    int32_t value = *((int32_t *)Dictionary_Get(params, 'N', &type));
+
+    // Unordered feeds invoke the callbacks concurrently.
+    std::lock_guard<std::mutex> lock(sequenceTrgMutex);
+    sequenceTrgValues.push_back(value);
+}
+
+void bindTrgCallback(Dictionary_t *params)
+{
+    uint8_t type;
+    void *hash = Dictionary_Get(params, '#', &type);
+
+    bindTrgCalls++;
+    bindTrgX = *((int32_t *)Dictionary_Get(params, 'X', &type));
+    bindTrgY = Dictionary_DoesExist(params, 'y') ? *((int32_t *)Dictionary_Get(params, 'y', &type)) : 0;
+    bindTrgHash = hash ? *((char *)hash) : 0;
+}
+
+void typedTrgCallback(void *output, uint32_t present)
+{
+    typedTrgOutput = *((TypedTrgOutput *)output);
+    typedTrgPresent = present;
+    typedTrgCalls++;
+}
+
+void fixedTrgCallback(void *output, uint32_t present)
+{
+    (void)present;
+    fixedTrgOutput = *(FixedTrgOutput *)output;
+}
+
+// Triggers of triggers.spec which the CparserTest cases don't use.
+void modeTrgCallback(Dictionary_t *params)
+{
+    (void)params;
+}
+
+void homeTrgCallback(Dictionary_t *params)
+{
+    (void)params;
+}
+
+void mTrgCallback(Dictionary_t *params)
+{
+    (void)params;
+}
@@ -0,0 +1,281 @@
+#include "gtest/gtest.h"
+#include "../cparser/inc/cparser.h"
+#include "../cparser/inc/cparser_trace.h"
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define LOAD_HEAD(buffer) __atomic_load_n(&(buffer).head, __ATOMIC_ACQUIRE)
+
+/* Private function prototypes ---------------------------------------------*/
+static void moveTrgCallback(Dictionary_t *params);
+static void appendText(const char *text, size_t length, void *context);
+static size_t countText(const std::string &text, const std::string &pattern);
+
+/* Private variables -------------------------------------------------------*/
+Cp_Trigger_t TraceTriggerTable[] =
+    {
+        {"stop", {}, moveTrgCallback, 0},
+        {"move",
+         {{'X', CP_PARAM_TYPE_INTEGER, TRUE}, {'F', CP_PARAM_TYPE_REAL}},
+         moveTrgCallback,
+         2},
+};
+
+/* Tests -------------------------------------------------------------------*/
+TEST(TraceTest, StagesTest)
+{
+    static Cp_Parser_t parser;
+    static Cp_TraceBuffer_t buffer;
+    const char accepted[] = "move X1 F2";
+    const char malformed[] = "move Xa";
+    const char unknown[] = "jump X1";
+
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, TraceTriggerTable, 2);
+    Cp_TraceInit(&buffer, 7);
+
+    // Nothing is recorded without a buffer.
+    EXPECT_EQ(Cp_TraceGetBuffer(), nullptr);
+    EXPECT_EQ(Cp_FeedLineEx(&parser, accepted, sizeof(accepted) - 1), TRUE);
+
+    Cp_TraceAttach(&buffer);
+    Cp_TraceAttach(&buffer);
+    EXPECT_EQ(Cp_TraceGetBuffer(), &buffer);
+    EXPECT_EQ(Cp_TraceNumOfAttached, 1U);
+    EXPECT_EQ(Cp_FeedLineEx(&parser, accepted, sizeof(accepted) - 1), TRUE);
+    EXPECT_EQ(Cp_FeedLineEx(&parser, malformed, sizeof(malformed) - 1), FALSE);
+    EXPECT_EQ(Cp_FeedLineEx(&parser, unknown, sizeof(unknown) - 1), FALSE);
+    Cp_TraceAttach(NULL);
+    EXPECT_EQ(Cp_TraceNumOfAttached, 0U);
+
+    const struct
+    {
+        uint8_t stage;
+        uint8_t end;
+        uint16_t trigger;
+        uint32_t line;
+    } expected[] = {
+        {CP_TRACE_STAGE_LINE, FALSE, CP_TRACE_NO_TRIGGER, 1},
+        {CP_TRACE_STAGE_TOKENIZE, FALSE, CP_TRACE_NO_TRIGGER, 1},
+        {CP_TRACE_STAGE_TOKENIZE, TRUE, CP_TRACE_NO_TRIGGER, 1},
+        {CP_TRACE_STAGE_LOOKUP, FALSE, CP_TRACE_NO_TRIGGER, 1},
+        {CP_TRACE_STAGE_LOOKUP, TRUE, 1, 1},
+        {CP_TRACE_STAGE_DECODE, FALSE, 1, 1},
+        {CP_TRACE_STAGE_DECODE, TRUE, 1, 1},
+        {CP_TRACE_STAGE_CALLBACK, FALSE, 1, 1},
+        {CP_TRACE_STAGE_CALLBACK, TRUE, 1, 1},
+        {CP_TRACE_STAGE_LINE, TRUE, 1, 1},
+        {CP_TRACE_STAGE_LINE, FALSE, CP_TRACE_NO_TRIGGER, 2},
+        {CP_TRACE_STAGE_TOKENIZE, FALSE, CP_TRACE_NO_TRIGGER, 2},
+        {CP_TRACE_STAGE_TOKENIZE, TRUE, CP_TRACE_NO_TRIGGER, 2},
+        {CP_TRACE_STAGE_LOOKUP, FALSE, CP_TRACE_NO_TRIGGER, 2},
+        {CP_TRACE_STAGE_LOOKUP, TRUE, 1, 2},
+        {CP_TRACE_STAGE_DECODE, FALSE, 1, 2},
+        {CP_TRACE_STAGE_DECODE, TRUE, 1, 2},
+        {CP_TRACE_STAGE_LINE, TRUE, CP_TRACE_NO_TRIGGER, 2},
+        {CP_TRACE_STAGE_LINE, FALSE, CP_TRACE_NO_TRIGGER, 3},
+        {CP_TRACE_STAGE_TOKENIZE, FALSE, CP_TRACE_NO_TRIGGER, 3},
+        {CP_TRACE_STAGE_TOKENIZE, TRUE, CP_TRACE_NO_TRIGGER, 3},
+        {CP_TRACE_STAGE_LOOKUP, FALSE, CP_TRACE_NO_TRIGGER, 3},
+        {CP_TRACE_STAGE_LOOKUP, TRUE, CP_TRACE_NO_TRIGGER, 3},
+        {CP_TRACE_STAGE_LINE, TRUE, CP_TRACE_NO_TRIGGER, 3},
+    };
+    const size_t numOfExpected = sizeof(expected) / sizeof(expected[0]);
+
+    ASSERT_EQ(buffer.head, numOfExpected);
+    for (size_t i = 0; i < numOfExpected; i++)
+    {
+        const Cp_TraceRecord_t &record = buffer.records[i];
+
+        EXPECT_EQ(record.stage, expected[i].stage) << i;
+        EXPECT_EQ(record.end, expected[i].end) << i;
+        EXPECT_EQ(record.trigger, expected[i].trigger) << i;
+        EXPECT_EQ(record.line, expected[i].line) << i;
+        if (i > 0)
+        {
+            EXPECT_GE(record.timestamp, buffer.records[i - 1].timestamp) << i;
+        }
+    }
+
+    std::string json;
+    const Cp_TraceBuffer_t *buffers[] = {&buffer};
+    EXPECT_EQ(Cp_TraceExport(buffers, 1, 1000, appendText, &json), numOfExpected);
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[\n{\"name\":\"line\",\"cat\":\"cparser\",\"ph\":\"B\","
+                         "\"ts\":0.000,\"pid\":1,\"tid\":7,\"args\":{\"line\":1}},\n",
+                         0),
+              0U);
+    EXPECT_EQ(countText(json, "\"ph\":\"B\""), 12U);
+    EXPECT_EQ(countText(json, "\"ph\":\"E\""), 12U);
+    EXPECT_EQ(countText(json, "\"name\":\"parseValue\""), 4U);
+    EXPECT_EQ(countText(json, "\"name\":\"callback\",\"cat\":\"cparser\",\"ph\":\"E\""), 1U);
+    EXPECT_EQ(countText(json, "\"trigger\":1}"), 9U);
+    EXPECT_EQ(json.substr(json.size() - 28), "}\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+TEST(TraceTest, BufferLinesTest)
+{
+    static Cp_Parser_t parser;
+    static Cp_TraceBuffer_t buffer;
+    const char lines[] = "move X1\n\nstop\nmove Xa\n";
+    std::string json;
+    const Cp_TraceBuffer_t *buffers[] = {&buffer};
+
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, TraceTriggerTable, 2);
+    Cp_TraceInit(&buffer, 0);
+
+    Cp_TraceAttach(&buffer);
+    Cp_FeedBufferEx(&parser, lines, sizeof(lines) - 1);
+    Cp_TraceAttach(NULL);
+
+    // Every line is traced, also the empty one.
+    Cp_TraceExport(buffers, 1, 1, appendText, &json);
+    EXPECT_EQ(buffer.line, 4U);
+    EXPECT_EQ(countText(json, "\"name\":\"line\",\"cat\":\"cparser\",\"ph\":\"B\""), 4U);
+    EXPECT_EQ(countText(json, "\"name\":\"parseFields\",\"cat\":\"cparser\",\"ph\":\"B\""), 4U);
+    EXPECT_EQ(countText(json, "\"name\":\"callback\",\"cat\":\"cparser\",\"ph\":\"B\""), 2U);
+}
+
+TEST(TraceTest, FeedPathsTest)
+{
+    static Cp_Parser_t parser;
+    static Cp_TraceBuffer_t buffer;
+    std::string framed = "N0 move X1";
+    const char commands[] = "move X1; stop; move Xa";
+    std::string json;
+    const Cp_TraceBuffer_t *buffers[] = {&buffer};
+    uint8_t checksum = 0;
+
+    for (char c : framed)
+    {
+        checksum ^= (uint8_t)c;
+    }
+    framed += "*" + std::to_string(checksum);
+
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, TraceTriggerTable, 2);
+    Cp_TraceInit(&buffer, 0);
+
+    Cp_TraceAttach(&buffer);
+    EXPECT_EQ(Cp_FeedFramedLineEx(&parser, framed.data(), framed.size()),
+              CP_FRAME_STATUS_ACCEPTED);
+    Cp_FeedCommandsEx(&parser, commands, sizeof(commands) - 1, NULL, 0);
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, "move X1", 7), 0U);
+    EXPECT_EQ(Cp_FeedBytesEx(&parser, "2\n  \nstop\n", 10), 2U);
+    Cp_TraceAttach(NULL);
+
+    // Sub-commands are traced as lines, blank stream lines aren't traced. A
+    //stream line is tokenized in each piece it arrives in.
+    Cp_TraceExport(buffers, 1, 1, appendText, &json);
+    EXPECT_EQ(buffer.line, 6U);
+    EXPECT_EQ(countText(json, "\"name\":\"line\",\"cat\":\"cparser\",\"ph\":\"B\""), 6U);
+    EXPECT_EQ(countText(json, "\"name\":\"line\",\"cat\":\"cparser\",\"ph\":\"E\""), 6U);
+    EXPECT_EQ(countText(json, "\"name\":\"parseFields\",\"cat\":\"cparser\",\"ph\":\"B\""), 7U);
+    EXPECT_EQ(countText(json, "\"name\":\"parseFields\",\"cat\":\"cparser\",\"ph\":\"E\""), 7U);
+    EXPECT_EQ(countText(json, "\"name\":\"callback\",\"cat\":\"cparser\",\"ph\":\"B\""), 5U);
+}
+
+TEST(TraceTest, WrapTest)
+{
+    static Cp_Parser_t parser;
+    static Cp_TraceBuffer_t buffer;
+    const char line[] = "move X1 F2";
+    std::string json;
+    const Cp_TraceBuffer_t *buffers[] = {&buffer};
+
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, TraceTriggerTable, 2);
+    Cp_TraceInit(&buffer, 0);
+
+    // Ring keeps the latest records; ends whose begins are overwritten are
+    //left out of the export.
+    Cp_TraceAttach(&buffer);
+    for (int i = 0; i < 1001; i++)
+    {
+        Cp_FeedLineEx(&parser, line, sizeof(line) - 1);
+    }
+    Cp_TraceAttach(NULL);
+
+    size_t events = Cp_TraceExport(buffers, 1, 1, appendText, &json);
+    EXPECT_EQ(buffer.head, 10010U);
+    EXPECT_LE(events, (size_t)CPARSER_CONFIG_TRACE_BUFFER_SIZE);
+    EXPECT_EQ(countText(json, "\"ph\":\"B\""), countText(json, "\"ph\":\"E\""));
+    EXPECT_NE(json.find("\"line\":1001"), std::string::npos);
+    EXPECT_EQ(json.find("\"line\":890,"), std::string::npos);
+}
+
+TEST(TraceTest, ThreadsTest)
+{
+    static Cp_Parser_t parser;
+    static Cp_TraceBuffer_t buffers[2];
+    const Cp_TraceBuffer_t *exported[] = {&buffers[0], &buffers[1]};
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+
+    Cp_Init(&parser);
+    Cp_RegisterEx(&parser, TraceTriggerTable, 2);
+
+    // Each thread writes into its own buffer while they are exported; a 
+    //decoded line takes six records.
+    for (uint32_t t = 0; t < 2; t++)
+    {
+        Cp_TraceInit(&buffers[t], t + 1);
+        threads.emplace_back([&, t]() {
+            const char line[] = "move X1 F2";
+            Cp_Command_t command;
+
+            Cp_TraceAttach(&buffers[t]);
+            for (int i = 0; i < 20000; i++)
+            {
+                EXPECT_EQ(Cp_DecodeLineEx(&parser, line, sizeof(line) - 1, &command), TRUE);
+            }
+            Cp_TraceAttach(NULL);
+        });
+    }
+
+    while (!done)
+    {
+        std::string json;
+
+        Cp_TraceExport(exported, 2, 1, appendText, &json);
+        EXPECT_EQ(json.back(), '\n');
+        done = (LOAD_HEAD(buffers[0]) == 120000U && LOAD_HEAD(buffers[1]) == 120000U);
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::string json;
+    Cp_TraceExport(exported, 2, 1, appendText, &json);
+    EXPECT_GT(countText(json, "\"tid\":1,"), 0U);
+    EXPECT_GT(countText(json, "\"tid\":2,"), 0U);
+    EXPECT_EQ(countText(json, "\"ph\":\"B\""), countText(json, "\"ph\":\"E\""));
+}
+
+/* Private functions -------------------------------------------------------*/
+void moveTrgCallback(Dictionary_t *params)
+{
+    (void)params;
+}
+
+void appendText(const char *text, size_t length, void *context)
+{
+    ((std::string *)context)->append(text, length);
+}
+
+size_t countText(const std::string &text, const std::string &pattern)
+{
+    size_t count = 0;
+
+    for (size_t i = text.find(pattern); i != std::string::npos; i = text.find(pattern, i + 1))
+    {
+        count++;
+    }
+
+    return count;
+}
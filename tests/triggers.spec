@@ -0,0 +1,11 @@
+# Triggers of the generated parser tests(gen_test.cpp and the CparserTest
+# cases of test.cpp). First four are the ones of CparserTest, the others cover
+# the required parameters, the names which differ only after the first 
+# character and the one letter names.
+delay T:real -> delayTrgCallback
+versi V:integer -> versionTrgCallback
+move D:real S:real -> moveTrgCallback
+pump M:letter V:real -> pumpTrgCallback
+mode M:letter! -> modeTrgCallback
+home X:integer! Y:fixed #:letter -> homeTrgCallback
+m Z:letter -> mTrgCallback
@@ -0,0 +1,824 @@
+/**
+ * @file cparser_gen.c
+ * 
+ * Compiles a trigger spec into a parser specialized for that trigger set.
+ * Trigger name is dispatched with a switch on its length and first
+ * character, and each trigger has its own decoder which parses each
+ * parameter with the function of its type; so nothing is registered or
+ * looked up at run time. Generated parser accepts and rejects the same
+ * lines as the generic one with the same triggers registered.
+ * 
+ * Usage: cparser_gen [-p prefix] -o output specfile
+ * 
+ * Spec file has the format of cparser_replay; each trigger spec is also
+ * given the callback symbol after "->", e.g. "move D:real! S:real -> onMove".
+ * A parameter type followed by '!' makes the parameter required. Parser is
+ * written into output.c and output.h and its functions are named
+ * prefix_FeedLine and prefix_FeedBuffer("Gen" by default).
+ */
+#include "../cparser/inc/cparser.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private constants -------------------------------------------------------*/
+#define MAX_SPEC_LINE_LENGTH 256
+#define MAX_SYMBOL_LENGTH 63
+
+/* Private typedefs --------------------------------------------------------*/
+/* Trigger read from the spec. */
+typedef struct
+{
+    char name[CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH + 1];
+    Cp_Param_t params[CPARSER_CONFIG_MAX_NUM_OF_PARAMS];
+    uint8_t numOfParams;
+    char callback[MAX_SYMBOL_LENGTH + 1];
+} Spec_t;
+
+/* Private function prototypes ---------------------------------------------*/
+static Bool_t addSpec(const char *spec);
+static Bool_t addSpecFile(const char *path);
+static Bool_t parseParam(const char *token, Cp_Param_t *param);
+static Bool_t parseType(const char *name, Cp_ParamType_t *type);
+static Bool_t isSymbol(const char *symbol);
+static Bool_t writeHeader(const char *path, const char *include, const char *prefix);
+static Bool_t writeSource(const char *path, const char *include, const char *prefix);
+static void writeGuards(FILE *file);
+static void writeDispatch(FILE *file);
+static void writeDecoder(FILE *file, uint16_t index);
+static void writeFeeds(FILE *file, const char *prefix);
+static void writeBanner(FILE *file, const char *indent, const char *title);
+static void writeChar(FILE *file, char c);
+static void writeString(FILE *file, const char *value);
+static int compareSpecs(const void *a, const void *b);
+
+/* Private variables -------------------------------------------------------*/
+static Spec_t Specs[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS];
+static uint16_t NumOfSpecs = 0;
+static const char *SpecPath;
+static const char *SpecName;
+
+static const char *const TypeNames[] = {"letter", "integer", "real", "fixed"};
+static const char *const ValueTypes[] = {"char", "int32_t", "float", "int32_t"};
+static const char *const ParseFunctions[] = {NULL, "Number_ParseInteger", "Number_ParseFloat",
+                                             "Number_ParseFixed"};
+static const char *const TypeConstants[] = {"CP_PARAM_TYPE_LETTER", "CP_PARAM_TYPE_INTEGER",
+                                            "CP_PARAM_TYPE_REAL", "CP_PARAM_TYPE_FIXED"};
+
+/* Exported functions ------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+    const char *prefix = "Gen";
+    const char *output = NULL;
+    char path[FILENAME_MAX];
+    const char *include;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+        {
+            prefix = argv[++i];
+        }
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (argv[i][0] != '-' && !SpecPath)
+        {
+            SpecPath = argv[i];
+        }
+        else
+        {
+            SpecPath = NULL;
+            break;
+        }
+    }
+
+    if (!SpecPath || !output || !isSymbol(prefix) || strlen(output) + 3 > sizeof(path))
+    {
+        fprintf(stderr, "usage: %s [-p prefix] -o output specfile\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!addSpecFile(SpecPath))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (NumOfSpecs == 0)
+    {
+        fprintf(stderr, "%s: no triggers\n", SpecPath);
+        return EXIT_FAILURE;
+    }
+
+    // Dispatch is generated from the triggers grouped by the name length and
+    //the first character.
+    qsort(Specs, NumOfSpecs, sizeof(Spec_t), compareSpecs);
+    for (uint16_t i = 1; i < NumOfSpecs; i++)
+    {
+        if (strcmp(Specs[i - 1].name, Specs[i].name) == 0)
+        {
+            fprintf(stderr, "%s: trigger '%s' is given twice\n", SpecPath, Specs[i].name);
+            return EXIT_FAILURE;
+        }
+    }
+
+    include = strrchr(output, '/');
+    include = include ? include + 1 : output;
+    SpecName = strrchr(SpecPath, '/');
+    SpecName = SpecName ? SpecName + 1 : SpecPath;
+
+    sprintf(path, "%s.h", output);
+    if (!writeHeader(path, include, prefix))
+    {
+        return EXIT_FAILURE;
+    }
+
+    sprintf(path, "%s.c", output);
+    if (!writeSource(path, include, prefix))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Adds a trigger from its spec.
+ * 
+ * @param spec: Trigger spec, e.g. "move D:real! S:real -> onMove".
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t addSpec(const char *spec)
+{
+    char copy[MAX_SPEC_LINE_LENGTH];
+    Spec_t *trigger;
+    char *token;
+
+    if (NumOfSpecs == CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS)
+    {
+        fprintf(stderr, "too many triggers, at most %d can be generated\n",
+                CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS);
+        return FALSE;
+    }
+
+    if (strlen(spec) >= sizeof(copy))
+    {
+        fprintf(stderr, "spec is too long: %s\n", spec);
+        return FALSE;
+    }
+
+    strcpy(copy, spec);
+    token = strtok(copy, " \t\r\n");
+    if (!token || strlen(token) > CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH)
+    {
+        fprintf(stderr, "invalid trigger name in spec: %s\n", spec);
+        return FALSE;
+    }
+
+    trigger = &Specs[NumOfSpecs];
+    memset(trigger, 0, sizeof(Spec_t));
+    strcpy(trigger->name, token);
+
+    while ((token = strtok(NULL, " \t\r\n")) != NULL && strcmp(token, "->") != 0)
+    {
+        Cp_Param_t *param = &trigger->params[trigger->numOfParams];
+
+        if (trigger->numOfParams == CPARSER_CONFIG_MAX_NUM_OF_PARAMS || !parseParam(token, param))
+        {
+            fprintf(stderr, "invalid parameter '%s' in spec: %s\n", token, spec);
+            return FALSE;
+        }
+
+        // Only the first one of a repeated letter would ever be decoded.
+        for (uint8_t i = 0; i < trigger->numOfParams; i++)
+        {
+            if (trigger->params[i].letter == param->letter)
+            {
+                fprintf(stderr, "parameter '%c' is given twice in spec: %s\n", param->letter,
+                        spec);
+                return FALSE;
+            }
+        }
+
+        trigger->numOfParams++;
+    }
+
+    token = token ? strtok(NULL, " \t\r\n") : NULL;
+    if (!token || strlen(token) > MAX_SYMBOL_LENGTH || !isSymbol(token) ||
+        strtok(NULL, " \t\r\n") != NULL)
+    {
+        fprintf(stderr, "invalid callback symbol in spec: %s\n", spec);
+        return FALSE;
+    }
+
+    strcpy(trigger->callback, token);
+    NumOfSpecs++;
+    return TRUE;
+}
+
+/**
+ * @brief Adds the triggers of a spec file.
+ * 
+ * @param path: Path of the spec file.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t addSpecFile(const char *path)
+{
+    char line[MAX_SPEC_LINE_LENGTH];
+    FILE *file = fopen(path, "r");
+    Bool_t retval = TRUE;
+
+    if (!file)
+    {
+        perror(path);
+        return FALSE;
+    }
+
+    while (retval && fgets(line, sizeof(line), file))
+    {
+        size_t skip = strspn(line, " \t\r\n");
+
+        if (line[skip] != '\0' && line[skip] != '#')
+        {
+            retval = addSpec(line);
+        }
+    }
+
+    fclose(file);
+    return retval;
+}
+
+/**
+ * @brief Parses a parameter spec.
+ * 
+ * @param token: Parameter spec, e.g. "D:real!".
+ * @param param: Pointer to return the parameter.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t parseParam(const char *token, Cp_Param_t *param)
+{
+    char type[16];
+    size_t length;
+
+    if (token[0] == '\0' || token[1] != ':')
+    {
+        return FALSE;
+    }
+
+    length = strlen(&token[2]);
+    param->letter = token[0];
+    param->required = (length > 0 && token[1 + length] == '!') ? TRUE : FALSE;
+    length -= param->required ? 1 : 0;
+
+    if (length >= sizeof(type))
+    {
+        return FALSE;
+    }
+
+    memcpy(type, &token[2], length);
+    type[length] = '\0';
+    return parseType(type, &param->type);
+}
+
+/**
+ * @brief Parses a parameter type name.
+ * 
+ * @param name: Type name; letter, integer, real or fixed.
+ * @param type: Pointer to return the type.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t parseType(const char *name, Cp_ParamType_t *type)
+{
+    for (uint8_t i = 0; i < sizeof(TypeNames) / sizeof(TypeNames[0]); i++)
+    {
+        if (strcmp(name, TypeNames[i]) == 0)
+        {
+            *type = i;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/**
+ * @brief Checks if the string is a C identifier.
+ * 
+ * @param symbol: Null terminated string.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t isSymbol(const char *symbol)
+{
+    if (!isalpha((unsigned char)symbol[0]) && symbol[0] != '_')
+    {
+        return FALSE;
+    }
+
+    for (const char *c = symbol; *c; c++)
+    {
+        if (!isalnum((unsigned char)*c) && *c != '_')
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Writes the header of the generated parser.
+ * 
+ * @param path: Path of the header.
+ * @param include: Base name of the generated files.
+ * @param prefix: Prefix of the generated functions.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t writeHeader(const char *path, const char *include, const char *prefix)
+{
+    FILE *file = fopen(path, "w");
+
+    if (!file)
+    {
+        perror(path);
+        return FALSE;
+    }
+
+    fprintf(file, "/**\n * @file %s.h\n * \n", include);
+    fprintf(file, " * Parser generated by cparser_gen from %s; don't edit.\n */\n", SpecName);
+    fprintf(file, "#ifndef __");
+    for (const char *c = include; *c; c++)
+    {
+        fputc(isalnum((unsigned char)*c) ? toupper((unsigned char)*c) : '_', file);
+    }
+    fprintf(file, "_H\n#define __");
+    for (const char *c = include; *c; c++)
+    {
+        fputc(isalnum((unsigned char)*c) ? toupper((unsigned char)*c) : '_', file);
+    }
+    fprintf(file, "_H\n\n");
+    fprintf(file, "#include \"cparser.h\"\n\n");
+    fprintf(file, "#ifdef __cplusplus\nextern \"C\"\n{\n#endif\n");
+
+    writeBanner(file, "    ", "Callbacks");
+    for (uint16_t i = 0; i < NumOfSpecs; i++)
+    {
+        // A callback may serve several triggers.
+        Bool_t declared = FALSE;
+        for (uint16_t j = 0; j < i; j++)
+        {
+            declared = declared || (strcmp(Specs[i].callback, Specs[j].callback) == 0);
+        }
+
+        if (!declared)
+        {
+            fprintf(file, "    extern void %s(Dictionary_t *params);\n", Specs[i].callback);
+        }
+    }
+
+    fprintf(file, "\n");
+    writeBanner(file, "    ", "Functions");
+    fprintf(file, "    extern uint8_t %s_FeedLine(const char *input, uint16_t length);\n", prefix);
+    fprintf(file, "    extern Cp_FeedResult_t %s_FeedBuffer(const char *buffer, size_t length);\n",
+            prefix);
+    fprintf(file, "#ifdef __cplusplus\n}\n#endif\n\n#endif\n");
+
+    return (fclose(file) == 0) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Writes the source of the generated parser.
+ * 
+ * @param path: Path of the source.
+ * @param include: Base name of the generated files.
+ * @param prefix: Prefix of the generated functions.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t writeSource(const char *path, const char *include, const char *prefix)
+{
+    FILE *file = fopen(path, "w");
+
+    if (!file)
+    {
+        perror(path);
+        return FALSE;
+    }
+
+    fprintf(file, "/**\n * @file %s.c\n * \n", include);
+    fprintf(file, " * Parser generated by cparser_gen from %s; don't edit.\n */\n", SpecName);
+    fprintf(file, "#include \"%s.h\"\n#include \"tokenizer.h\"\n#include \"number.h\"\n", include);
+    fprintf(file, "#include <string.h>\n\n");
+    writeGuards(file);
+
+    writeBanner(file, "", "Private constants");
+    fprintf(file, "#define MAX_FIELD_COUNT (CPARSER_CONFIG_MAX_NUM_OF_PARAMS + 1)\n\n");
+
+    writeBanner(file, "", "Private function prototypes");
+    fprintf(file, "static Bool_t decodeFields(const char *input, const Field_t *fields, "
+                  "uint8_t numOfFields);\n");
+    for (uint16_t i = 0; i < NumOfSpecs; i++)
+    {
+        fprintf(file, "static Bool_t decodeTrigger%u(const char *input, const Field_t *fields, "
+                      "uint8_t numOfFields);\n",
+                i);
+    }
+
+    fprintf(file, "\n");
+    writeBanner(file, "", "Exported functions");
+    writeFeeds(file, prefix);
+
+    writeBanner(file, "", "Private functions");
+    writeDispatch(file);
+    for (uint16_t i = 0; i < NumOfSpecs; i++)
+    {
+        writeDecoder(file, i);
+    }
+
+    return (fclose(file) == 0) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Writes the checks of the configuration which the spec depends on.
+ * 
+ * @param file: Output file.
+ */
+void writeGuards(FILE *file)
+{
+    uint8_t max_params = 0;
+    Bool_t real = FALSE;
+
+    for (uint16_t i = 0; i < NumOfSpecs; i++)
+    {
+        max_params = (Specs[i].numOfParams > max_params) ? Specs[i].numOfParams : max_params;
+        for (uint8_t j = 0; j < Specs[i].numOfParams; j++)
+        {
+            real = real || (Specs[i].params[j].type == CP_PARAM_TYPE_REAL);
+        }
+    }
+
+    fprintf(file, "#if CPARSER_CONFIG_MAX_NUM_OF_PARAMS < %u\n", max_params);
+    fprintf(file, "#error \"A trigger has more parameters than a dictionary can hold\"\n#endif\n");
+    if (real)
+    {
+        fprintf(file, "#if !CPARSER_CONFIG_REAL\n");
+        fprintf(file, "#error \"Real parameters need CPARSER_CONFIG_REAL\"\n#endif\n");
+    }
+    fprintf(file, "\n");
+}
+
+/**
+ * @brief Writes the feed functions of the parser. They tokenize the lines
+ * like Cp_FeedLine and Cp_FeedBuffer do.
+ * 
+ * @param file: Output file.
+ * @param prefix: Prefix of the generated functions.
+ */
+void writeFeeds(FILE *file, const char *prefix)
+{
+    fprintf(file,
+            "/**\n"
+            " * @brief Feeds a line, like Cp_FeedLine does.\n"
+            " * \n"
+            " * @param input: Line char array.\n"
+            " * @param length: Length of the char array.\n"
+            " * \n"
+            " * @retval TRUE or FALSE.\n"
+            " */\n"
+            "uint8_t %s_FeedLine(const char *input, uint16_t length)\n"
+            "{\n"
+            "    Field_t fields[MAX_FIELD_COUNT];\n"
+            "    uint8_t field_count;\n"
+            "\n"
+            "    Tokenizer_ParseFields(input, length, fields, MAX_FIELD_COUNT, &field_count);\n"
+            "    return decodeFields(input, fields, field_count);\n"
+            "}\n"
+            "\n",
+            prefix);
+
+    fprintf(file,
+            "/**\n"
+            " * @brief Feeds a buffer of new line separated lines, like Cp_FeedBuffer \n"
+            " * does.\n"
+            " * \n"
+            " * @param buffer: Pointer to the buffer.\n"
+            " * @param length: Length of the buffer.\n"
+            " * \n"
+            " * @retval Numbers of the accepted and rejected lines.\n"
+            " */\n"
+            "Cp_FeedResult_t %s_FeedBuffer(const char *buffer, size_t length)\n"
+            "{\n"
+            "    Cp_FeedResult_t result = {0, 0};\n"
+            "    Field_t fields[MAX_FIELD_COUNT];\n"
+            "    size_t offset = 0;\n"
+            "\n"
+            "    while (offset < length)\n"
+            "    {\n"
+            "        const char *line = &buffer[offset];\n"
+            "        uint8_t field_count;\n"
+            "\n"
+            "        offset += Tokenizer_ParseNextLine(line, length - offset, fields,\n"
+            "                                          MAX_FIELD_COUNT, &field_count, NULL);\n"
+            "\n"
+            "        if (field_count != 0)\n"
+            "        {\n"
+            "            if (decodeFields(line, fields, field_count))\n"
+            "            {\n"
+            "                result.accepted++;\n"
+            "            }\n"
+            "            else\n"
+            "            {\n"
+            "                result.rejected++;\n"
+            "            }\n"
+            "        }\n"
+            "    }\n"
+            "\n"
+            "    return result;\n"
+            "}\n"
+            "\n",
+            prefix);
+}
+
+/**
+ * @brief Writes the dispatch of the trigger name; a switch on the name
+ * length, then on its first character. Remaining characters are compared
+ * with a constant length memcmp.
+ * 
+ * @param file: Output file.
+ */
+void writeDispatch(FILE *file)
+{
+    fprintf(file,
+            "/**\n"
+            " * @brief Decodes the fields of a line and invokes the callback of its \n"
+            " * trigger.\n"
+            " * \n"
+            " * @param input: Line char array.\n"
+            " * @param fields: Fields of the line.\n"
+            " * @param numOfFields: Number of the fields.\n"
+            " * \n"
+            " * @retval TRUE or FALSE.\n"
+            " */\n"
+            "Bool_t decodeFields(const char *input, const Field_t *fields, uint8_t numOfFields)\n"
+            "{\n"
+            "    if (numOfFields == 0 || numOfFields == TOKENIZER_FIELD_COUNT_INVALID)\n"
+            "    {\n"
+            "        return FALSE;\n"
+            "    }\n"
+            "\n"
+            "    const char *name = &input[fields[0].start];\n"
+            "\n"
+            "    switch (fields[0].length)\n"
+            "    {\n");
+
+    // Triggers are sorted by the name length, then by the name.
+    for (uint16_t i = 0; i < NumOfSpecs;)
+    {
+        size_t length = strlen(Specs[i].name);
+
+        fprintf(file, "    case %u:\n        switch (name[0])\n        {\n", (unsigned)length);
+        while (i < NumOfSpecs && strlen(Specs[i].name) == length)
+        {
+            char first = Specs[i].name[0];
+
+            fprintf(file, "        case ");
+            writeChar(file, first);
+            fprintf(file, ":\n");
+            while (i < NumOfSpecs && strlen(Specs[i].name) == length && Specs[i].name[0] == first)
+            {
+                if (length == 1)
+                {
+                    fprintf(file, "            return decodeTrigger%u(input, fields, "
+                                  "numOfFields);\n",
+                            i);
+                }
+                else
+                {
+                    fprintf(file, "            if (memcmp(&name[1], ");
+                    writeString(file, &Specs[i].name[1]);
+                    fprintf(file, ", %u) == 0)\n", (unsigned)length - 1);
+                    fprintf(file, "            {\n");
+                    fprintf(file, "                return decodeTrigger%u(input, fields, "
+                                  "numOfFields);\n",
+                            i);
+                    fprintf(file, "            }\n");
+                }
+                i++;
+            }
+
+            if (length > 1)
+            {
+                fprintf(file, "            break;\n");
+            }
+        }
+        fprintf(file, "        default:\n            break;\n        }\n        break;\n\n");
+    }
+
+    fprintf(file,
+            "    default:\n"
+            "        break;\n"
+            "    }\n"
+            "\n"
+            "    return FALSE;\n"
+            "}\n");
+}
+
+/**
+ * @brief Writes the decoder of a trigger. Each field is bound to its
+ * parameter with a switch on the letter and parsed with the function of its
+ * type. Like in the generic parser, fields of unknown and repeated
+ * parameters are ignored and a malformed value or a missing required
+ * parameter rejects the line.
+ * 
+ * @param file: Output file.
+ * @param index: Index of the trigger.
+ */
+void writeDecoder(FILE *file, uint16_t index)
+{
+    const Spec_t *spec = &Specs[index];
+    uint32_t required = 0;
+
+    fprintf(file, "\n/**\n * @brief Decodes the parameters of ");
+    writeString(file, spec->name);
+    fprintf(file, " and invokes %s.\n", spec->callback);
+    fprintf(file,
+            " * \n"
+            " * @param input: Line char array.\n"
+            " * @param fields: Fields of the line.\n"
+            " * @param numOfFields: Number of the fields.\n"
+            " * \n"
+            " * @retval TRUE or FALSE.\n"
+            " */\n"
+            "Bool_t decodeTrigger%u(const char *input, const Field_t *fields, "
+            "uint8_t numOfFields)\n"
+            "{\n"
+            "    Dictionary_t dictionary;\n",
+            index);
+
+    for (uint8_t j = 0; j < spec->numOfParams; j++)
+    {
+        fprintf(file, "    %s value%u;\n", ValueTypes[spec->params[j].type], j);
+        required |= spec->params[j].required ? (1UL << j) : 0;
+    }
+
+    if (spec->numOfParams > 0)
+    {
+        fprintf(file, "    uint32_t present = 0;\n");
+    }
+
+    fprintf(file, "\n    Dictionary_Clear(&dictionary);\n");
+    if (spec->numOfParams > 0)
+    {
+        fprintf(file,
+                "    for (uint8_t j = 1; j < numOfFields; j++)\n"
+                "    {\n"
+                "        const char *value = &input[fields[j].start + 1];\n"
+                "        uint8_t length = fields[j].length - 1;\n"
+                "\n"
+                "        switch (input[fields[j].start])\n"
+                "        {\n");
+
+        for (uint8_t j = 0; j < spec->numOfParams; j++)
+        {
+            const Cp_Param_t *param = &spec->params[j];
+
+            fprintf(file, "        case ");
+            writeChar(file, param->letter);
+            fprintf(file, ":\n            if (present & 0x%XU)\n            {\n", 1U << j);
+            fprintf(file, "                break;\n            }\n");
+
+            if (param->type == CP_PARAM_TYPE_LETTER)
+            {
+                fprintf(file, "            if (length != 1)\n");
+            }
+            else
+            {
+                fprintf(file, "            if (!%s(value, length, &value%u))\n",
+                        ParseFunctions[param->type], j);
+            }
+            fprintf(file, "            {\n                return FALSE;\n            }\n");
+
+            if (param->type == CP_PARAM_TYPE_LETTER)
+            {
+                fprintf(file, "            value%u = value[0];\n", j);
+            }
+            fprintf(file, "            present |= 0x%XU;\n", 1U << j);
+            fprintf(file, "            Dictionary_Add(&dictionary, ");
+            writeChar(file, param->letter);
+            fprintf(file, ", %s, &value%u);\n            break;\n\n", TypeConstants[param->type],
+                    j);
+        }
+
+        fprintf(file, "        default:\n            break;\n        }\n    }\n");
+    }
+    else
+    {
+        fprintf(file, "    (void)input;\n    (void)fields;\n    (void)numOfFields;\n");
+    }
+
+    if (required)
+    {
+        fprintf(file, "\n    if ((present & 0x%XU) != 0x%XU)\n", (unsigned)required,
+                (unsigned)required);
+        fprintf(file, "    {\n        return FALSE;\n    }\n");
+    }
+
+    fprintf(file, "\n    %s(&dictionary);\n    return TRUE;\n}\n", spec->callback);
+}
+
+/**
+ * @brief Writes a section banner.
+ * 
+ * @param file: Output file.
+ * @param indent: Indentation of the banner.
+ * @param title: Title of the section.
+ */
+void writeBanner(FILE *file, const char *indent, const char *title)
+{
+    fprintf(file, "%s/* %s ", indent, title);
+    for (size_t i = strlen(title); i < 72; i++)
+    {
+        fputc('-', file);
+    }
+    fprintf(file, "*/\n");
+}
+
+/**
+ * @brief Writes a character literal.
+ * 
+ * @param file: Output file.
+ * @param c: Character.
+ */
+void writeChar(FILE *file, char c)
+{
+    if (c == '\'' || c == '\\')
+    {
+        fprintf(file, "'\\%c'", c);
+    }
+    else if (isprint((unsigned char)c))
+    {
+        fprintf(file, "'%c'", c);
+    }
+    else
+    {
+        fprintf(file, "'\\%03o'", (unsigned char)c);
+    }
+}
+
+/**
+ * @brief Writes a string literal.
+ * 
+ * @param file: Output file.
+ * @param value: Null terminated string.
+ */
+void writeString(FILE *file, const char *value)
+{
+    fputc('"', file);
+    for (const char *c = value; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            fprintf(file, "\\%c", *c);
+        }
+        else if (isprint((unsigned char)*c))
+        {
+            fputc(*c, file);
+        }
+        else
+        {
+            fprintf(file, "\\%03o", (unsigned char)*c);
+        }
+    }
+    fputc('"', file);
+}
+
+/**
+ * @brief Orders the triggers by the name length, then by the name.
+ * 
+ * @param a: Pointer to the first trigger.
+ * @param b: Pointer to the second trigger.
+ * 
+ * @retval Negative, zero or positive like strcmp.
+ */
+int compareSpecs(const void *a, const void *b)
+{
+    const Spec_t *first = a;
+    const Spec_t *second = b;
+    size_t first_length = strlen(first->name);
+    size_t second_length = strlen(second->name);
+
+    if (first_length != second_length)
+    {
+        return (first_length < second_length) ? -1 : 1;
+    }
+
+    return strcmp(first->name, second->name);
+}
@@ -0,0 +1,461 @@
+/**
+ * @file cparser_replay.c
+ * 
+ * Replays a command file through the parser and reports the throughput and
+ * the per-trigger line counts. File is memory mapped and lines are decoded
+ * in place, so the measurement doesn't include any copying.
+ * 
+ * Usage: cparser_replay [-t spec]... [-f specfile] [-r repeat] [-j] commandfile
+ * 
+ * Each trigger spec is a trigger name followed by its parameters, e.g.
+ * "move D:real S:real". Parameter types are letter, integer, real or fixed;
+ * a type followed by '!' makes the parameter required("D:real!"). Callback
+ * symbol which cparser_gen takes after "->" is ignored, so the same spec 
+ * file can be used with both tools.
+ * A spec file has one trigger spec per line; empty lines and lines starting
+ * with '#' are ignored. With -j the report is written as a JSON document.
+ */
+#include "../cparser/inc/cparser.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Private constants -------------------------------------------------------*/
+#define MAX_SPEC_LINE_LENGTH 256
+
+/* Private typedefs --------------------------------------------------------*/
+/* Line counts of a replay. */
+typedef struct
+{
+    size_t hits[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS];
+    size_t accepted;
+    size_t rejected;
+    size_t empty;
+} Counts_t;
+
+/* Private function prototypes ---------------------------------------------*/
+static Bool_t addSpec(const char *spec);
+static Bool_t addSpecFile(const char *path);
+static Bool_t parseType(const char *name, Cp_ParamType_t *type);
+static void replay(const char *buffer, size_t length, Counts_t *counts);
+static void touchCallback(Dictionary_t *params);
+static double getSeconds(void);
+static void printText(const char *path, size_t bytes, const Counts_t *counts, double seconds);
+static void printJson(const char *path, size_t bytes, const Counts_t *counts, double seconds);
+static void printJsonString(const char *value);
+
+/* Private variables -------------------------------------------------------*/
+static Cp_Trigger_t Triggers[CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS];
+static uint16_t NumOfTriggers = 0;
+static Cp_Parser_t Parser;
+static volatile uint32_t Sink;
+
+/* Exported functions ------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    unsigned long repeat = 1;
+    Bool_t json = FALSE;
+    Counts_t counts;
+    struct stat info;
+    const char *buffer;
+    double seconds;
+    int fd;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            if (!addSpec(argv[++i]))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+        {
+            if (!addSpecFile(argv[++i]))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+        {
+            repeat = strtoul(argv[++i], NULL, 10);
+            repeat = repeat ? repeat : 1;
+        }
+        else if (strcmp(argv[i], "-j") == 0)
+        {
+            json = TRUE;
+        }
+        else if (argv[i][0] != '-' && !path)
+        {
+            path = argv[i];
+        }
+        else
+        {
+            path = NULL;
+            break;
+        }
+    }
+
+    if (!path || NumOfTriggers == 0)
+    {
+        fprintf(stderr, "usage: %s [-t spec]... [-f specfile] [-r repeat] [-j] commandfile\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Spec triggers are counted by addSpec, so only the ones which repeat a
+    //letter can be ignored.
+    if (Cp_RegisterEx(&Parser, Triggers, NumOfTriggers) != NumOfTriggers)
+    {
+        fprintf(stderr, "triggers with repeated parameter letters can't be registered\n");
+        return EXIT_FAILURE;
+    }
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &info) != 0)
+    {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    // Empty files can't be mapped.
+    buffer = "";
+    if (info.st_size > 0)
+    {
+        buffer = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (buffer == MAP_FAILED)
+        {
+            perror(path);
+            close(fd);
+            return EXIT_FAILURE;
+        }
+
+        madvise((void *)buffer, (size_t)info.st_size, MADV_SEQUENTIAL);
+    }
+
+    // Counts of the last repeat are reported, time is the mean of all.
+    seconds = getSeconds();
+    for (unsigned long r = 0; r < repeat; r++)
+    {
+        replay(buffer, (size_t)info.st_size, &counts);
+    }
+    seconds = (getSeconds() - seconds) / (double)repeat;
+
+    if (json)
+    {
+        printJson(path, (size_t)info.st_size, &counts, seconds);
+    }
+    else
+    {
+        printText(path, (size_t)info.st_size, &counts, seconds);
+    }
+
+    if (info.st_size > 0)
+    {
+        munmap((void *)buffer, (size_t)info.st_size);
+    }
+    close(fd);
+    return EXIT_SUCCESS;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Adds a trigger from its spec.
+ * 
+ * @param spec: Trigger spec, e.g. "move D:real S:real".
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t addSpec(const char *spec)
+{
+    char copy[MAX_SPEC_LINE_LENGTH];
+    Cp_Trigger_t *trigger;
+    char *token;
+    uint8_t num_of_params = 0;
+
+    if (NumOfTriggers == CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS)
+    {
+        fprintf(stderr, "too many triggers, at most %d can be registered\n",
+                CPARSER_CONFIG_MAX_NUM_OF_TRIGGERS);
+        return FALSE;
+    }
+
+    if (strlen(spec) >= sizeof(copy))
+    {
+        fprintf(stderr, "spec is too long: %s\n", spec);
+        return FALSE;
+    }
+
+    strcpy(copy, spec);
+    token = strtok(copy, " \t\r\n");
+    if (!token || strlen(token) > CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH)
+    {
+        fprintf(stderr, "invalid trigger name in spec: %s\n", spec);
+        return FALSE;
+    }
+
+    // Members of the trigger are constant for the applications; the table is
+    //filled once, before the registration.
+    trigger = &Triggers[NumOfTriggers];
+    memset(trigger, 0, sizeof(Cp_Trigger_t));
+    strcpy((char *)trigger->name, token);
+    *(Cp_ParsedCallback_t *)&trigger->callback = touchCallback;
+
+    // Callback symbol after "->" is only used by cparser_gen.
+    while ((token = strtok(NULL, " \t\r\n")) != NULL && strcmp(token, "->") != 0)
+    {
+        Cp_Param_t *param;
+        Cp_ParamType_t type;
+        Bool_t required = FALSE;
+        size_t length = strlen(token);
+
+        // A type followed by '!' makes the parameter required.
+        if (length > 2 && token[length - 1] == '!')
+        {
+            token[length - 1] = '\0';
+            required = TRUE;
+        }
+
+        if (num_of_params == CPARSER_CONFIG_MAX_NUM_OF_PARAMS || token[0] == '\0' ||
+            token[1] != ':' || !parseType(&token[2], &type))
+        {
+            fprintf(stderr, "invalid parameter '%s' in spec: %s\n", token, spec);
+            return FALSE;
+        }
+
+        param = (Cp_Param_t *)&trigger->params[num_of_params];
+        param->letter = token[0];
+        param->type = type;
+        param->required = required;
+        num_of_params++;
+    }
+
+    *(uint8_t *)&trigger->numOfParams = num_of_params;
+    NumOfTriggers++;
+    return TRUE;
+}
+
+/**
+ * @brief Adds the triggers of a spec file.
+ * 
+ * @param path: Path of the spec file.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t addSpecFile(const char *path)
+{
+    char line[MAX_SPEC_LINE_LENGTH];
+    FILE *file = fopen(path, "r");
+    Bool_t retval = TRUE;
+
+    if (!file)
+    {
+        perror(path);
+        return FALSE;
+    }
+
+    while (retval && fgets(line, sizeof(line), file))
+    {
+        size_t skip = strspn(line, " \t\r\n");
+
+        if (line[skip] != '\0' && line[skip] != '#')
+        {
+            retval = addSpec(line);
+        }
+    }
+
+    fclose(file);
+    return retval;
+}
+
+/**
+ * @brief Parses a parameter type name.
+ * 
+ * @param name: Type name; letter, integer, real or fixed.
+ * @param type: Pointer to return the type.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t parseType(const char *name, Cp_ParamType_t *type)
+{
+    if (strcmp(name, "letter") == 0)
+    {
+        *type = CP_PARAM_TYPE_LETTER;
+    }
+    else if (strcmp(name, "integer") == 0)
+    {
+        *type = CP_PARAM_TYPE_INTEGER;
+    }
+    else if (strcmp(name, "real") == 0)
+    {
+        *type = CP_PARAM_TYPE_REAL;
+    }
+    else if (strcmp(name, "fixed") == 0)
+    {
+        *type = CP_PARAM_TYPE_FIXED;
+    }
+    else
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Runs the buffer through the parser. Lines are decoded in place and
+ * dispatched like Cp_FeedBufferEx does; decoded command tells which trigger
+ * has been hit.
+ * 
+ * @param buffer: Pointer to the buffer.
+ * @param length: Length of the buffer.
+ * @param counts: Pointer to return the line counts.
+ */
+void replay(const char *buffer, size_t length, Counts_t *counts)
+{
+    Cp_Command_t command;
+    Cp_LineStatus_t status;
+    size_t offset = 0;
+
+    memset(counts, 0, sizeof(Counts_t));
+
+    while (offset < length)
+    {
+        offset += Cp_DecodeNextLineEx(&Parser, &buffer[offset], length - offset, &command,
+                                      &status);
+
+        if (status == CP_LINE_STATUS_ACCEPTED)
+        {
+            Cp_DispatchCommandEx(&Parser, &command);
+            counts->hits[command.trigger - Triggers]++;
+            counts->accepted++;
+        }
+        else if (status == CP_LINE_STATUS_REJECTED)
+        {
+            counts->rejected++;
+        }
+        else
+        {
+            counts->empty++;
+        }
+    }
+}
+
+/**
+ * @brief Callback of all the triggers. Reads every parameter like a real
+ * callback would.
+ * 
+ * @param params: Pointer to the dictionary of parameters.
+ */
+void touchCallback(Dictionary_t *params)
+{
+    uint32_t sum = 0;
+
+    for (uint8_t i = 0; i < params->numberOfElements; i++)
+    {
+        sum += *(uint8_t *)params->values[i];
+    }
+
+    Sink = Sink + sum;
+}
+
+/**
+ * @brief Gets the monotonic time.
+ * 
+ * @retval Time in seconds.
+ */
+double getSeconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Prints the report as text.
+ * 
+ * @param path: Path of the command file.
+ * @param bytes: Size of the command file.
+ * @param counts: Pointer to the line counts.
+ * @param seconds: Time of a replay.
+ */
+void printText(const char *path, size_t bytes, const Counts_t *counts, double seconds)
+{
+    size_t lines = counts->accepted + counts->rejected + counts->empty;
+
+    printf("file      %s\n", path);
+    printf("bytes     %zu\n", bytes);
+    printf("lines     %zu\n", lines);
+    printf("accepted  %zu\n", counts->accepted);
+    printf("rejected  %zu\n", counts->rejected);
+    printf("empty     %zu\n", counts->empty);
+    printf("seconds   %.6f\n", seconds);
+    printf("lines/s   %.0f\n", (seconds > 0.0) ? (double)lines / seconds : 0.0);
+    printf("MB/s      %.1f\n", (seconds > 0.0) ? (double)bytes / (seconds * 1e6) : 0.0);
+    printf("\n%-*s %12s\n", CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH, "trigger", "lines");
+    for (uint16_t i = 0; i < NumOfTriggers; i++)
+    {
+        printf("%-*s %12zu\n", CPARSER_CONFIG_MAX_TRIGGER_NAME_LENGTH, Triggers[i].name,
+               counts->hits[i]);
+    }
+}
+
+/**
+ * @brief Prints the report as a JSON document.
+ * 
+ * @param path: Path of the command file.
+ * @param bytes: Size of the command file.
+ * @param counts: Pointer to the line counts.
+ * @param seconds: Time of a replay.
+ */
+void printJson(const char *path, size_t bytes, const Counts_t *counts, double seconds)
+{
+    size_t lines = counts->accepted + counts->rejected + counts->empty;
+
+    printf("{\n  \"file\": ");
+    printJsonString(path);
+    printf(",\n");
+    printf("  \"bytes\": %zu,\n", bytes);
+    printf("  \"lines\": %zu,\n", lines);
+    printf("  \"accepted\": %zu,\n", counts->accepted);
+    printf("  \"rejected\": %zu,\n", counts->rejected);
+    printf("  \"empty\": %zu,\n", counts->empty);
+    printf("  \"seconds\": %.9f,\n", seconds);
+    printf("  \"lines_per_s\": %.1f,\n", (seconds > 0.0) ? (double)lines / seconds : 0.0);
+    printf("  \"mb_per_s\": %.3f,\n", (seconds > 0.0) ? (double)bytes / (seconds * 1e6) : 0.0);
+    printf("  \"triggers\": {");
+    for (uint16_t i = 0; i < NumOfTriggers; i++)
+    {
+        printf("%s\n    ", i ? "," : "");
+        printJsonString(Triggers[i].name);
+        printf(": %zu", counts->hits[i]);
+    }
+    printf("\n  }\n}\n");
+}
+
+/**
+ * @brief Prints a string as a JSON string literal.
+ * 
+ * @param value: Null terminated string.
+ */
+void printJsonString(const char *value)
+{
+    putchar('"');
+    for (const char *c = value; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            putchar('\\');
+        }
+        putchar(*c);
+    }
+    putchar('"');
+}
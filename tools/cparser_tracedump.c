@@ -0,0 +1,118 @@
+/**
+ * @file cparser_tracedump.c
+ * 
+ * Converts trace buffers to a Chrome trace. Each input file is a raw image 
+ * of a Cp_TraceBuffer_t, e.g. dumped from the target by the debugger with
+ * "dump binary value buffer.bin Buffer" or written by the application with
+ * fwrite; the tool should be built with the CPARSER_CONFIG_TRACE_BUFFER_SIZE
+ * of the target. Trace is written to the standard output.
+ * 
+ * Usage: cparser_tracedump -t ticksPerMicrosecond bufferfile...
+ * 
+ * Clock of the timestamps is only known by the target, so -t is required; 
+ * e.g. 168 for the cycle counter of a 168MHz core, 1000 for nanoseconds.
+ */
+#include "../cparser/inc/cparser_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private constants -------------------------------------------------------*/
+#define MAX_NUM_OF_BUFFERS 64
+
+/* Private function prototypes ---------------------------------------------*/
+static Bool_t readBuffer(const char *path, Cp_TraceBuffer_t *buffer);
+static void writeText(const char *text, size_t length, void *context);
+
+/* Private variables -------------------------------------------------------*/
+static Cp_TraceBuffer_t Buffers[MAX_NUM_OF_BUFFERS];
+
+/* Exported functions ------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+    const Cp_TraceBuffer_t *buffers[MAX_NUM_OF_BUFFERS];
+    unsigned long ticks_per_microsecond = 0;
+    uint8_t num_of_buffers = 0;
+    size_t events;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            ticks_per_microsecond = strtoul(argv[++i], NULL, 10);
+        }
+        else if (argv[i][0] != '-' && num_of_buffers < MAX_NUM_OF_BUFFERS)
+        {
+            if (!readBuffer(argv[i], &Buffers[num_of_buffers]))
+            {
+                return EXIT_FAILURE;
+            }
+
+            buffers[num_of_buffers] = &Buffers[num_of_buffers];
+            num_of_buffers++;
+        }
+        else
+        {
+            num_of_buffers = 0;
+            break;
+        }
+    }
+
+    if (num_of_buffers == 0 || ticks_per_microsecond == 0 || ticks_per_microsecond > UINT32_MAX)
+    {
+        fprintf(stderr, "usage: %s -t ticksPerMicrosecond bufferfile...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    events = Cp_TraceExport(buffers, num_of_buffers, (uint32_t)ticks_per_microsecond, writeText,
+                            stdout);
+    fprintf(stderr, "%zu events from %u buffers\n", events, (unsigned)num_of_buffers);
+
+    return ferror(stdout) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* Private functions -------------------------------------------------------*/
+/**
+ * @brief Reads the image of a buffer.
+ * 
+ * @param path: Path of the file.
+ * @param buffer: Pointer to the buffer.
+ * 
+ * @retval TRUE or FALSE.
+ */
+Bool_t readBuffer(const char *path, Cp_TraceBuffer_t *buffer)
+{
+    FILE *file = fopen(path, "rb");
+    size_t length;
+
+    if (!file)
+    {
+        perror(path);
+        return FALSE;
+    }
+
+    // Image of another buffer size would be read as garbage; reject it.
+    length = fread(buffer, 1, sizeof(Cp_TraceBuffer_t), file);
+    if (length != sizeof(Cp_TraceBuffer_t) || fgetc(file) != EOF)
+    {
+        fprintf(stderr, "%s: not a trace buffer of %u records\n", path,
+                (unsigned)CPARSER_CONFIG_TRACE_BUFFER_SIZE);
+        fclose(file);
+        return FALSE;
+    }
+
+    fclose(file);
+    return TRUE;
+}
+
+/**
+ * @brief Writes a piece of the trace.
+ * 
+ * @param text: Text.
+ * @param length: Length of the text.
+ * @param context: Output file.
+ */
+void writeText(const char *text, size_t length, void *context)
+{
+    fwrite(text, 1, length, (FILE *)context);
+}
@@ -0,0 +1,7 @@
+move D12.5 S300.0
+versi V42
+pump MD V1.25
+
+move DX S1
+unknown X1
+move D-0.125 S1.5E2